@@ -135,6 +135,7 @@ void CameraPlaneNodeManipulator::translateSelectedNodes( const Vector& valChange
       }
 
       m_selectedNodes[i]->accessLocalMtx().mul( transformMtx );
+      m_selectedNodes[i]->notifyPropertyChange( "m_localMtx" );
    }
 }
 
@@ -199,6 +200,7 @@ void CameraPlaneNodeManipulator::rotateSelectedNodes( const Vector& valChange )
 
       currentTransform.toMatrix( transformMtx );
       entity->setLocalMtx( transformMtx );
+      entity->notifyPropertyChange( "m_localMtx" );
    }
 }
 
@@ -31,6 +31,7 @@ struct GameDeploymentInfo
    FilePath                      m_renderingPipelinePath;
    FilePath                      m_worldModelPath;
 
+   bool                          m_packResources;        // should the resources be packed into a single archive
    bool                          m_runAfterDeployment;
 
    /**
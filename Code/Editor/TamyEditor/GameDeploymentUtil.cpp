@@ -69,16 +69,30 @@ GameRunner* GameDeploymentUtil::deployGame( const GameDeploymentInfo& info, Prog
 {
    std::string DEPLOYMENT_RESOURCES_ROOT = info.m_targetDir + "/Data/";
 
-   bool directoryStructureCreated = recreateDirectoriesStructures( DEPLOYMENT_RESOURCES_ROOT, info.m_projectDirectories );
-   if ( !directoryStructureCreated )
+   if ( info.m_packResources )
    {
-      return NULL;
+      bool filesPacked = packProjectFiles( DEPLOYMENT_RESOURCES_ROOT, info.m_projectDirectories );
+      if ( !filesPacked )
+      {
+         return NULL;
+      }
    }
-
-   bool filesDeployed = copyProjectFiles( DEPLOYMENT_RESOURCES_ROOT, info.m_projectDirectories );
-   if ( !filesDeployed )
+   else
    {
-      return NULL;
+      bool directoryStructureCreated = recreateDirectoriesStructures( DEPLOYMENT_RESOURCES_ROOT, info.m_projectDirectories );
+      if ( !directoryStructureCreated )
+      {
+         return NULL;
+      }
+
+      std::vector< FilePath > files;
+      collectProjectFiles( info.m_projectDirectories, files );
+
+      bool filesDeployed = copyProjectFiles( DEPLOYMENT_RESOURCES_ROOT, files );
+      if ( !filesDeployed )
+      {
+         return NULL;
+      }
    }
 
    bool configFileCreated = createGameConfig( DEPLOYMENT_RESOURCES_ROOT, info );
@@ -129,14 +143,11 @@ bool GameDeploymentUtil::recreateDirectoriesStructures( const std::string& targe
 
 ///////////////////////////////////////////////////////////////////////////////
 
-bool GameDeploymentUtil::copyProjectFiles( const std::string& targetDir, const std::vector< FilePath >& projectDirectories )
+void GameDeploymentUtil::collectProjectFiles( const std::vector< FilePath >& projectDirectories, std::vector< FilePath >& outFiles )
 {
    ResourcesManager& resMgr = ResourcesManager::getInstance();
-   Filesystem& fs = resMgr.getFilesystem();
 
-   // analyze the directory structure
-   std::vector< FilePath > files;
-   FSScanner fileNamesScanner( files, COLLECT_FILES );
+   FSScanner fileNamesScanner( outFiles, COLLECT_FILES );
 
    uint directoriesCount = projectDirectories.size();
    for ( uint i = 0; i < directoriesCount; ++i )
@@ -144,6 +155,15 @@ bool GameDeploymentUtil::copyProjectFiles( const std::string& targetDir, const s
       // scan both the filesystem and the resources manager
       resMgr.scan( projectDirectories[i], fileNamesScanner, true );
    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool GameDeploymentUtil::copyProjectFiles( const std::string& targetDir, const std::vector< FilePath >& files )
+{
+   ResourcesManager& resMgr = ResourcesManager::getInstance();
+   Filesystem& fs = resMgr.getFilesystem();
+   Filesystem targetFs( targetDir );
 
    // copy all files
    uint filesCount = files.size();
@@ -152,14 +172,19 @@ bool GameDeploymentUtil::copyProjectFiles( const std::string& targetDir, const s
       std::string sourcePath = files[i].toAbsolutePath( fs );
       std::string targetPath = targetDir + files[i].c_str();
 
-      // save the resource
+      // save the resource and deploy it in the cooked format
       Resource* res = resMgr.findResource( files[i] );
       if ( res )
       {
          res->saveResource();
       }
 
-      // copy it to the final folder
+      if ( cookResource( fs, files[i], targetFs ) )
+      {
+         continue;
+      }
+
+      // the file doesn't contain an archive that could be cooked - copy it to the final folder as it is
       bool result = CopyFileA( sourcePath.c_str(), targetPath.c_str(), false );
 
       if ( !result )
@@ -173,6 +198,75 @@ bool GameDeploymentUtil::copyProjectFiles( const std::string& targetDir, const s
 
 ///////////////////////////////////////////////////////////////////////////////
 
+bool GameDeploymentUtil::packProjectFiles( const std::string& targetDir, const std::vector< FilePath >& projectDirectories )
+{
+   std::vector< FilePath > files;
+   collectProjectFiles( projectDirectories, files );
+
+   // deploy the most up to date, cooked versions of the files to a staging directory first,
+   // so that it's them that get packed
+   const FilePath stagingDirPath( "Staging" );
+   std::string stagingDir = targetDir + stagingDirPath.c_str() + "/";
+
+   bool result = recreateDirectoriesStructures( stagingDir, projectDirectories );
+   if ( result )
+   {
+      result = copyProjectFiles( stagingDir, files );
+   }
+
+   // pack the files into a single archive
+   Filesystem targetFs( targetDir );
+   if ( result )
+   {
+      Filesystem stagingFs( stagingDir );
+      result = FilesystemArchive::build( stagingFs, files, targetFs, FilePath( GAME_RESOURCES_ARCHIVE ) );
+   }
+
+   // the staging directory is no longer needed
+   targetFs.remove( stagingDirPath );
+
+   return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool GameDeploymentUtil::cookResource( const Filesystem& sourceFs, const FilePath& path, const Filesystem& targetFs )
+{
+   File* sourceFile = sourceFs.open( path, std::ios_base::in | std::ios_base::binary );
+   if ( !sourceFile )
+   {
+      return false;
+   }
+
+   // cook the file in memory first - only the uncompressed archives written by ReflectionSaver can be cooked,
+   // and the rest of the files shouldn't leave anything behind in the target filesystem
+   Array< byte > cookedArchive;
+   bool wasCooked = false;
+   {
+      InFileStream inStream( sourceFile );
+      OutArrayStream outStream( cookedArchive );
+      wasCooked = ReflectionArchiveCooker::cook( inStream, outStream );
+   }
+
+   if ( !wasCooked )
+   {
+      return false;
+   }
+
+   File* targetFile = targetFs.open( path, std::ios_base::out | std::ios_base::binary );
+   if ( !targetFile )
+   {
+      return false;
+   }
+
+   bool result = targetFile->write( (byte*)cookedArchive, cookedArchive.size() ) == cookedArchive.size();
+   delete targetFile;
+
+   return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 bool GameDeploymentUtil::createDirectory( const std::string& dir )
 {
    std::vector< std::string > pathElements;
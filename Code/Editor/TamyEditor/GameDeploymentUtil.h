@@ -12,6 +12,7 @@
 struct GameDeploymentInfo;
 class ProgressDialog;
 class GameRunner;
+class Filesystem;
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -25,7 +26,10 @@ public:
 
 private:
    static bool recreateDirectoriesStructures( const std::string& targetDir, const std::vector< FilePath >& projectDirectories );
-   static bool copyProjectFiles( const std::string& targetDir, const std::vector< FilePath >& projectDirectories );
+   static void collectProjectFiles( const std::vector< FilePath >& projectDirectories, std::vector< FilePath >& outFiles );
+   static bool copyProjectFiles( const std::string& targetDir, const std::vector< FilePath >& files );
+   static bool packProjectFiles( const std::string& targetDir, const std::vector< FilePath >& projectDirectories );
+   static bool cookResource( const Filesystem& sourceFs, const FilePath& path, const Filesystem& targetFs );
    static bool createDirectory( const std::string& dir );
 
    static bool createGameConfig( const std::string& targetDir, const GameDeploymentInfo& info );
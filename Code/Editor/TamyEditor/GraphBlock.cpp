@@ -139,7 +139,11 @@ void GraphBlock::onObjectPreSave()
 {
    __super::onObjectPreSave();
 
-   m_position = pos();
+   if ( m_position != pos() )
+   {
+      m_position = pos();
+      markDirty();
+   }
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -182,6 +186,7 @@ void GraphBlock::addSocket( GraphBlockSocket* socket )
    }
 
    m_sockets.push_back( socket );
+   markDirty();
    calculateBounds();
 }
 
@@ -217,6 +222,7 @@ void GraphBlock::removeSingleSocket( GraphBlockSocketPosition position, const st
          // delete the socket
          delete socket;
          m_sockets.erase( m_sockets.begin() + socketIdx );
+         markDirty();
          break;
       }
    }
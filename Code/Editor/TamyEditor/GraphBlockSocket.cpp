@@ -41,7 +41,11 @@ void GraphBlockSocket::onObjectPreSave()
 {
    __super::onObjectPreSave();
 
-   m_position = pos();
+   if ( m_position != pos() )
+   {
+      m_position = pos();
+      markDirty();
+   }
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -52,6 +52,7 @@ GraphBlock& GraphLayout::add( const SerializableReflectionType& type, const QPoi
    // add the block to the scene
    addItem( block );
    block->setPos( pos );
+   onLayoutChanged();
 
    emit onBlockAdded();
 
@@ -100,6 +101,7 @@ void GraphLayout::remove( GraphBlock* block )
          ASSERT_MSG( false, "The specified block doesn't belong to this layout" );
       }
    }
+   onLayoutChanged();
 
    emit onBlockRemoved();
 }
@@ -157,6 +159,7 @@ void GraphLayout::finishNegotiatingConnection( GraphBlockSocket* destinationSock
          GraphBlockConnection* connection = new GraphBlockConnection( m_sourceSocket, destinationSocket );
          m_connections.push_back( connection );
          addItem( connection );
+         onLayoutChanged();
       }
    }
 
@@ -220,6 +223,11 @@ void GraphLayout::disconnectSocket( GraphBlockSocket& socket )
       delete connection;
    }
 
+   if ( count > 0 )
+   {
+      onLayoutChanged();
+   }
+
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -281,6 +289,7 @@ void GraphLayout::restoreState()
          removeItem( connection );
          delete connection;
          m_connections.erase( m_connections.begin() + i );
+         onLayoutChanged();
       }
    }
 
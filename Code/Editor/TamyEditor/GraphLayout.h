@@ -164,6 +164,11 @@ protected:
     */
    virtual void breakPipelineConnections( const std::vector< GraphBlockConnection* >& connections ) const = 0;
 
+   /**
+    * Called when the blocks or the connections the layout consists of change.
+    */
+   virtual void onLayoutChanged() = 0;
+
 private:
    /**
     * Checks if the two sockets are connected.
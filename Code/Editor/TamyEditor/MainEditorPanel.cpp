@@ -319,6 +319,7 @@ void MainEditorPanel::loadLayout( QSettings& outSettings )
             if ( !editor )
             {
                // for some reason we couldn't create an editor for this resource - so skip it
+               resMgr.release( resource );
                outSettings.endGroup();
                continue;
             }
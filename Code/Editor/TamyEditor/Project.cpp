@@ -59,6 +59,7 @@ void Project::onResourceLoaded( ResourcesManager& mgr )
 
 void Project::set( const FilesystemSection& section )
 {
+   std::string prevProjectPaths = m_projectPaths;
    m_projectPaths = "";
 
    bool engineDirStored = false;
@@ -87,6 +88,11 @@ void Project::set( const FilesystemSection& section )
       m_projectPaths += projectDir;
       m_projectPaths += ";";
    }
+
+   if ( prevProjectPaths != m_projectPaths )
+   {
+      markDirty();
+   }
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -90,6 +90,9 @@ void ProjectEditor::onDeploy()
       // collect directories to deploy
       m_project.collectDirectories( deploymentInfo.m_projectDirectories );
 
+      // do we want the resources packed into an archive?
+      deploymentInfo.m_packResources = m_ui.packResourcesCheckBox->isChecked();
+
       // do we want to run the game after it's been successfully deployed?
       deploymentInfo.m_runAfterDeployment = m_ui.runAfterDeploymentCheckBox->isChecked();
    }
@@ -48,12 +48,19 @@ void ResourceManagementUtil::editResource( const std::string& path, const QIcon&
 
    if ( resource )
    {
+      // the editor keeps using the resource until its tab is closed
       TamyEditor& tamyEd = TamyEditor::getInstance();
+      ResourceEditor* resourceEd = NULL;
       if ( tamyEd.activateResourceEditor( resource ) == false )
       {
-         ResourceEditor* resourceEd = tamyEd.createResourceEditor( resource, resourceIcon );
+         resourceEd = tamyEd.createResourceEditor( resource, resourceIcon );
          tamyEd.addResourceEditor( resourceEd );
       }
+
+      if ( !resourceEd )
+      {
+         resMgr.release( resource );
+      }
    }
 }
 
@@ -303,6 +303,7 @@ void SceneEditor::pathsDropped()
 {
    ResourcesManager& rm = ResourcesManager::getInstance();
 
+   std::vector< FilePath > importedPaths;
    unsigned int count = m_droppedPaths.size();
    for ( unsigned int i = 0; i < count; ++i )
    {
@@ -315,15 +316,13 @@ void SceneEditor::pathsDropped()
       }
       else
       {
-         TResourceImporter< Model >* importer = rm.createImporter< Model >( path );
-         if ( importer )
-         {
-            importer->import( m_scene );
-            delete importer;
-         }
+         importedPaths.push_back( path );
       }
    }
 
+   // import all dropped files in one batch
+   rm.importBatch< Model >( importedPaths, m_scene );
+
    m_droppedPaths.clear();
 }
 
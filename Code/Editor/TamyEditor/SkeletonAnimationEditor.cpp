@@ -470,12 +470,8 @@ void SkeletonAnimationEditor::animationImported()
    {
       FilePath path = m_animationsPaths[i];
 
-      TResourceImporter< SkeletonAnimation >* importer = rm.createImporter< SkeletonAnimation >( path );
-      if ( importer )
+      if ( rm.import< SkeletonAnimation >( path, m_animation ) )
       {
-         importer->import( m_animation );
-         delete importer;
-
          // ok - animation imported, no need to go through the remaining paths
          break;
       }
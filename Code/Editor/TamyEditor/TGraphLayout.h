@@ -47,6 +47,7 @@ public:
    bool connectNodes( ReflectionObject* sourceNode, const std::string& outputName, ReflectionObject* destinationNode, const std::string& inputName );
    void disconnectNode( ReflectionObject* sourceNode, ReflectionObject* destinationNode, const std::string& inputName );
    void breakPipelineConnections( const std::vector< GraphBlockConnection* >& connectionsToDelete ) const;
+   void onLayoutChanged() { markDirty(); }
 
    // -------------------------------------------------------------------------
    // Observer implementation
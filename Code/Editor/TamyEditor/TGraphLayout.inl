@@ -346,6 +346,11 @@ void TGraphLayout< TPipeline, TNode >::removeBrokenConnections( const GraphBlock
       removeItem( *it );
       delete *it;
    }
+
+   if ( !brokenConnections.empty() )
+   {
+      markDirty();
+   }
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -196,6 +196,9 @@ void TamyEditor::setupResourcesManager( const char* fsRoot )
    resMgr.addImporter< IWFScene, Model >( "iwf" );
    resMgr.addImporter< ColladaScene, Model >( "dae" );
    resMgr.setProgressObserver< ProgressDialog >();
+
+   // every resource the editor saves is saved incrementally
+   resMgr.setIncrementalSaving( true );
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -236,6 +239,9 @@ void TamyEditor::updateMain()
    }
 
 
+   // reload the resources the files of which were edited
+   ResourcesManager::getInstance().processEditedFiles( timeElapsed );
+
    // update engine's main loop
    m_timeController->update( timeElapsed );
 }
@@ -308,8 +314,14 @@ void TamyEditor::onEditorTabClosed( QWidget* editorWidget )
    ResourceEditor* editor = dynamic_cast< ResourceEditor* >( editorWidget );
    if ( editor )
    {
+      // the editor is labeled with the path of the edited resource - it doesn't need the resource any more
+      FilePath editedResourcePath( editor->getLabel().toStdString() );
+
       editor->deinitialize( false );
       delete editor;
+
+      ResourcesManager& resMgr = ResourcesManager::getInstance();
+      resMgr.release( resMgr.findResource( editedResourcePath ) );
    }
 
    // this may have been the profiler
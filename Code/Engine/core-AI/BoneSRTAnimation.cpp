@@ -2,6 +2,9 @@
 #include "core/Assert.h"
 #include "core/Quaternion.h"
 #include "core/Vector.h"
+#include "core/Transform.h"
+#include "core/Algorithms.h"
+#include <math.h>
 
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -9,14 +12,44 @@
 BEGIN_OBJECT( BoneSRTAnimation );
    PARENT( ReflectionObject);
    PROPERTY( std::string, m_boneName );
-   PROPERTY( Array< float >, m_orientation.m_time );
-   PROPERTY( Array< Quaternion >, m_orientation.m_keys );
+   PROPERTY( Array< float >, m_rotation.m_time );
+   PROPERTY( Array< QuantizedQuaternion >, m_rotation.m_keys );
    PROPERTY( Array< float >, m_translation.m_time );
    PROPERTY( Array< Vector >, m_translation.m_keys );
+   PROPERTY( Array< Quaternion >, m_legacyOrientationKeys );
+   PATCH_MEMBER( m_orientation.m_time, m_rotation.m_time );
+   PATCH_MEMBER( m_orientation.m_keys, m_legacyOrientationKeys );
 END_OBJECT();
 
 ///////////////////////////////////////////////////////////////////////////////
 
+namespace // anonymous
+{
+   struct OrientationError
+   {
+      float operator()( const Quaternion& value, const Quaternion& referenceValue ) const
+      {
+         // the angle of the rotation that takes one orientation to the other
+         float dot = value[0] * referenceValue[0] + value[1] * referenceValue[1] + value[2] * referenceValue[2] + value[3] * referenceValue[3];
+         dot = min2( fabs( dot ), 1.0f );
+         return 2.0f * acos( dot );
+      }
+   };
+
+   struct TranslationError
+   {
+      float operator()( const Vector& value, const Vector& referenceValue ) const
+      {
+         Vector diff;
+         diff.setSub( value, referenceValue );
+         return diff.length().getFloat();
+      }
+   };
+
+} // anonymous
+
+///////////////////////////////////////////////////////////////////////////////
+
 BoneSRTAnimation::BoneSRTAnimation( const std::string& boneName )
    : m_boneName( boneName )
    , m_duration( 0.0f )
@@ -30,6 +63,18 @@ void BoneSRTAnimation::onObjectLoaded()
 {
    __super::onObjectLoaded();
 
+   // convert the orientation keys stored in the old format
+   unsigned int legacyKeysCount = m_legacyOrientationKeys.size();
+   if ( legacyKeysCount > 0 )
+   {
+      m_rotation.m_keys.clear();
+      for ( unsigned int i = 0; i < legacyKeysCount; ++i )
+      {
+         m_rotation.m_keys.push_back( m_legacyOrientationKeys[i] );
+      }
+      m_legacyOrientationKeys.clear();
+   }
+
    updateDuration();
 }
 
@@ -38,7 +83,7 @@ void BoneSRTAnimation::onObjectLoaded()
 
 void BoneSRTAnimation::addOrientationKey( float time, const Quaternion& orientation )
 {
-   m_orientation.addKey( time, orientation );
+   m_rotation.addKey( time, orientation );
 
    // update the animation duration
    updateDuration();
@@ -56,13 +101,42 @@ void BoneSRTAnimation::addTranslationKey( float time, const Vector& translation
 
 ///////////////////////////////////////////////////////////////////////////////
 
+void BoneSRTAnimation::compress( float orientationTolerance, float translationTolerance )
+{
+   m_rotation.removeRedundantKeys( orientationTolerance, OrientationError() );
+   m_translation.removeRedundantKeys( translationTolerance, TranslationError() );
+
+   // a track that collapsed to a single key no longer spans the whole animation, so the duration may shrink
+   // - the length of the entire animation is stored in SkeletonAnimation though
+   updateDuration();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void BoneSRTAnimation::copyKeys( const BoneSRTAnimation& rhs )
+{
+   m_rotation.m_time.clear();
+   m_rotation.m_time.copyFrom( rhs.m_rotation.m_time );
+   m_rotation.m_keys.clear();
+   m_rotation.m_keys.copyFrom( rhs.m_rotation.m_keys );
+
+   m_translation.m_time.clear();
+   m_translation.m_time.copyFrom( rhs.m_translation.m_time );
+   m_translation.m_keys.clear();
+   m_translation.m_keys.copyFrom( rhs.m_translation.m_keys );
+
+   m_duration = rhs.m_duration;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void BoneSRTAnimation::updateDuration()
 {
    m_duration = 0.0f;
 
-   if ( m_orientation.m_time.empty() == false && m_duration < m_orientation.m_time.back() )
+   if ( m_rotation.m_time.empty() == false && m_duration < m_rotation.m_time.back() )
    {
-      m_duration = m_orientation.m_time.back();
+      m_duration = m_rotation.m_time.back();
    }
 
    if ( m_translation.m_time.empty() == false && m_duration < m_translation.m_time.back() )
@@ -82,7 +156,21 @@ bool BoneSRTAnimation::getTranslation( unsigned int& lastCheckedKeyIdx, float ti
 
 bool BoneSRTAnimation::getOrientation( unsigned int& lastCheckedKeyIdx, float time, Quaternion& outOrientation ) const
 {
-   return m_orientation.getKey( lastCheckedKeyIdx, time, outOrientation );
+   return m_rotation.getKey( lastCheckedKeyIdx, time, outOrientation );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool BoneSRTAnimation::getTranslationKeys( unsigned int& lastCheckedKeyIdx, float time, Vector& outStartKey, Vector& outEndKey, FastFloat& outLerpFactor ) const
+{
+   return m_translation.getKeys( lastCheckedKeyIdx, time, outStartKey, outEndKey, outLerpFactor );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool BoneSRTAnimation::getOrientationKeys( unsigned int& lastCheckedKeyIdx, float time, Quaternion& outStartKey, Quaternion& outEndKey, FastFloat& outLerpFactor ) const
+{
+   return m_rotation.getKeys( lastCheckedKeyIdx, time, outStartKey, outEndKey, outLerpFactor );
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -104,15 +192,15 @@ void BoneSRTAnimation::setTranslationKey( unsigned int keyIdx, const Vector& val
 
 void BoneSRTAnimation::getOrientationKey( unsigned int keyIdx, Quaternion& outValue, float& outTime ) const
 {
-   outValue = m_orientation.m_keys[keyIdx]; 
-   outTime = m_orientation.m_time[keyIdx]; 
+   outValue = m_rotation.m_keys[keyIdx]; 
+   outTime = m_rotation.m_time[keyIdx]; 
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
 void BoneSRTAnimation::setOrientationKey( unsigned int keyIdx, const Quaternion& value )
 {
-   m_orientation.m_keys[keyIdx] = value;
+   m_rotation.m_keys[keyIdx] = value;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -142,3 +230,42 @@ bool BoneSRTAnimationPlayer::getOrientation( float time, Quaternion& outOrientat
 }
 
 ///////////////////////////////////////////////////////////////////////////////
+
+void BoneSRTAnimationPlayer::getTransform( float time, Transform& outTransform )
+{
+   if ( !m_animation.getOrientation( m_orientationKeyIdx, time, outTransform.m_rotation ) )
+   {
+      outTransform.m_rotation = Quaternion::getIdentity();
+   }
+
+   if ( !m_animation.getTranslation( m_translationKeyIdx, time, outTransform.m_translation ) )
+   {
+      outTransform.m_translation = Quad_0;
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void BoneSRTAnimationPlayer::getTranslationKeys( float time, Vector& outStartKey, Vector& outEndKey, FastFloat& outLerpFactor )
+{
+   if ( !m_animation.getTranslationKeys( m_translationKeyIdx, time, outStartKey, outEndKey, outLerpFactor ) )
+   {
+      outStartKey = Quad_0;
+      outEndKey = Quad_0;
+      outLerpFactor = Float_0;
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void BoneSRTAnimationPlayer::getOrientationKeys( float time, Quaternion& outStartKey, Quaternion& outEndKey, FastFloat& outLerpFactor )
+{
+   if ( !m_animation.getOrientationKeys( m_orientationKeyIdx, time, outStartKey, outEndKey, outLerpFactor ) )
+   {
+      outStartKey.setIdentity();
+      outEndKey.setIdentity();
+      outLerpFactor = Float_0;
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
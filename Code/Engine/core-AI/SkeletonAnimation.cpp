@@ -1,6 +1,7 @@
 #include "core-AI/SkeletonAnimation.h"
 #include "core-AI/BoneSRTAnimation.h"
 #include "core/Node.h"
+#include <algorithm>
 
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -117,6 +118,18 @@ BoneSRTAnimation* SkeletonAnimation::getBoneDef( const std::string& boneName ) c
 }
 
 
+///////////////////////////////////////////////////////////////////////////////
+
+void SkeletonAnimation::compress( float orientationTolerance, float translationTolerance )
+{
+   // the animation length stays intact, even if the tracks that end it get collapsed
+   unsigned int bonesCount = m_boneAnimations.size();
+   for ( unsigned int i = 0; i < bonesCount; ++i )
+   {
+      m_boneAnimations[i]->compress( orientationTolerance, translationTolerance );
+   }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 void SkeletonAnimation::clear()
@@ -129,6 +142,13 @@ void SkeletonAnimation::clear()
       delete m_boneAnimations[i];
    }
    m_boneAnimations.clear();
+
+   bonesCount = m_retiredBoneAnimations.size();
+   for ( unsigned int i = 0; i < bonesCount; ++i )
+   {
+      delete m_retiredBoneAnimations[i];
+   }
+   m_retiredBoneAnimations.clear();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -171,3 +191,85 @@ void SkeletonAnimation::collectBonesNames( std::vector< std::string>& outNames )
 }
 
 ///////////////////////////////////////////////////////////////////////////////
+
+void SkeletonAnimation::mergeContents( Resource& rhs )
+{
+   // the merged animation is about to be discarded, so take over its keys
+   SkeletonAnimation& mergedAnimation = static_cast< SkeletonAnimation& >( rhs );
+
+   // the durations of the bone tracks may be shorter than the animation, if they were compressed
+   if ( mergedAnimation.m_animationLength > m_animationLength )
+   {
+      m_animationLength = mergedAnimation.m_animationLength;
+   }
+
+   unsigned int count = mergedAnimation.m_boneAnimations.size();
+   for ( unsigned int i = 0; i < count; ++i )
+   {
+      addKeys( mergedAnimation.m_boneAnimations[i] );
+   }
+   mergedAnimation.m_boneAnimations.clear();
+   mergedAnimation.m_animationLength = 0.0f;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void SkeletonAnimation::replaceContents( Resource& rhs )
+{
+   // the players reference the bone tracks, so the tracks of the bones that remain animated
+   // are updated in place, and the remaining ones are kept until the animation gets cleared
+   SkeletonAnimation& newAnimation = static_cast< SkeletonAnimation& >( rhs );
+   m_animationLength = newAnimation.m_animationLength;
+
+   std::vector< BoneSRTAnimation* > boneAnimations;
+   unsigned int count = newAnimation.m_boneAnimations.size();
+   for ( unsigned int i = 0; i < count; ++i )
+   {
+      BoneSRTAnimation* newBoneAnimation = newAnimation.m_boneAnimations[i];
+      BoneSRTAnimation* boneAnimation = getBoneDef( newBoneAnimation->getBoneName() );
+      if ( boneAnimation )
+      {
+         boneAnimation->copyKeys( *newBoneAnimation );
+      }
+      else
+      {
+         // take the new track over from the discarded animation
+         boneAnimation = newBoneAnimation;
+         newAnimation.m_boneAnimations[i] = NULL;
+      }
+      boneAnimations.push_back( boneAnimation );
+   }
+
+   count = m_boneAnimations.size();
+   for ( unsigned int i = 0; i < count; ++i )
+   {
+      BoneSRTAnimation* boneAnimation = m_boneAnimations[i];
+      if ( std::find( boneAnimations.begin(), boneAnimations.end(), boneAnimation ) == boneAnimations.end() )
+      {
+         m_retiredBoneAnimations.push_back( boneAnimation );
+      }
+   }
+
+   m_boneAnimations.swap( boneAnimations );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+uint SkeletonAnimation::getMemoryUsage() const
+{
+   uint memoryUsage = sizeof( SkeletonAnimation );
+
+   // each key is stored along with its time
+   unsigned int count = m_boneAnimations.size();
+   for ( unsigned int i = 0; i < count; ++i )
+   {
+      const BoneSRTAnimation* boneAnimation = m_boneAnimations[i];
+      memoryUsage += sizeof( BoneSRTAnimation );
+      memoryUsage += boneAnimation->getOrientationKeysCount() * ( sizeof( QuantizedQuaternion ) + sizeof( float ) );
+      memoryUsage += boneAnimation->getTranslationKeysCount() * ( sizeof( Vector ) + sizeof( float ) );
+   }
+
+   return memoryUsage;
+}
+
+///////////////////////////////////////////////////////////////////////////////
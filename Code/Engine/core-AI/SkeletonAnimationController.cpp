@@ -1,14 +1,41 @@
 #include "core-AI/SkeletonAnimationController.h"
 #include "core-AI/SkeletonAnimation.h"
-#include "core-AI/BoneSRTAnimation.h"
 #include "core-MVC/SpatialEntity.h"
 #include "core/Algorithms.h"
 #include "core/Quaternion.h"
 #include "core/Vector.h"
+#include "core/Transform.h"
 #include <list>
 #include <set>
+#include <algorithm>
 
 
+///////////////////////////////////////////////////////////////////////////////
+
+namespace // anonymous
+{
+   /**
+    * Advances the track time, looping it around the animation length.
+    */
+   void advanceTrackTime( float& trackTime, float timeElapsed, const SkeletonAnimation& animation )
+   {
+      trackTime += timeElapsed;
+
+      const float animLength = animation.getAnimationLength();
+      if ( animLength <= 0.0f )
+      {
+         trackTime = 0.0f;
+         return;
+      }
+
+      while ( trackTime > animLength )
+      {
+         trackTime -= animLength;
+      }
+   }
+
+} // anonymous
+
 ///////////////////////////////////////////////////////////////////////////////
 
 BEGIN_OBJECT( SkeletonAnimationController );
@@ -18,6 +45,19 @@ END_OBJECT();
 
 ///////////////////////////////////////////////////////////////////////////////
 
+SkeletonAnimationController::AnimationLayer::AnimationLayer( SkeletonAnimation* source, float weight, const std::vector< std::string >& boneMask )
+   : m_source( source )
+   , m_weight( weight )
+   , m_boneMask( boneMask )
+   , m_trackTime( 0.f )
+   , m_coversAllBones( false )
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
 SkeletonAnimationController::SkeletonAnimationController( const std::string& name )
    : Entity( name )
    , m_source( NULL )
@@ -36,7 +76,13 @@ SkeletonAnimationController::SkeletonAnimationController( const SkeletonAnimatio
    , m_trackTime( 0.f )
    , m_pause( false )
 {
-
+   // copy the layers setup
+   unsigned int count = rhs.m_layers.size();
+   for ( unsigned int i = 0; i < count; ++i )
+   {
+      const AnimationLayer* layer = rhs.m_layers[i];
+      m_layers.push_back( new AnimationLayer( layer->m_source, layer->m_weight, layer->m_boneMask ) );
+   }
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -47,15 +93,11 @@ SkeletonAnimationController::~SkeletonAnimationController()
    m_parent = NULL;
    
    m_referenceMtcs.clear();
+   m_referencePose.clear();
+   m_scaledReferenceBones.clear();
    m_skeleton.clear();
 
-   // clear the runtime play data
-   unsigned int count = m_bonePlayers.size();
-   for ( unsigned int i = 0; i < count; ++i )
-   {
-      delete m_bonePlayers[i];
-   }
-   m_bonePlayers.clear();
+   clearLayers();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -70,6 +112,52 @@ void SkeletonAnimationController::setAnimationSource( SkeletonAnimation& source
 
 ///////////////////////////////////////////////////////////////////////////////
 
+unsigned int SkeletonAnimationController::addLayer( SkeletonAnimation& source, float weight )
+{
+   AnimationLayer* layer = new AnimationLayer( &source, clamp( weight, 0.0f, 1.0f ), std::vector< std::string >() );
+   layer->m_trackTime = m_trackTime;
+   m_layers.push_back( layer );
+
+   initializeLayer( *layer );
+   mapAnimatedBones();
+
+   return m_layers.size() - 1;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void SkeletonAnimationController::clearLayers()
+{
+   unsigned int count = m_layers.size();
+   for ( unsigned int i = 0; i < count; ++i )
+   {
+      delete m_layers[i];
+   }
+   m_layers.clear();
+
+   mapAnimatedBones();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void SkeletonAnimationController::setLayerWeight( unsigned int layerIdx, float weight )
+{
+   m_layers[layerIdx]->m_weight = clamp( weight, 0.0f, 1.0f );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void SkeletonAnimationController::setLayerBoneMask( unsigned int layerIdx, const std::vector< std::string >& boneNames )
+{
+   AnimationLayer* layer = m_layers[layerIdx];
+   layer->m_boneMask = boneNames;
+
+   initializeLayer( *layer );
+   mapAnimatedBones();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void SkeletonAnimationController::onPropertyChanged( ReflectionProperty& property )
 {
    __super::onPropertyChanged( property );
@@ -111,51 +199,122 @@ void SkeletonAnimationController::onUpdate( float timeElapsed )
    // update the track time ( only if the controller's not paused )
    if ( !m_pause )
    {
-      m_trackTime += timeElapsed;
-      const float animLength = m_source->getAnimationLength();
-      while ( m_trackTime > animLength )
+      advanceTrackTime( m_trackTime, timeElapsed, *m_source );
+
+      unsigned int layersCount = m_layers.size();
+      for ( unsigned int i = 0; i < layersCount; ++i )
       {
-         m_trackTime -= animLength;
+         AnimationLayer* layer = m_layers[i];
+         advanceTrackTime( layer->m_trackTime, timeElapsed, *layer->m_source );
       }
    }
 
-   // Go through the nodes and query the update matrices for them,
-   // updating their local matrices with those
-   Matrix updateMtx, tmpMtx;
-   Quaternion orientation;
-   Vector translation;
+   samplePose();
+
+   // Go through the nodes and concatenate the sampled transforms with the reference pose.
+   // Only the final local transform of a bone is converted to a matrix
+   Transform animTransform, localTransform;
+   Matrix animMtx, localMtx;
    for ( unsigned int i = 0; i < count; ++i )
    {
-      BoneSRTAnimationPlayer* player = m_bonePlayers[i];
-      if ( player == NULL )
+      if ( !m_animatedBones[i] )
       {
-         // there's no bone in the animation definition corresponding
+         // there's no bone in the animation definitions corresponding
          // to the one in the skeleton - skip it
          continue;
       }
 
-      if ( player->getOrientation( m_trackTime, orientation ) )
+      animTransform.m_rotation = m_rotations[i];
+      animTransform.m_translation = m_translations[i];
+      if ( m_scaledReferenceBones[i] )
       {
-         updateMtx.setRotation( orientation );
+         // the reference transform would lose the scale - concatenate with the reference matrix instead
+         animTransform.toMatrix( animMtx );
+         localMtx.setMul( animMtx, m_referenceMtcs[i] );
       }
       else
       {
-         updateMtx.setIdentity();
+         localTransform.setMul( animTransform, m_referencePose[i] );
+         localTransform.toMatrix( localMtx );
       }
 
-      if ( player->getTranslation( m_trackTime, translation ) )
+      m_skeleton[i]->setLocalMtx( localMtx );
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void SkeletonAnimationController::samplePose()
+{
+   // a layer that overrides the entire pose hides all the layers below it, so the blending starts from the topmost one
+   int baseLayerIdx = -1;
+   for ( int i = (int)m_layers.size() - 1; i >= 0; --i )
+   {
+      const AnimationLayer* layer = m_layers[i];
+      if ( layer->m_weight >= 1.0f && layer->m_coversAllBones )
       {
-         tmpMtx.setTranslation( translation );
-         updateMtx.mul( tmpMtx );
+         baseLayerIdx = i;
+         break;
       }
-      
-      updateMtx.mul( m_referenceMtcs[i] );
-      m_skeleton[i]->setLocalMtx( updateMtx );
    }
 
-   // <animation.todo> creating a Transform class that contains only the rotation Quaternion and a position Vector
-   // will remove the need to multiply the matrices so many times, thus speeding this code 200%, and
-   // will reduce the memory footprint
+   SkeletonPoseSampler* basePose = &m_pose;
+   float baseTrackTime = m_trackTime;
+   if ( baseLayerIdx >= 0 )
+   {
+      basePose = &m_layers[baseLayerIdx]->m_pose;
+      baseTrackTime = m_layers[baseLayerIdx]->m_trackTime;
+   }
+
+   basePose->samplePose( baseTrackTime );
+   m_rotations.clear();
+   m_rotations.copyFrom( basePose->getRotations() );
+   m_translations.clear();
+   m_translations.copyFrom( basePose->getTranslations() );
+
+   // blend the layers above it - only the ones that contribute to the pose get sampled
+   unsigned int layersCount = m_layers.size();
+   for ( unsigned int i = baseLayerIdx + 1; i < layersCount; ++i )
+   {
+      AnimationLayer* layer = m_layers[i];
+      if ( layer->m_weight <= 0.0f )
+      {
+         continue;
+      }
+
+      layer->m_pose.samplePose( layer->m_trackTime );
+      blendLayer( *layer );
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void SkeletonAnimationController::blendLayer( const AnimationLayer& layer )
+{
+   FastFloat weight;
+   weight.setFromFloat( layer.m_weight );
+
+   unsigned int paddedCount = m_rotations.size();
+   for ( unsigned int i = 0; i < paddedCount; ++i )
+   {
+      m_blendFactors[i].setMul( layer.m_boneWeights[i], weight );
+   }
+
+   // the rotations are blended four at a time
+   const Array< Quaternion >& layerRotations = layer.m_pose.getRotations();
+   for ( unsigned int i = 0; i < paddedCount; i += 4 )
+   {
+      Quaternion::slerp4( &m_rotations[i], &layerRotations[i], &m_blendFactors[i], &m_rotations[i] );
+   }
+
+   const Array< Vector >& layerTranslations = layer.m_pose.getTranslations();
+   Vector blendedTranslation;
+   unsigned int count = m_skeleton.size();
+   for ( unsigned int i = 0; i < count; ++i )
+   {
+      blendedTranslation.setLerp( m_translations[i], layerTranslations[i], m_blendFactors[i] );
+      m_translations[i] = blendedTranslation;
+   }
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -184,19 +343,12 @@ void SkeletonAnimationController::onDataChanged()
       m_skeleton[i]->setLocalMtx( m_referenceMtcs[i] );
    }
    m_referenceMtcs.clear();
+   m_referencePose.clear();
+   m_scaledReferenceBones.clear();
 
    // clear the skeleton definition
    m_skeleton.clear();
 
-   // clear the runtime play data
-   count = m_bonePlayers.size();
-   for ( unsigned int i = 0; i < count; ++i )
-   {
-      delete m_bonePlayers[i];
-   }
-   m_bonePlayers.clear();
-
-
    // if we have a parent node and an animation source, we can try parsing the skeleton
    if ( m_parent && m_source )
    {
@@ -235,8 +387,17 @@ void SkeletonAnimationController::onDataChanged()
          m_skeleton.push_back( currNode );
          usedBoneNames.insert( currNode->getName() );
 
-         // memorize node's local matrix
-         m_referenceMtcs.push_back( currNode->getLocalMtx() );
+         // memorize node's local matrix - the matrix is used to restore the node when the controller's
+         // detached, and the transform to animate it
+         const Matrix& referenceMtx = currNode->getLocalMtx();
+         m_referenceMtcs.push_back( referenceMtx );
+
+         Transform referenceTransform;
+         referenceTransform.set( referenceMtx );
+         m_referencePose.push_back( referenceTransform );
+
+         bool isScaled = !referenceMtx.sideVec().isNormalized() || !referenceMtx.upVec().isNormalized() || !referenceMtx.forwardVec().isNormalized();
+         m_scaledReferenceBones.push_back( isScaled );
 
          // go through all the children and add those that are spatial entities
          const Entity::Children& children = currNode->getEntityChildren();
@@ -250,11 +411,72 @@ void SkeletonAnimationController::onDataChanged()
             }
          }
       }
+   }
+
+   // prepare the pose sampling data
+   if ( m_source )
+   {
+      m_pose.initialize( *m_source, m_skeleton );
+   }
+   else
+   {
+      m_pose.reset( m_skeleton.size() );
+   }
+
+   unsigned int layersCount = m_layers.size();
+   for ( unsigned int i = 0; i < layersCount; ++i )
+   {
+      initializeLayer( *m_layers[i] );
+   }
+
+   mapAnimatedBones();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void SkeletonAnimationController::initializeLayer( AnimationLayer& layer )
+{
+   unsigned int count = m_skeleton.size();
+   layer.m_pose.initialize( *layer.m_source, m_skeleton );
 
-      if ( m_skeleton.empty() == false )
+   // the layer blends only the bones its animation defines, and the mask selects
+   unsigned int paddedCount = ( count + 3 ) & ~3;
+   layer.m_boneWeights.resizeWithoutInitializing( paddedCount );
+   layer.m_coversAllBones = ( count > 0 );
+   for ( unsigned int i = 0; i < paddedCount; ++i )
+   {
+      bool isBlended = false;
+      if ( i < count && layer.m_pose.isBoneAnimated( i ) )
+      {
+         isBlended = layer.m_boneMask.empty() || std::find( layer.m_boneMask.begin(), layer.m_boneMask.end(), m_skeleton[i]->getName() ) != layer.m_boneMask.end();
+      }
+
+      layer.m_boneWeights[i] = isBlended ? Float_1 : Float_0;
+      if ( i < count && !isBlended )
+      {
+         layer.m_coversAllBones = false;
+      }
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void SkeletonAnimationController::mapAnimatedBones()
+{
+   unsigned int count = m_skeleton.size();
+   unsigned int paddedCount = ( count + 3 ) & ~3;
+   m_animatedBones.resizeWithoutInitializing( count );
+   m_blendFactors.resizeWithoutInitializing( paddedCount );
+
+   unsigned int layersCount = m_layers.size();
+   for ( unsigned int i = 0; i < count; ++i )
+   {
+      bool isAnimated = m_pose.isBoneAnimated( i );
+      for ( unsigned int layerIdx = 0; layerIdx < layersCount && !isAnimated; ++layerIdx )
       {
-         m_source->initializePlayer( m_skeleton, m_bonePlayers );
+         isAnimated = m_layers[layerIdx]->m_pose.isBoneAnimated( i );
       }
+      m_animatedBones[i] = isAnimated;
    }
 }
 
@@ -0,0 +1,114 @@
+#include "core-AI/SkeletonPoseSampler.h"
+#include "core-AI/SkeletonAnimation.h"
+#include "core-AI/BoneSRTAnimation.h"
+#include "core/Node.h"
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace // anonymous
+{
+   /**
+    * Resizes the array and sets all of its elements to the specified value.
+    */
+   template< typename T >
+   void resetArray( Array< T >& arr, unsigned int size, const T& value )
+   {
+      arr.resizeWithoutInitializing( size );
+      for ( unsigned int i = 0; i < size; ++i )
+      {
+         arr[i] = value;
+      }
+   }
+
+} // anonymous
+
+///////////////////////////////////////////////////////////////////////////////
+
+SkeletonPoseSampler::SkeletonPoseSampler()
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+SkeletonPoseSampler::~SkeletonPoseSampler()
+{
+   deletePlayers();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void SkeletonPoseSampler::deletePlayers()
+{
+   unsigned int count = m_bonePlayers.size();
+   for ( unsigned int i = 0; i < count; ++i )
+   {
+      delete m_bonePlayers[i];
+   }
+   m_bonePlayers.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void SkeletonPoseSampler::initialize( const SkeletonAnimation& animation, const std::vector< Node* >& skeleton )
+{
+   reset( skeleton.size() );
+
+   if ( skeleton.empty() == false )
+   {
+      animation.initializePlayer( skeleton, m_bonePlayers );
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void SkeletonPoseSampler::reset( unsigned int bonesCount )
+{
+   deletePlayers();
+   m_bonePlayers.resize( bonesCount, NULL );
+
+   // the bones that aren't animated stay in the identity pose
+   unsigned int paddedCount = ( bonesCount + 3 ) & ~3;
+   const Quaternion identityRotation = Quaternion::getIdentity();
+   const Vector zeroTranslation( Quad_0 );
+   resetArray( m_startRotations, paddedCount, identityRotation );
+   resetArray( m_endRotations, paddedCount, identityRotation );
+   resetArray( m_rotationFactors, paddedCount, Float_0 );
+   resetArray( m_rotations, paddedCount, identityRotation );
+   resetArray( m_startTranslations, paddedCount, zeroTranslation );
+   resetArray( m_endTranslations, paddedCount, zeroTranslation );
+   resetArray( m_translationFactors, paddedCount, Float_0 );
+   resetArray( m_translations, paddedCount, zeroTranslation );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void SkeletonPoseSampler::samplePose( float time )
+{
+   // find the keys each bone is between at the moment
+   unsigned int count = m_bonePlayers.size();
+   for ( unsigned int i = 0; i < count; ++i )
+   {
+      BoneSRTAnimationPlayer* player = m_bonePlayers[i];
+      if ( player != NULL )
+      {
+         player->getOrientationKeys( time, m_startRotations[i], m_endRotations[i], m_rotationFactors[i] );
+         player->getTranslationKeys( time, m_startTranslations[i], m_endTranslations[i], m_translationFactors[i] );
+      }
+   }
+
+   // interpolate the rotations of four bones at a time
+   unsigned int paddedCount = m_rotations.size();
+   for ( unsigned int i = 0; i < paddedCount; i += 4 )
+   {
+      Quaternion::slerp4( &m_startRotations[i], &m_endRotations[i], &m_rotationFactors[i], &m_rotations[i] );
+   }
+
+   // a translation fits a single quad, so it's interpolated with a single operation anyway
+   for ( unsigned int i = 0; i < count; ++i )
+   {
+      m_translations[i].setLerp( m_startTranslations[i], m_endTranslations[i], m_translationFactors[i] );
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
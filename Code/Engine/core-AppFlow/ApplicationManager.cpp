@@ -2,6 +2,7 @@
 #include "core-AppFlow\Application.h"
 #include "core-AppFlow\ApplicationData.h"
 #include "core-AppFlow\TimeController.h"
+#include "core\ResourcesManager.h"
 #include <stdexcept>
 #include <windows.h>
 
@@ -113,6 +114,13 @@ bool ApplicationManager::step()
    float timeElapsed = getTimeElapsed();
    m_globalTimeController->update(timeElapsed);
 
+   // register the resources that finished loading in the background, reload the edited ones, and evict
+   // the unused ones if they don't fit in the memory budget
+   ResourcesManager& resMgr = ResourcesManager::getInstance();
+   resMgr.processLoadedResources();
+   resMgr.processEditedFiles( timeElapsed );
+   resMgr.enforceMemoryBudget();
+
    switch(onStep())
    {
    case APC_SYSTEM:      return true;
@@ -83,6 +83,7 @@ void Entity::add( Entity* entity, bool manage )
       entity->m_parent->remove( *entity, false );
    }
    entity->m_parent = this;
+   entity->markDirty();
 
    // register it as a child
    if ( manage )
@@ -90,6 +91,7 @@ void Entity::add( Entity* entity, bool manage )
       m_managedChildren.push_back( entity );
    }
    m_children.push_back( entity );
+   markDirty();
 
    if ( m_hostModel != NULL )
    {
@@ -116,6 +118,8 @@ void Entity::remove( Entity& entity, bool release )
       m_hostModel->remove( entity );
    }
    entity.m_parent = NULL;
+   entity.markDirty();
+   markDirty();
 
    // remove the entity from the managed entities list
    Children::iterator it = std::find( m_managedChildren.begin(), m_managedChildren.end(), &entity );
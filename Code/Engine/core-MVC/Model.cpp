@@ -112,6 +112,7 @@ void Model::add( Entity* entity, bool manage )
    }
 
    m_entities.push_back( entity );
+   markDirty();
    entity->onAttachToModel(*this);
    entityDFS( *entity, Functor::FROM_METHOD( Model, notifyEntityAdded, this ) );
 
@@ -130,6 +131,7 @@ void Model::remove( Entity& entity )
 {
    entityDFS( entity, Functor::FROM_METHOD( Model, notifyEntityRemoved, this ) );
    entity.onDetachFromModel( *this );
+   markDirty();
 
    // remove it from the managed entities list ( and delete it )
    Entities::iterator it = std::find( m_managedEntities.begin(), m_managedEntities.end(), &entity );
@@ -171,6 +173,7 @@ void Model::clear()
 
    // and remove all added entities
    m_entities.clear();
+   markDirty();
 
    // clear the views
    count = m_views.size();
@@ -446,6 +449,35 @@ void Model::onComponentRemoved( Component< Model >& component )
 
 ///////////////////////////////////////////////////////////////////////////////
 
+void Model::mergeContents( Resource& rhs )
+{
+   // the entities of the merged model may be referenced elsewhere, so add their copies
+   Model& mergedModel = static_cast< Model& >( rhs );
+   std::vector< Entity* > clonedEntities;
+   mergedModel.clone( clonedEntities );
+
+   unsigned int count = clonedEntities.size();
+   for ( unsigned int i = 0; i < count; ++i )
+   {
+      add( clonedEntities[i] );
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void Model::replaceContents( Resource& rhs )
+{
+   // remove the entities one by one, so that the views let go of them as well
+   while ( !m_entities.empty() )
+   {
+      remove( *m_entities.back() );
+   }
+
+   mergeContents( rhs );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void Model::onResourceLoaded( ResourcesManager& mgr )
 {
    __super::onResourceLoaded( mgr );
@@ -32,6 +32,7 @@ void EffectShader::setScript( const std::string& script )
 {
    m_script = script;
    setDirty();
+   markDirty();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
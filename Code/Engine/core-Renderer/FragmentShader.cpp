@@ -15,3 +15,18 @@ FragmentShader::FragmentShader( const FilePath& resourceName )
 }
 
 ///////////////////////////////////////////////////////////////////////////////
+
+uint FragmentShader::getMemoryUsage() const
+{
+   return sizeof( FragmentShader ) + m_script.capacity();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void FragmentShader::replaceContents( Resource& rhs )
+{
+   FragmentShader& newShader = static_cast< FragmentShader& >( rhs );
+   m_script.swap( newShader.m_script );
+}
+
+///////////////////////////////////////////////////////////////////////////////
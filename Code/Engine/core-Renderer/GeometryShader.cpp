@@ -51,3 +51,36 @@ void GeometryShader::onResourceLoaded( ResourcesManager& mgr )
 }
 
 ///////////////////////////////////////////////////////////////////////////////
+
+void GeometryShader::replaceContents( Resource& rhs )
+{
+   // take over the nodes of the discarded shader, the same way Material does
+   GeometryShader& newShader = static_cast< GeometryShader& >( rhs );
+   GraphBuilderTransaction< GeometryShader, GeometryShaderNode > transaction( *this );
+
+   uint count = m_nodes.size();
+   for ( uint i = 0; i < count; ++i )
+   {
+      if ( m_nodes[i] )
+      {
+         transaction.removeNode( *m_nodes[i] );
+      }
+   }
+
+   count = newShader.m_nodes.size();
+   for ( uint i = 0; i < count; ++i )
+   {
+      GeometryShaderNode* node = newShader.m_nodes[i];
+      if ( node )
+      {
+         newShader.removeObjectExternally( node->getObjectId() );
+         node->onGraphLoaded();
+         transaction.addNode( node );
+      }
+   }
+   newShader.m_nodes.clear();
+
+   transaction.commit();
+}
+
+///////////////////////////////////////////////////////////////////////////////
@@ -97,3 +97,10 @@ void LineSegments::render( Renderer& renderer )
 }
 
 ///////////////////////////////////////////////////////////////////////////////
+
+uint LineSegments::getMemoryUsage() const
+{
+   return sizeof( LineSegments ) + m_segments.size() * sizeof( LineSegment );
+}
+
+///////////////////////////////////////////////////////////////////////////////
@@ -52,3 +52,46 @@ void Material::onResourceLoaded( ResourcesManager& mgr )
 }
 
 ///////////////////////////////////////////////////////////////////////////////
+
+uint Material::getMemoryUsage() const
+{
+   // the nodes come in different sizes - the base size is a good enough estimate
+   return sizeof( Material ) + m_nodes.size() * sizeof( MaterialNode );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void Material::replaceContents( Resource& rhs )
+{
+   // the new material is about to be discarded, so take over its nodes, along with the connections
+   // between them - the transaction makes the material instances rebuild their node queues.
+   // The copy wasn't loaded by the resources manager, so its nodes weren't informed about the graph being loaded
+   Material& newMaterial = static_cast< Material& >( rhs );
+   GraphBuilderTransaction< Material, MaterialNode > transaction( *this );
+
+   uint count = m_nodes.size();
+   for ( uint i = 0; i < count; ++i )
+   {
+      if ( m_nodes[i] )
+      {
+         transaction.removeNode( *m_nodes[i] );
+      }
+   }
+
+   count = newMaterial.m_nodes.size();
+   for ( uint i = 0; i < count; ++i )
+   {
+      MaterialNode* node = newMaterial.m_nodes[i];
+      if ( node )
+      {
+         newMaterial.removeObjectExternally( node->getObjectId() );
+         node->onGraphLoaded();
+         transaction.addNode( node );
+      }
+   }
+   newMaterial.m_nodes.clear();
+
+   transaction.commit();
+}
+
+///////////////////////////////////////////////////////////////////////////////
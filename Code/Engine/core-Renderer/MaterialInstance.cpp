@@ -75,6 +75,7 @@ void MaterialInstance::setMaterialRenderer( Material* materialRenderer )
 
    // set the new material renderer
    m_materialRenderer = materialRenderer;
+   markDirty();
 
    // initialize it and the dependencies
    initializeMaterial();
@@ -151,6 +151,7 @@ void PixelShader::setScript( const std::string& script )
    m_requiredVertexShaderTechniqueId = VertexShader::generateTechniqueId( techniqueName );
 
    setDirty(); 
+   markDirty();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -187,6 +188,46 @@ void PixelShader::parseTextureStages()
    }
 }
 
+///////////////////////////////////////////////////////////////////////////////
+
+uint PixelShader::getMemoryUsage() const
+{
+   uint memoryUsage = sizeof( PixelShader ) + m_script.capacity() + m_entryFunctionName.capacity();
+   memoryUsage += m_textureStages.size() * sizeof( TextureStageParams );
+   memoryUsage += m_constantsDescriptions.size() * sizeof( ShaderConstantDesc );
+
+   unsigned int stagesCount = m_textureStageName.size();
+   for ( unsigned int i = 0; i < stagesCount; ++i )
+   {
+      memoryUsage += sizeof( std::string ) + m_textureStageName[i].capacity();
+   }
+
+   return memoryUsage;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void PixelShader::replaceContents( Resource& rhs )
+{
+   // the new shader is about to be discarded, so take over its script along with the data parsed from it
+   PixelShader& newShader = static_cast< PixelShader& >( rhs );
+   m_script.swap( newShader.m_script );
+   m_entryFunctionName.swap( newShader.m_entryFunctionName );
+   m_params = newShader.m_params;
+   m_textureStages.swap( newShader.m_textureStages );
+   m_requiredVertexShaderTechniqueId = newShader.m_requiredVertexShaderTechniqueId;
+   m_textureStageName.swap( newShader.m_textureStageName );
+   m_constantsDescriptions.swap( newShader.m_constantsDescriptions );
+
+   if ( m_constantsDescriptions.empty() || m_textureStageName.empty() )
+   {
+      // the shader probably wasn't compiled - so attempt it now
+      parseTextureStages();
+   }
+
+   setDirty();
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
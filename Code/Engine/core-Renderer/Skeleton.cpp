@@ -138,3 +138,36 @@ int Skeleton::getBoneIndex( const std::string& boneId ) const
 }
 
 ///////////////////////////////////////////////////////////////////////////////
+
+uint Skeleton::getMemoryUsage() const
+{
+   uint memoryUsage = sizeof( Skeleton );
+
+   unsigned int bonesCount = m_boneNames.size();
+   for ( unsigned int i = 0; i < bonesCount; ++i )
+   {
+      memoryUsage += sizeof( std::string ) + m_boneNames[i].capacity();
+   }
+   memoryUsage += m_invBoneMatrices.size() * sizeof( Matrix );
+   memoryUsage += m_weights.size() * sizeof( VertexWeight );
+
+   return memoryUsage;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void Skeleton::replaceContents( Resource& rhs )
+{
+   Skeleton& newSkeleton = static_cast< Skeleton& >( rhs );
+   m_bindShapeMtx = newSkeleton.m_bindShapeMtx;
+   m_boneNames.swap( newSkeleton.m_boneNames );
+   m_weights.swap( newSkeleton.m_weights );
+
+   m_invBoneMatrices.clear();
+   m_invBoneMatrices.copyFrom( newSkeleton.m_invBoneMatrices );
+
+   // mark the render resource as dirty
+   setDirty();
+}
+
+///////////////////////////////////////////////////////////////////////////////
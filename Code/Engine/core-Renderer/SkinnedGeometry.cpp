@@ -8,6 +8,8 @@
 #include "core-Renderer\Defines.h"
 #include "core-MVC.h"
 #include "core.h"
+#include <list>
+#include <unordered_map>
 
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -32,8 +34,8 @@ SkinnedGeometry::SkinnedGeometry()
 
 SkinnedGeometry::SkinnedGeometry( const SkinnedGeometry& rhs )
    : Geometry( rhs )
-   , m_skeleton( m_skeleton )
-   , m_vertexShader( m_vertexShader )
+   , m_skeleton( rhs.m_skeleton )
+   , m_vertexShader( rhs.m_vertexShader )
    , m_vol( new AABoundingBox() )
 {
    initialize();
@@ -66,25 +68,34 @@ RCBindVertexShader* SkinnedGeometry::onPreRender( Renderer& renderer )
       return NULL;
    }
 
+   // the names of the shader parameters are mapped only once
+   static IDString skinningMatricesParamName( "g_mSkinningMatrices" );
+   static IDString viewMtxParamName( "g_mView" );
+   static IDString projectionMtxParamName( "g_mProjection" );
+
    Camera& camera = renderer.getActiveCamera();
 
    new ( renderer() ) RCBindSkeleton( *m_skeleton );
 
    RCBindVertexShader* comm = new ( renderer() ) RCBindVertexShader( *m_vertexShader, renderer );
 
-   // set the transformation matrices
+   // set the transformation matrices - the bone nodes were mapped in the order of the skeleton bones
+   const Array< Matrix >& invBindPoseMatrices = m_skeleton->getInvBindPoseMatrices();
    unsigned int bonesCount = m_bones.size();
-   for ( unsigned int i = 0; i < bonesCount; ++i )
+   unsigned int boundBonesCount = min2( bonesCount, invBindPoseMatrices.size() );
+   for ( unsigned int i = 0; i < boundBonesCount; ++i )
    {
-      Node* bone = m_bones[i];
-      Matrix& boneMatrix = m_boneMatrices[i];
-      const Matrix& invBindPoseMtx = m_skeleton->getInvBindPoseMtx( bone->getName() );
+      m_boneMatrices[i].setMul( invBindPoseMatrices[i], m_bones[i]->getGlobalMtx() );
+   }
 
-      boneMatrix.setMul( invBindPoseMtx, bone->getGlobalMtx() );
+   // the bones that were only assigned skin weights have an identity bind pose
+   for ( unsigned int i = boundBonesCount; i < bonesCount; ++i )
+   {
+      m_boneMatrices[i] = m_bones[i]->getGlobalMtx();
    }
-   comm->setMtx( "g_mSkinningMatrices", m_boneMatrices, m_boneMatrices.size() );
-   comm->setMtx( "g_mView", camera.getViewMtx() );
-   comm->setMtx( "g_mProjection", camera.getProjectionMtx() );
+   comm->setMtx( skinningMatricesParamName, m_boneMatrices, m_boneMatrices.size() );
+   comm->setMtx( viewMtxParamName, camera.getViewMtx() );
+   comm->setMtx( projectionMtxParamName, camera.getProjectionMtx() );
 
    return comm;
 }
@@ -117,29 +128,58 @@ void SkinnedGeometry::instantiateSkeleton( Entity& parent )
 
    unsigned int bonesCount = m_skeleton->getBonesCount();
 
-   m_bones.resize( bonesCount );
+   m_bones.resize( bonesCount, NULL );
    m_boneMatrices.allocate( bonesCount );
    for ( unsigned int boneIdx = 0; boneIdx < bonesCount; ++boneIdx )
    {
       m_boneMatrices.push_back( Matrix::IDENTITY );
    }
 
+   // map the bones in a single pass over the hierarchy. The nodes are visited breadth first,
+   // so a bone gets mapped to the same node Node::findNode would return
+   std::unordered_map< std::string, unsigned int > boneIndices;
+   for ( unsigned int boneIdx = 0; boneIdx < bonesCount; ++boneIdx )
+   {
+      boneIndices.insert( std::make_pair( m_skeleton->getBoneName( boneIdx ), boneIdx ) );
+   }
+
+   unsigned int mappedBonesCount = 0;
+   std::list< Node* > nodesQueue;
+   nodesQueue.push_back( parentNode );
+   while ( !nodesQueue.empty() && mappedBonesCount < bonesCount )
+   {
+      Node* node = nodesQueue.front();
+      nodesQueue.pop_front();
+
+      std::unordered_map< std::string, unsigned int >::const_iterator it = boneIndices.find( node->getName() );
+      if ( it != boneIndices.end() && m_bones[ it->second ] == NULL )
+      {
+         m_bones[ it->second ] = node;
+         ++mappedBonesCount;
+      }
+
+      const std::list< Node* >& children = node->getChildren();
+      for ( std::list< Node* >::const_iterator childIt = children.begin(); childIt != children.end(); ++childIt )
+      {
+         if ( *childIt != NULL )
+         {
+            nodesQueue.push_back( *childIt );
+         }
+      }
+   }
+
+   // verify that we got all the bones - we either address the entire skeleton, or none of it
    for ( unsigned int boneIdx = 0; boneIdx < bonesCount; ++boneIdx )
    {
-      const std::string& boneId = m_skeleton->getBoneName( boneIdx );
-      Node* bone = parentNode->findNode( boneId );
-
-      // verify that we get the bone - we either address the entire skeleton, or none of it
-      static char tmpStr[256];
-      sprintf( tmpStr, "Bone '%s' does not exist", boneId.c_str() );
-      ASSERT_MSG( bone != NULL, tmpStr );
-      if ( !bone )
+      if ( m_bones[ boneIdx ] == NULL )
       {
+         static char tmpStr[256];
+         sprintf( tmpStr, "Bone '%s' does not exist", m_skeleton->getBoneName( boneIdx ).c_str() );
+         ASSERT_MSG( false, tmpStr );
+
          m_bones.clear();
          return;
       }
-
-      m_bones[ boneIdx ] = bone;
    }
 }
 
@@ -18,6 +18,7 @@ Texture::Texture( const FilePath& resourceName )
    , m_usage( TU_COLOR )
    , m_width( 0 )
    , m_height( 0 )
+   , m_imageSize( 0 )
 {
 }
 
@@ -34,26 +35,27 @@ void Texture::getBuffer( byte*& imgBuffer, unsigned int& bufSize ) const
    ResourcesManager& resMgr = ResourcesManager::getInstance();
    const Filesystem& fs = resMgr.getFilesystem();
 
-   // load the file
-   File* file = fs.open( m_texFileName, std::ios_base::in | std::ios_base::binary );
-   if (file == NULL)
+   // map the file - that way we only need to copy its contents once
+   MappedFile* file = fs.map( m_texFileName );
+   if ( file == NULL )
    {
-      ASSERT_MSG( false, "Texture file doesn't exist" );
-      return;
-   }
-   StreamBuffer<byte> buf(*file);
-
-   bufSize = buf.size();
-   if ( bufSize == 0 )
-   {
-      delete file;
-      ASSERT_MSG( false, "Empty texture image" );
+      ASSERT_MSG( false, "Texture file doesn't exist or is empty" );
       return;
    }
 
+   bufSize = file->size();
+   m_imageSize = bufSize;
    imgBuffer = new byte[ bufSize ];
-   memcpy( imgBuffer, buf.getBuffer(), bufSize );
+   memcpy( imgBuffer, file->getData(), bufSize );
    delete file;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
+
+uint Texture::getMemoryUsage() const
+{
+   // the image itself isn't kept in the resource, but the renderer keeps a texture created from it for as long as the resource lives
+   return sizeof( Texture ) + m_imageSize;
+}
+
+///////////////////////////////////////////////////////////////////////////////
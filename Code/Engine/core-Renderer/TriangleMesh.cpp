@@ -66,6 +66,27 @@ void TriangleMesh::calculateBoundingVolume()
 
 ///////////////////////////////////////////////////////////////////////////////
 
+uint TriangleMesh::getMemoryUsage() const
+{
+   return sizeof( TriangleMesh ) + m_vertices.size() * sizeof( LitVertex ) + m_faces.size() * sizeof( Face );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void TriangleMesh::replaceContents( Resource& rhs )
+{
+   // the new mesh is about to be discarded, so take over its geometry
+   TriangleMesh& newMesh = static_cast< TriangleMesh& >( rhs );
+   m_vertices.swap( newMesh.m_vertices );
+   m_faces.swap( newMesh.m_faces );
+
+   // mark the render resource as dirty
+   m_boundsDirty = true;
+   setDirty();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 VertexArray* TriangleMesh::getGenericVertexArray() const
 {
    TVertexArray<LitVertex>* array = new TVertexArray<LitVertex>();
@@ -92,6 +113,8 @@ void TriangleMesh::render( Renderer& renderer )
 void TriangleMesh::calculateTangents()
 {
    MeshUtils::calculateVertexTangents( m_faces, m_vertices );
+   setDirty();
+   markDirty();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -115,6 +138,7 @@ void TriangleMesh::setVertices( const LitVertex* arrVertices, uint verticesCount
    // mark the render resource as dirty
    m_boundsDirty = true;
    setDirty();
+   markDirty();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -131,6 +155,7 @@ void TriangleMesh::setFaces( const Face* arrFaces, uint facesCount )
 
    // mark the render resource as dirty
    setDirty();
+   markDirty();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -32,6 +32,7 @@ VertexShader::VertexShader( const FilePath& resourceName )
 void VertexShader::setVertexDescription( VertexDescId vertexDescId )
 {
    m_vertexDescId = vertexDescId;
+   markDirty();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -71,6 +72,7 @@ void VertexShader::setScript( const std::string& script )
    parseTechniques();
    parseConstants();
    setDirty(); 
+   markDirty();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -174,6 +176,40 @@ void VertexShader::parseConstants()
    }
 }
 
+///////////////////////////////////////////////////////////////////////////////
+
+uint VertexShader::getMemoryUsage() const
+{
+   uint memoryUsage = sizeof( VertexShader ) + m_script.capacity() + m_entryFunctionName.capacity() + m_techniqueNames.capacity();
+   memoryUsage += m_constantsDescriptions.size() * sizeof( ShaderConstantDesc );
+   memoryUsage += m_arrTechniqueIds.size() * sizeof( uint );
+
+   unsigned int functionsCount = m_arrEntryFunctionNames.size();
+   for ( unsigned int i = 0; i < functionsCount; ++i )
+   {
+      memoryUsage += sizeof( std::string ) + m_arrEntryFunctionNames[i].capacity();
+   }
+
+   return memoryUsage;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void VertexShader::replaceContents( Resource& rhs )
+{
+   // the new shader is about to be discarded, so take over its script along with the data parsed from it
+   VertexShader& newShader = static_cast< VertexShader& >( rhs );
+   m_script.swap( newShader.m_script );
+   m_entryFunctionName.swap( newShader.m_entryFunctionName );
+   m_techniqueNames.swap( newShader.m_techniqueNames );
+   m_vertexDescId = newShader.m_vertexDescId;
+   m_constantsDescriptions.swap( newShader.m_constantsDescriptions );
+   m_arrEntryFunctionNames.swap( newShader.m_arrEntryFunctionNames );
+   m_arrTechniqueIds.swap( newShader.m_arrTechniqueIds );
+
+   setDirty();
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -3,6 +3,7 @@
 #include "core\MemoryUtils.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <windows.h>
 
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -17,7 +18,7 @@ DefaultAllocator::DefaultAllocator()
 void* DefaultAllocator::alloc( size_t size )
 {
    void* ptr = ::malloc( size );
-   m_allocatedMemorySize += size;
+   InterlockedExchangeAdd( &m_allocatedMemorySize, (long)size );
    return ptr;
 }
 
@@ -26,7 +27,7 @@ void* DefaultAllocator::alloc( size_t size )
 void DefaultAllocator::dealloc( void* ptr )
 {
    ulong allocatedSize = *( (ulong*)ptr - 4 );
-   m_allocatedMemorySize -= allocatedSize;
+   InterlockedExchangeAdd( &m_allocatedMemorySize, -(long)allocatedSize );
 
    ::free( ptr );
 }
@@ -13,6 +13,9 @@ File::File( const Filesystem& hostFS, const FilePath& name, const std::ios_base:
    : m_hostFS( hostFS )
    , m_name( name )
    , m_openMode( openMode )
+   , m_archivedData( NULL )
+   , m_archivedDataSize( 0 )
+   , m_archivedDataPos( 0 )
 {
    // construct the attributes string
    char openModeStr[4];
@@ -62,6 +65,19 @@ File::File( const Filesystem& hostFS, const FilePath& name, const std::ios_base:
 
 ///////////////////////////////////////////////////////////////////////////////
 
+File::File( const Filesystem& hostFS, const FilePath& name, const byte* data, std::size_t size )
+   : m_hostFS( hostFS )
+   , m_file( NULL )
+   , m_name( name )
+   , m_openMode( std::ios_base::in | std::ios_base::binary )
+   , m_archivedData( data )
+   , m_archivedDataSize( size )
+   , m_archivedDataPos( 0 )
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 File::~File()
 {
    if ( m_file )
@@ -81,6 +97,20 @@ File::~File()
 
 void File::seek(DWORD offset, std::ios_base::seekdir dir)
 {
+   if ( m_archivedData )
+   {
+      long base = ( dir == std::ios_base::beg ) ? 0 : ( ( dir == std::ios_base::end ) ? ( long )m_archivedDataSize : ( long )m_archivedDataPos );
+
+      // the offset may be negative when seeking relative to the end of the file or the current position
+      long newPos = base + ( long )offset;
+      if ( newPos < 0 )
+      {
+         newPos = 0;
+      }
+      m_archivedDataPos = ( ( std::size_t )newPos < m_archivedDataSize ) ? ( std::size_t )newPos : m_archivedDataSize;
+      return;
+   }
+
    ASSERT_MSG( m_file, "File not opened" );
 
    int whence;
@@ -112,6 +142,11 @@ void File::seek(DWORD offset, std::ios_base::seekdir dir)
 
 std::size_t File::tell() const
 {
+   if ( m_archivedData )
+   {
+      return m_archivedDataPos;
+   }
+
    ASSERT_MSG( m_file, "File not opened" );
    return ftell(m_file);
 }
@@ -120,6 +155,15 @@ std::size_t File::tell() const
 
 std::size_t File::read(byte* buffer, std::size_t size)
 {
+   if ( m_archivedData )
+   {
+      std::size_t bytesLeft = m_archivedDataSize - m_archivedDataPos;
+      std::size_t bytesRead = ( size < bytesLeft ) ? size : bytesLeft;
+      memcpy( buffer, m_archivedData + m_archivedDataPos, bytesRead );
+      m_archivedDataPos += bytesRead;
+      return bytesRead;
+   }
+
    ASSERT_MSG( m_file, "File not opened" );
    std::size_t bytesRead = fread(buffer, 1, size, m_file);
    return bytesRead;
@@ -129,7 +173,7 @@ std::size_t File::read(byte* buffer, std::size_t size)
 
 std::size_t File::write(byte* buffer, std::size_t size)
 {
-   ASSERT_MSG( m_file, "File not opened" );
+   ASSERT_MSG( m_file, "File not opened, or it's an archived file that can't be modified" );
    std::size_t bytesWritten = fwrite(buffer, 1, size, m_file);
    return bytesWritten;
 }
@@ -138,6 +182,23 @@ std::size_t File::write(byte* buffer, std::size_t size)
 
 void File::readString(char* outStrData, std::size_t size)
 {
+   if ( m_archivedData )
+   {
+      // same as fgets - read up to the end of the line, including the newline character
+      std::size_t count = 0;
+      while ( count + 1 < size && m_archivedDataPos < m_archivedDataSize )
+      {
+         char c = ( char )m_archivedData[m_archivedDataPos++];
+         outStrData[count++] = c;
+         if ( c == '\n' )
+         {
+            break;
+         }
+      }
+      outStrData[count] = 0;
+      return;
+   }
+
    ASSERT_MSG( m_file, "File not opened" );
    fgets(outStrData, size, m_file);
 }
@@ -146,7 +207,7 @@ void File::readString(char* outStrData, std::size_t size)
 
 void File::writeString(const char* strData)
 {
-   ASSERT_MSG( m_file, "File not opened" );
+   ASSERT_MSG( m_file, "File not opened, or it's an archived file that can't be modified" );
 
    if ( fputs(strData, m_file) == EOF )
    {
@@ -158,6 +219,11 @@ void File::writeString(const char* strData)
 
 void File::flush()
 {
+   if ( m_archivedData )
+   {
+      return;
+   }
+
    ASSERT_MSG( m_file, "File not opened" );
    fflush(m_file);
 }
@@ -166,6 +232,11 @@ void File::flush()
 
 bool File::eof() const
 {
+   if ( m_archivedData )
+   {
+      return m_archivedDataPos >= m_archivedDataSize;
+   }
+
    ASSERT_MSG( m_file, "File not opened" );
    return feof(m_file) != 0;
 }
@@ -174,6 +245,11 @@ bool File::eof() const
 
 std::size_t File::size() const
 {
+   if ( m_archivedData )
+   {
+      return m_archivedDataSize;
+   }
+
    ASSERT_MSG( m_file, "File not opened" );
    return _filelength(m_file->_file); 
 }
@@ -182,7 +258,7 @@ std::size_t File::size() const
 
 void File::setSize(std::size_t newSize)
 {
-   ASSERT_MSG( m_file, "File not opened" );
+   ASSERT_MSG( m_file, "File not opened, or it's an archived file that can't be modified" );
    if ( _chsize(m_file->_file, newSize) != 0 )
    {
       ASSERT_MSG( false, "Couldn't resize a file" );
@@ -12,6 +12,7 @@
 
 FilePath::FilePath()
 {
+   updateHash();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -25,13 +26,15 @@ FilePath::~FilePath()
 FilePath::FilePath( const std::string& path )
 {
    FilesystemUtils::normalize( path, m_relativePath );
+   updateHash();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
 FilePath::FilePath( const FilePath& rhs )
+   : m_relativePath( rhs.m_relativePath )
+   , m_hash( rhs.m_hash )
 {
-   m_relativePath = rhs.m_relativePath;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -39,6 +42,25 @@ FilePath::FilePath( const FilePath& rhs )
 void FilePath::set( const std::string& path )
 {
    FilesystemUtils::normalize( path, m_relativePath );
+   updateHash();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void FilePath::updateHash()
+{
+   // FNV-1a - unlike StringUtils::calculateHash, it doesn't use a shared buffer,
+   // so the paths can be created on multiple threads
+   uint hash = 2166136261u;
+
+   const char* str = m_relativePath.c_str();
+   for ( ; *str != 0; ++str )
+   {
+      hash ^= ( byte )*str;
+      hash *= 16777619u;
+   }
+
+   m_hash = hash;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -74,6 +96,7 @@ std::string FilePath::extractExtension() const
 void FilePath::extractDir( FilePath& outDir ) const
 {
    outDir.m_relativePath = FilesystemUtils::extractDir( m_relativePath );
+   outDir.updateHash();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -81,6 +104,7 @@ void FilePath::extractDir( FilePath& outDir ) const
 void FilePath::leaveDir(  unsigned int levels, FilePath& outDirectory ) const
 {
    FilesystemUtils::leaveDir( m_relativePath, levels, outDirectory.m_relativePath );
+   outDirectory.updateHash();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -97,7 +121,7 @@ void FilePath::changeFileExtension( const std::string& newExtension, FilePath& o
    if ( newExtension.empty() )
    {
       // nothing to change
-      outPath.m_relativePath = m_relativePath;
+      outPath = *this;
       return;
    }
 
@@ -110,6 +134,7 @@ void FilePath::changeFileExtension( const std::string& newExtension, FilePath& o
    {
       outPath.m_relativePath = m_relativePath + "." + newExtension;
    }
+   outPath.updateHash();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -146,6 +171,7 @@ OutStream& operator<<( OutStream& serializer, const FilePath& path )
 InStream& operator>>( InStream& serializer, FilePath& path )
 {
    serializer >> path.m_relativePath;
+   path.updateHash();
    return serializer;
 }
 
@@ -2,7 +2,10 @@
 #include "core\Filesystem.h"
 #include "core\FilesystemUtils.h"
 #include "core\File.h"
+#include "core\MappedFile.h"
 #include "core\FilePath.h"
+#include "core\FilesystemArchive.h"
+#include "core\FilesystemIndex.h"
 #include "core\StringUtils.h"
 #include <stdexcept>
 #include <algorithm>
@@ -71,12 +74,27 @@ namespace // anonymous
 ///////////////////////////////////////////////////////////////////////////////
 
 Filesystem::Filesystem(const std::string& rootDir)
+   : m_index( NULL )
 {
+   m_index = new FilesystemIndex( *this );
+   attach( *m_index );
+
    changeRootDir(rootDir);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
+Filesystem::~Filesystem()
+{
+   unmountArchives();
+
+   detach( *m_index );
+   delete m_index;
+   m_index = NULL;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void Filesystem::changeRootDir(const std::string& rootDir)
 {
    m_rootDir = rootDir;
@@ -86,6 +104,9 @@ void Filesystem::changeRootDir(const std::string& rootDir)
    {
       m_rootDir += "/";
    }
+
+   // the indexed paths are absolute, and they're no longer a part of this filesystem
+   m_index->clear();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -105,6 +126,14 @@ bool Filesystem::isDir( const FilePath& fileName ) const
       return true;
    }
 
+   for ( Archives::const_reverse_iterator it = m_archives.rbegin(); it != m_archives.rend(); ++it )
+   {
+      if ( ( *it )->isDir( fileName ) )
+      {
+         return true;
+      }
+   }
+
    std::string absPathStr = fileName.toAbsolutePath( *this );
    DWORD attribs = GetFileAttributesA( absPathStr.c_str() );
    return ( ( attribs & FILE_ATTRIBUTE_DIRECTORY ) == INVALID_FILE_ATTRIBUTES );
@@ -119,6 +148,14 @@ bool Filesystem::doesExist( const FilePath& fileName ) const
       return false;
    }
 
+   for ( Archives::const_reverse_iterator it = m_archives.rbegin(); it != m_archives.rend(); ++it )
+   {
+      if ( ( *it )->doesExist( fileName ) )
+      {
+         return true;
+      }
+   }
+
    std::string absPathStr = fileName.toAbsolutePath( *this );
    DWORD attribs = GetFileAttributesA( absPathStr.c_str() );
    return attribs != INVALID_FILE_ATTRIBUTES;
@@ -128,6 +165,20 @@ bool Filesystem::doesExist( const FilePath& fileName ) const
 
 File* Filesystem::open( const FilePath& fileName, const std::ios_base::openmode mode ) const
 {
+   // archived files can only be read
+   if ( ( mode & std::ios_base::out ) != std::ios_base::out )
+   {
+      for ( Archives::const_reverse_iterator it = m_archives.rbegin(); it != m_archives.rend(); ++it )
+      {
+         std::size_t size = 0;
+         const byte* data = ( *it )->find( fileName, size );
+         if ( data )
+         {
+            return new File( *this, fileName, data, size );
+         }
+      }
+   }
+
    File* file = new File( *this, fileName, mode );
    if ( !file->isOpened() )
    {
@@ -140,6 +191,31 @@ File* Filesystem::open( const FilePath& fileName, const std::ios_base::openmode
 
 ///////////////////////////////////////////////////////////////////////////////
 
+MappedFile* Filesystem::map( const FilePath& fileName ) const
+{
+   for ( Archives::const_reverse_iterator it = m_archives.rbegin(); it != m_archives.rend(); ++it )
+   {
+      std::size_t size = 0;
+      const byte* data = ( *it )->find( fileName, size );
+      if ( data )
+      {
+         // empty files can't be mapped
+         return size > 0 ? new MappedFile( fileName, data, size ) : NULL;
+      }
+   }
+
+   MappedFile* file = new MappedFile( *this, fileName );
+   if ( !file->isMapped() )
+   {
+      delete file;
+      file = NULL;
+   }
+
+   return file;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void Filesystem::onFileEditionCompleted( const FilePath& fileName ) const
 {
    notifyFileEditedChange( fileName );
@@ -210,6 +286,33 @@ bool Filesystem::remove( const FilePath& path ) const
 
 ///////////////////////////////////////////////////////////////////////////////
 
+bool Filesystem::mount( const FilePath& archivePath )
+{
+   FilesystemArchive* archive = new FilesystemArchive( *this, archivePath );
+   if ( !archive->isValid() )
+   {
+      delete archive;
+      return false;
+   }
+
+   m_archives.push_back( archive );
+   return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void Filesystem::unmountArchives()
+{
+   uint count = m_archives.size();
+   for ( uint i = 0; i < count; ++i )
+   {
+      delete m_archives[i];
+   }
+   m_archives.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 std::string Filesystem::toRelativePath(const std::string& absoluteFilePath ) const
 {
    // tokenize both the filename and the root dir
@@ -365,35 +468,42 @@ void Filesystem::scan( const FilePath& rootDir, FilesystemScanner& scanner, bool
       std::string currPath = pathsStack.back();
       pathsStack.pop_back();
 
-      WIN32_FIND_DATA findFileData;
-      HANDLE hFind;
-      bool result = true;
-      for ( hFind = FindFirstFile( ( currPath + "*" ).c_str(), &findFileData ); hFind != INVALID_HANDLE_VALUE && result; result = FindNextFile( hFind, &findFileData ) )
+      const FilesystemIndex::Directory* directory = m_index->getDirectory( currPath );
+      if ( !directory )
+      {
+         continue;
+      }
+
+      // the scanner may modify the filesystem, and with it the index - so work on a copy of the entries
+      std::vector< FilesystemIndex::Entry > entries( directory->m_entries );
+      uint entriesCount = entries.size();
+      for ( uint i = 0; i < entriesCount; ++i )
       {
-         std::string name = findFileData.cFileName;
-         if ( ( findFileData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY ) == FILE_ATTRIBUTE_DIRECTORY )
+         const FilesystemIndex::Entry& entry = entries[i];
+         if ( entry.m_isDir )
          {
             // we found a directory
-            if ( name != "." && name != ".." )
+            std::string dirName = currPath + entry.m_name + "/";
+            scanner.onDirectory( FilePath( toRelativePath( dirName ) ) );
+
+            if ( recursive )
             {
-               std::string dirName = currPath + name + "/";
-               scanner.onDirectory( FilePath( toRelativePath( dirName ) ) );
-
-               if ( recursive )
-               {
-                  // this is a recursive search, so add the found directory to the search tree
-                  pathsStack.push_back( dirName );
-               }
+               // this is a recursive search, so add the found directory to the search tree
+               pathsStack.push_back( dirName );
             }
          }
          else
          {
             // we found a file
-            scanner.onFile( FilePath( toRelativePath( currPath + name ) ) );
+            scanner.onFile( FilePath( toRelativePath( currPath + entry.m_name ) ) );
          }
       }
+   }
 
-      FindClose( hFind );
+   // scan the mounted archives
+   for ( Archives::const_iterator it = m_archives.begin(); it != m_archives.end(); ++it )
+   {
+      ( *it )->scan( rootDir, scanner, recursive );
    }
 }
 
@@ -0,0 +1,370 @@
+#include "core.h"
+#include "core\FilesystemArchive.h"
+#include "core\Filesystem.h"
+#include "core\FilePath.h"
+#include "core\File.h"
+#include "core\MappedFile.h"
+#include <algorithm>
+#include <set>
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+#define ARCHIVE_MAGIC_NO            0x4b415054  // 'TPAK'
+#define ARCHIVE_VERSION             1
+#define ARCHIVE_DATA_ALIGNMENT      16
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace // anonymous
+{
+   struct ArchivedFile
+   {
+      FilePath       m_path;
+      uint           m_pathOffset;
+
+      ArchivedFile( const FilePath& path ) : m_path( path ), m_pathOffset( 0 ) {}
+
+      bool operator<( const ArchivedFile& rhs ) const
+      {
+         if ( m_path.getHash() != rhs.m_path.getHash() )
+         {
+            return m_path.getHash() < rhs.m_path.getHash();
+         }
+         return m_path.getRelativePath() < rhs.m_path.getRelativePath();
+      }
+   };
+
+   // -------------------------------------------------------------------------
+
+   struct ArchivedFileDataOrder
+   {
+      const std::vector< ArchivedFile >&     m_files;
+
+      ArchivedFileDataOrder( const std::vector< ArchivedFile >& files ) : m_files( files ) {}
+
+      bool operator()( uint lhsIdx, uint rhsIdx ) const
+      {
+         return m_files[lhsIdx].m_path.getRelativePath() < m_files[rhsIdx].m_path.getRelativePath();
+      }
+   };
+
+   // -------------------------------------------------------------------------
+
+   uint alignOffset( uint offset )
+   {
+      return ( offset + ARCHIVE_DATA_ALIGNMENT - 1 ) & ~( ARCHIVE_DATA_ALIGNMENT - 1 );
+   }
+
+   // -------------------------------------------------------------------------
+
+   /**
+    * Makes sure the directory path ends with a slash.
+    */
+   std::string getDirPrefix( const FilePath& dir )
+   {
+      std::string prefix = dir.getRelativePath();
+      if ( prefix.empty() || prefix[ prefix.length() - 1 ] != '/' )
+      {
+         prefix += "/";
+      }
+      return prefix;
+   }
+
+} // anonymous
+
+///////////////////////////////////////////////////////////////////////////////
+
+FilesystemArchive::FilesystemArchive( const Filesystem& filesystem, const FilePath& archivePath )
+   : m_archiveFile( NULL )
+   , m_header( NULL )
+   , m_entries( NULL )
+   , m_paths( NULL )
+{
+   m_archiveFile = filesystem.map( archivePath );
+   if ( !m_archiveFile )
+   {
+      return;
+   }
+
+   const byte* data = m_archiveFile->getData();
+   std::size_t size = m_archiveFile->size();
+
+   const Header* header = ( const Header* )data;
+   bool isValid = size >= sizeof( Header ) && header->m_magicNo == ARCHIVE_MAGIC_NO && header->m_version == ARCHIVE_VERSION && header->m_pathsOffset <= size;
+
+   // the entries table needs to fit in the file ( the count is checked first, so that the size of the table can't overflow )
+   isValid = isValid && header->m_entriesCount <= ( size - sizeof( Header ) ) / sizeof( Entry );
+
+   // and so do the paths and the contents of the entries
+   const Entry* entries = ( const Entry* )( data + sizeof( Header ) );
+   for ( uint i = 0; isValid && i < header->m_entriesCount; ++i )
+   {
+      const Entry& entry = entries[i];
+      isValid = entry.m_pathOffset < size - header->m_pathsOffset && entry.m_dataOffset <= size && entry.m_dataSize <= size - entry.m_dataOffset;
+   }
+
+   if ( !isValid )
+   {
+      ASSERT_MSG( false, "The file is not a valid archive" );
+      delete m_archiveFile;
+      m_archiveFile = NULL;
+      return;
+   }
+
+   m_header = header;
+   m_entries = entries;
+   m_paths = ( const char* )( data + header->m_pathsOffset );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+FilesystemArchive::~FilesystemArchive()
+{
+   m_header = NULL;
+   m_entries = NULL;
+   m_paths = NULL;
+
+   delete m_archiveFile;
+   m_archiveFile = NULL;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+const FilesystemArchive::Entry* FilesystemArchive::findEntry( const FilePath& path ) const
+{
+   if ( !m_header )
+   {
+      return NULL;
+   }
+
+   // find the first entry with a matching hash
+   const uint hash = path.getHash();
+   uint first = 0;
+   uint last = m_header->m_entriesCount;
+   while( first < last )
+   {
+      uint mid = ( first + last ) / 2;
+      if ( m_entries[mid].m_pathHash < hash )
+      {
+         first = mid + 1;
+      }
+      else
+      {
+         last = mid;
+      }
+   }
+
+   // and compare the paths, in case several of them share the hash
+   const char* pathStr = path.c_str();
+   for ( uint i = first; i < m_header->m_entriesCount && m_entries[i].m_pathHash == hash; ++i )
+   {
+      if ( strcmp( m_paths + m_entries[i].m_pathOffset, pathStr ) == 0 )
+      {
+         return &m_entries[i];
+      }
+   }
+
+   return NULL;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool FilesystemArchive::doesExist( const FilePath& path ) const
+{
+   return findEntry( path ) != NULL;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool FilesystemArchive::isDir( const FilePath& path ) const
+{
+   if ( !m_header )
+   {
+      return false;
+   }
+
+   std::string prefix = getDirPrefix( path );
+   uint count = m_header->m_entriesCount;
+   for ( uint i = 0; i < count; ++i )
+   {
+      if ( strncmp( m_paths + m_entries[i].m_pathOffset, prefix.c_str(), prefix.length() ) == 0 )
+      {
+         return true;
+      }
+   }
+
+   return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+const byte* FilesystemArchive::find( const FilePath& path, std::size_t& outSize ) const
+{
+   const Entry* entry = findEntry( path );
+   if ( !entry )
+   {
+      outSize = 0;
+      return NULL;
+   }
+
+   outSize = entry->m_dataSize;
+   return m_archiveFile->getData() + entry->m_dataOffset;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void FilesystemArchive::scan( const FilePath& rootDir, FilesystemScanner& scanner, bool recursive ) const
+{
+   if ( !m_header )
+   {
+      return;
+   }
+
+   std::string prefix = getDirPrefix( rootDir );
+   std::set< std::string > reportedDirs;
+
+   uint count = m_header->m_entriesCount;
+   for ( uint i = 0; i < count; ++i )
+   {
+      const char* path = m_paths + m_entries[i].m_pathOffset;
+      if ( strncmp( path, prefix.c_str(), prefix.length() ) != 0 )
+      {
+         // the file is located outside of the scanned directory
+         continue;
+      }
+
+      // report the directories between the scanned one and the file
+      std::string pathStr( path );
+      std::size_t slashPos = pathStr.find( '/', prefix.length() );
+      bool isInSubdirectory = ( slashPos != std::string::npos );
+      while( slashPos != std::string::npos )
+      {
+         std::string dirName = pathStr.substr( 0, slashPos + 1 );
+         if ( reportedDirs.insert( dirName ).second )
+         {
+            scanner.onDirectory( FilePath( dirName ) );
+         }
+
+         if ( !recursive )
+         {
+            break;
+         }
+         slashPos = pathStr.find( '/', slashPos + 1 );
+      }
+
+      if ( recursive || !isInSubdirectory )
+      {
+         scanner.onFile( FilePath( pathStr ) );
+      }
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool FilesystemArchive::build( const Filesystem& sourceFilesystem, const std::vector< FilePath >& files, const Filesystem& targetFilesystem, const FilePath& archivePath )
+{
+   // sort the files the way they're going to be looked up
+   std::vector< ArchivedFile > archivedFiles;
+   uint filesCount = files.size();
+   archivedFiles.reserve( filesCount );
+   for ( uint i = 0; i < filesCount; ++i )
+   {
+      archivedFiles.push_back( ArchivedFile( files[i] ) );
+   }
+   std::sort( archivedFiles.begin(), archivedFiles.end() );
+
+   // lay out the paths
+   uint pathsSize = 0;
+   for ( uint i = 0; i < filesCount; ++i )
+   {
+      archivedFiles[i].m_pathOffset = pathsSize;
+      pathsSize += archivedFiles[i].m_path.getRelativePath().length() + 1;
+   }
+
+   File* archiveFile = targetFilesystem.open( archivePath, std::ios_base::out | std::ios_base::binary );
+   if ( !archiveFile )
+   {
+      return false;
+   }
+
+   Header header;
+   header.m_magicNo = ARCHIVE_MAGIC_NO;
+   header.m_version = ARCHIVE_VERSION;
+   header.m_entriesCount = filesCount;
+   header.m_pathsOffset = sizeof( Header ) + filesCount * sizeof( Entry );
+   uint dataOffset = alignOffset( header.m_pathsOffset + pathsSize );
+
+   // the contents of the files are laid out in the order of their paths ( unlike the table of contents ),
+   // so that the files located in the same directory can be read in one go
+   std::vector< uint > dataOrder( filesCount );
+   for ( uint i = 0; i < filesCount; ++i )
+   {
+      dataOrder[i] = i;
+   }
+   std::sort( dataOrder.begin(), dataOrder.end(), ArchivedFileDataOrder( archivedFiles ) );
+
+   // write the contents of the files first, then go back and write the table of contents
+   bool result = true;
+   std::vector< Entry > entries( filesCount );
+   archiveFile->seek( dataOffset );
+   for ( uint j = 0; j < filesCount && result; ++j )
+   {
+      uint i = dataOrder[j];
+      const ArchivedFile& archivedFile = archivedFiles[i];
+
+      Entry& entry = entries[i];
+      entry.m_pathHash = archivedFile.m_path.getHash();
+      entry.m_pathOffset = archivedFile.m_pathOffset;
+      entry.m_dataOffset = dataOffset;
+      entry.m_dataSize = 0;
+
+      if ( !sourceFilesystem.doesExist( archivedFile.m_path ) )
+      {
+         result = false;
+         break;
+      }
+
+      // empty files can't be mapped, but that's fine - they don't occupy any space in the archive anyway
+      MappedFile* sourceFile = sourceFilesystem.map( archivedFile.m_path );
+      if ( sourceFile )
+      {
+         entry.m_dataSize = sourceFile->size();
+         result = archiveFile->write( ( byte* )sourceFile->getData(), entry.m_dataSize ) == entry.m_dataSize;
+         delete sourceFile;
+      }
+
+      // pad the data
+      uint nextDataOffset = alignOffset( dataOffset + entry.m_dataSize );
+      byte padding[ARCHIVE_DATA_ALIGNMENT] = { 0 };
+      archiveFile->write( padding, nextDataOffset - dataOffset - entry.m_dataSize );
+      dataOffset = nextDataOffset;
+   }
+
+   if ( result )
+   {
+      archiveFile->seek( 0 );
+      archiveFile->write( ( byte* )&header, sizeof( Header ) );
+      if ( filesCount > 0 )
+      {
+         archiveFile->write( ( byte* )&entries[0], filesCount * sizeof( Entry ) );
+      }
+
+      for ( uint i = 0; i < filesCount; ++i )
+      {
+         const std::string& path = archivedFiles[i].m_path.getRelativePath();
+         archiveFile->write( ( byte* )path.c_str(), path.length() + 1 );
+      }
+   }
+
+   delete archiveFile;
+
+   if ( !result )
+   {
+      targetFilesystem.remove( archivePath );
+   }
+
+   return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,196 @@
+#include "core.h"
+#include "core\FilesystemIndex.h"
+#include "core\FilePath.h"
+#include <windows.h>
+#include <algorithm>
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace // anonymous
+{
+   /**
+    * Brings the directory path to the form used as the index key - forward slashes
+    * only, no repeated slashes, and a single slash at the end.
+    */
+   std::string normalizeDirPath( const std::string& dirPath )
+   {
+      std::string normalizedPath = dirPath;
+      std::replace( normalizedPath.begin(), normalizedPath.end(), '\\', '/' );
+
+      std::size_t doubleSlashPos = normalizedPath.find( "//" );
+      while( doubleSlashPos != std::string::npos )
+      {
+         normalizedPath.erase( doubleSlashPos, 1 );
+         doubleSlashPos = normalizedPath.find( "//", doubleSlashPos );
+      }
+
+      std::size_t lastCharPos = normalizedPath.find_last_not_of( '/' );
+      if ( lastCharPos == std::string::npos )
+      {
+         return "/";
+      }
+      normalizedPath.erase( lastCharPos + 1 );
+      normalizedPath += "/";
+
+      return normalizedPath;
+   }
+
+} // anonymous
+
+///////////////////////////////////////////////////////////////////////////////
+
+FilesystemIndex::FilesystemIndex( const Filesystem& filesystem )
+   : m_filesystem( filesystem )
+   , m_enumeratedDirsCount( 0 )
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+FilesystemIndex::~FilesystemIndex()
+{
+   clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void FilesystemIndex::clear()
+{
+   for ( Directories::iterator it = m_directories.begin(); it != m_directories.end(); ++it )
+   {
+      delete it->second;
+   }
+   m_directories.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+const FilesystemIndex::Directory* FilesystemIndex::getDirectory( const std::string& absoluteDirPath )
+{
+   std::string dirPath = normalizeDirPath( absoluteDirPath );
+
+   // the directory timestamp changes whenever an entry is added to it or removed from it
+   std::string dirPathWithoutSlash = dirPath.substr( 0, dirPath.length() - 1 );
+   WIN32_FILE_ATTRIBUTE_DATA attributes;
+   BOOL dirExists = GetFileAttributesExA( dirPathWithoutSlash.c_str(), GetFileExInfoStandard, &attributes );
+   dirExists = dirExists && ( attributes.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY ) == FILE_ATTRIBUTE_DIRECTORY;
+
+   Directories::iterator it = m_directories.find( dirPath );
+   if ( !dirExists )
+   {
+      if ( it != m_directories.end() )
+      {
+         delete it->second;
+         m_directories.erase( it );
+      }
+      return NULL;
+   }
+
+   unsigned __int64 lastWriteTime = ( (unsigned __int64)attributes.ftLastWriteTime.dwHighDateTime << 32 ) | attributes.ftLastWriteTime.dwLowDateTime;
+
+   Directory* directory = NULL;
+   if ( it != m_directories.end() )
+   {
+      directory = it->second;
+      if ( directory->m_isUpToDate && directory->m_lastWriteTime == lastWriteTime )
+      {
+         // nothing changed since the last time we looked
+         return directory;
+      }
+   }
+   else
+   {
+      directory = new Directory();
+      m_directories.insert( std::make_pair( dirPath, directory ) );
+   }
+
+   // enumerate the directory contents
+   directory->m_entries.clear();
+   directory->m_lastWriteTime = lastWriteTime;
+   directory->m_isUpToDate = true;
+   ++m_enumeratedDirsCount;
+
+   WIN32_FIND_DATA findFileData;
+   HANDLE hFind;
+   bool result = true;
+   for ( hFind = FindFirstFile( ( dirPath + "*" ).c_str(), &findFileData ); hFind != INVALID_HANDLE_VALUE && result; result = FindNextFile( hFind, &findFileData ) )
+   {
+      std::string name = findFileData.cFileName;
+      bool isDir = ( findFileData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY ) == FILE_ATTRIBUTE_DIRECTORY;
+      if ( isDir && ( name == "." || name == ".." ) )
+      {
+         continue;
+      }
+
+      directory->m_entries.push_back( Entry( name, isDir ) );
+   }
+   FindClose( hFind );
+
+   return directory;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void FilesystemIndex::invalidateParentDir( const FilePath& path )
+{
+   FilePath parentDir;
+   path.extractDir( parentDir );
+
+   Directories::iterator it = m_directories.find( normalizeDirPath( parentDir.toAbsolutePath( m_filesystem ) ) );
+   if ( it != m_directories.end() )
+   {
+      it->second->m_isUpToDate = false;
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void FilesystemIndex::onFileEdited( const FilePath& path )
+{
+   // the file might have just been created
+   invalidateParentDir( path );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void FilesystemIndex::onFileRemoved( const FilePath& path )
+{
+   invalidateParentDir( path );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void FilesystemIndex::onDirAdded( const FilePath& dir )
+{
+   Directories::iterator it = m_directories.find( normalizeDirPath( dir.toAbsolutePath( m_filesystem ) ) );
+   if ( it != m_directories.end() )
+   {
+      it->second->m_isUpToDate = false;
+   }
+   invalidateParentDir( dir );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void FilesystemIndex::onDirRemoved( const FilePath& dir )
+{
+   // drop the whole removed subtree
+   std::string removedDirPath = normalizeDirPath( dir.toAbsolutePath( m_filesystem ) );
+   for ( Directories::iterator it = m_directories.begin(); it != m_directories.end(); )
+   {
+      if ( it->first.compare( 0, removedDirPath.length(), removedDirPath ) == 0 )
+      {
+         delete it->second;
+         it = m_directories.erase( it );
+      }
+      else
+      {
+         ++it;
+      }
+   }
+
+   invalidateParentDir( dir );
+}
+
+///////////////////////////////////////////////////////////////////////////////
@@ -1,6 +1,7 @@
 #include "core.h"
 #include "core\IDString.h"
 #include "stdio.h"
+#include <windows.h>
 
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -72,21 +73,28 @@ IDStringsPool* IDStringsPool::s_theInstance = new IDStringsPool();
 ///////////////////////////////////////////////////////////////////////////////
 
 IDStringsPool::IDStringsPool()
-   : m_strings( 1024 )
+   : m_stringsCount( 0 )
 {
+   memset( m_pages, 0, sizeof( m_pages ) );
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
 IDStringsPool::~IDStringsPool()
 {
-   uint count = m_strings.size();
+   uint count = m_stringsCount;
    for ( uint i = 0; i < count; ++i )
    {
-      char* str = m_strings[i];
+      char* str = m_pages[i / STRINGS_PER_PAGE][i % STRINGS_PER_PAGE];
       delete [] str;
    }
-   m_strings.clear();
+
+   for ( uint i = 0; i < MAX_PAGES; ++i )
+   {
+      delete [] m_pages[i];
+      m_pages[i] = NULL;
+   }
+   m_stringsCount = 0;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -101,11 +109,13 @@ void IDStringsPool::deinitialize()
 
 uint IDStringsPool::registerString( const char* str )
 {
+   CriticalSectionLock lock( m_registrationLock );
+
    // check if the string is already registered
-   uint count = m_strings.size();
+   uint count = m_stringsCount;
    for ( uint i = 0; i < count; ++i )
    {
-      if ( strcmp( m_strings[i], str ) == 0 )
+      if ( strcmp( m_pages[i / STRINGS_PER_PAGE][i % STRINGS_PER_PAGE], str ) == 0 )
       {
          // found it
          return i;
@@ -117,8 +127,20 @@ uint IDStringsPool::registerString( const char* str )
    char* strCopy = new char[strLength];
    strcpy_s( strCopy, strLength, str );
 
-   uint stringId = m_strings.size();
-   m_strings.push_back( strCopy );
+   uint stringId = count;
+   uint pageIdx = stringId / STRINGS_PER_PAGE;
+   ASSERT_MSG( pageIdx < MAX_PAGES, "IDStringsPool overflow" );
+
+   char**& page = m_pages[pageIdx];
+   if ( !page )
+   {
+      page = new char*[STRINGS_PER_PAGE];
+   }
+   page[stringId % STRINGS_PER_PAGE] = strCopy;
+
+   // publish the entry only once it's in place - the interlocked operation is a full memory barrier,
+   // so whoever gets the id from us sees the string as well
+   InterlockedExchange( &m_stringsCount, count + 1 );
 
    return stringId;
 }
@@ -127,7 +149,9 @@ uint IDStringsPool::registerString( const char* str )
 
 const char* IDStringsPool::getString( uint stringId ) const
 {
-   return m_strings[stringId];
+   // the pages never move and the published entries never change, so there's no need to lock anything here
+   ASSERT_MSG( stringId < (uint)m_stringsCount, "Unregistered string id" );
+   return m_pages[stringId / STRINGS_PER_PAGE][stringId % STRINGS_PER_PAGE];
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,106 @@
+#include "core.h"
+#include "core\InCompressedStream.h"
+#include "core\LZCompressor.h"
+#include "core\Assert.h"
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+InCompressedStream::InCompressedStream( InStream& stream )
+   : m_stream( stream )
+   , m_blockDataSize( 0 )
+   , m_readPos( 0 )
+   , m_isFinished( false )
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void InCompressedStream::finish()
+{
+   while ( readBlock() ) {}
+   m_readPos = m_blockDataSize;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void InCompressedStream::load( void* val, unsigned int dataSize )
+{
+   byte* outData = (byte*)val;
+   while ( dataSize > 0 )
+   {
+      if ( m_readPos == m_blockDataSize && !readBlock() )
+      {
+         // end of the compressed data
+         return;
+      }
+
+      uint chunkSize = m_blockDataSize - m_readPos;
+      if ( chunkSize > dataSize )
+      {
+         chunkSize = dataSize;
+      }
+
+      memcpy( outData, (byte*)m_block + m_readPos, chunkSize );
+      m_readPos += chunkSize;
+      outData += chunkSize;
+      dataSize -= chunkSize;
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool InCompressedStream::readBlock()
+{
+   if ( m_isFinished )
+   {
+      return false;
+   }
+
+   uint dataSize = 0;
+   m_stream >> dataSize;
+   if ( dataSize == 0 )
+   {
+      // we've reached the end of the compressed data
+      m_isFinished = true;
+      return false;
+   }
+
+   uint storedSize = 0;
+   m_stream >> storedSize;
+
+   if ( dataSize > m_block.size() )
+   {
+      m_block.resizeWithoutInitializing( dataSize );
+   }
+
+   if ( storedSize == dataSize )
+   {
+      // the block was stored uncompressed
+      m_stream.load( (byte*)m_block, dataSize );
+   }
+   else
+   {
+      if ( storedSize > m_compressedBlock.size() )
+      {
+         m_compressedBlock.resizeWithoutInitializing( storedSize );
+      }
+      m_stream.load( (byte*)m_compressedBlock, storedSize );
+
+      bool result = LZCompressor::decompress( (byte*)m_compressedBlock, storedSize, (byte*)m_block, dataSize );
+      if ( !result )
+      {
+         ASSERT_MSG( false, "Corrupt compressed data" );
+         m_isFinished = true;
+         m_blockDataSize = 0;
+         m_readPos = 0;
+         return false;
+      }
+   }
+
+   m_blockDataSize = dataSize;
+   m_readPos = 0;
+   return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
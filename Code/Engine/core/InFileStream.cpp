@@ -6,13 +6,23 @@
 
 ///////////////////////////////////////////////////////////////////////////////
 
-InFileStream::InFileStream( File* archive )
+InFileStream::InFileStream( File* archive, uint bufferSize )
    : m_archive( archive )
+   , m_buffer( NULL )
+   , m_bufferSize( bufferSize )
+   , m_readPos( 0 )
+   , m_dataEnd( 0 )
+   , m_fileReadsCount( 0 )
 {
    if ( m_archive == NULL )
    {
       ASSERT_MSG( false, "NULL pointer instead a File instance");
    }
+
+   if ( m_bufferSize > 0 )
+   {
+      m_buffer = new byte[ m_bufferSize ];
+   }
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -21,13 +31,51 @@ InFileStream::~InFileStream()
 {
    delete m_archive;
    m_archive = NULL;
+
+   delete [] m_buffer;
+   m_buffer = NULL;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
 void InFileStream::load( void* val, unsigned int dataSize )
 {
-   m_archive->read( (byte*)val, dataSize );
+   byte* outData = (byte*)val;
+
+   while ( dataSize > 0 )
+   {
+      uint bufferedBytes = m_dataEnd - m_readPos;
+      if ( bufferedBytes > 0 )
+      {
+         // serve as much as we can from the buffer
+         uint bytesToCopy = dataSize < bufferedBytes ? dataSize : bufferedBytes;
+         memcpy( outData, m_buffer + m_readPos, bytesToCopy );
+
+         m_readPos += bytesToCopy;
+         outData += bytesToCopy;
+         dataSize -= bytesToCopy;
+         continue;
+      }
+
+      if ( dataSize >= m_bufferSize )
+      {
+         // the buffer is drained and the request wouldn't fit in it anyway - 
+         // there's no point in copying the data twice
+         m_archive->read( outData, dataSize );
+         ++m_fileReadsCount;
+         break;
+      }
+
+      // refill the buffer
+      m_readPos = 0;
+      m_dataEnd = m_archive->read( m_buffer, m_bufferSize );
+      ++m_fileReadsCount;
+      if ( m_dataEnd == 0 )
+      {
+         // we've reached the end of the file
+         break;
+      }
+   }
 }
 
 ///////////////////////////////////////////////////////////////////////////////
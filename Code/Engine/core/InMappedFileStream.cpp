@@ -0,0 +1,64 @@
+#include "core.h"
+#include "core\InMappedFileStream.h"
+#include "core\MappedFile.h"
+#include "core\Assert.h"
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+InMappedFileStream::InMappedFileStream( MappedFile* file )
+   : m_file( file )
+   , m_readPos( 0 )
+{
+   if ( m_file == NULL )
+   {
+      ASSERT_MSG( false, "NULL pointer instead a MappedFile instance" );
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+InMappedFileStream::~InMappedFileStream()
+{
+   delete m_file;
+   m_file = NULL;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+const byte* InMappedFileStream::getCurrentData() const
+{
+   return m_file->getData() + m_readPos;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+uint InMappedFileStream::getRemainingSize() const
+{
+   return m_file->size() - m_readPos;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void InMappedFileStream::load( void* val, unsigned int dataSize )
+{
+   uint remainingSize = getRemainingSize();
+   if ( dataSize > remainingSize )
+   {
+      // just like a regular file, read as much as there's left
+      dataSize = remainingSize;
+   }
+
+   memcpy( val, m_file->getData() + m_readPos, dataSize );
+   m_readPos += dataSize;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void InMappedFileStream::skip( uint sizeInBytes )
+{
+   uint remainingSize = getRemainingSize();
+   m_readPos += sizeInBytes < remainingSize ? sizeInBytes : remainingSize;
+}
+
+///////////////////////////////////////////////////////////////////////////////
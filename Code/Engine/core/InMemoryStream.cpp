@@ -0,0 +1,36 @@
+#include "core.h"
+#include "core\InMemoryStream.h"
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+InMemoryStream::InMemoryStream( const byte* data, uint size )
+   : m_data( data )
+   , m_size( size )
+   , m_readPos( 0 )
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void InMemoryStream::load( void* val, unsigned int dataSize )
+{
+   if ( m_readPos + dataSize > m_size )
+   {
+      // end of buffer
+      return;
+   }
+
+   memcpy( val, m_data + m_readPos, dataSize );
+   m_readPos += dataSize;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void InMemoryStream::skip( uint sizeInBytes )
+{
+   uint remainingSize = m_size - m_readPos;
+   m_readPos += sizeInBytes < remainingSize ? sizeInBytes : remainingSize;
+}
+
+///////////////////////////////////////////////////////////////////////////////
@@ -1,12 +1,23 @@
 #include "core.h"
 #include "core/InStream.h"
 #include "core/Array.h"
+#include "core/IDString.h"
+#include "core/ReflectionStringTable.h"
 
 
 ///////////////////////////////////////////////////////////////////////////////
 
 InStream& InStream::operator>>( std::string& val )
 {
+   if ( m_stringTable )
+   {
+      // the stream contains an index of the string in the table
+      uint idx;
+      load( (void*)&idx, sizeof( uint ) );
+      val = m_stringTable->getString( idx );
+      return *this;
+   }
+
    // load the length of the string
    uint len;
    load( (void*)&len, sizeof( uint ) );
@@ -23,6 +34,27 @@ InStream& InStream::operator>>( std::string& val )
 
 ///////////////////////////////////////////////////////////////////////////////
 
+InStream& InStream::operator>>( IDString& val )
+{
+   if ( m_stringTable )
+   {
+      // the table registers every string with the pool only once
+      uint idx;
+      load( (void*)&idx, sizeof( uint ) );
+      val = IDString( m_stringTable->getStringId( idx ) );
+   }
+   else
+   {
+      std::string str;
+      *this >> str;
+      val = IDString( str );
+   }
+
+   return *this;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void InStream::skip( uint sizeInBytes )
 {
    Array< byte > skipBuf( sizeInBytes ); 
@@ -0,0 +1,232 @@
+#include "core.h"
+#include "core/LZCompressor.h"
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace // anonymous
+{
+   const uint MIN_MATCH_LENGTH = 4;
+   const uint MAX_OFFSET = 65535;
+   const uint HASH_BITS = 14;
+   const uint HASH_TABLE_SIZE = 1 << HASH_BITS;
+
+   // -------------------------------------------------------------------------
+
+   inline uint read32( const byte* ptr )
+   {
+      uint val;
+      memcpy( &val, ptr, sizeof( uint ) );
+      return val;
+   }
+
+   // -------------------------------------------------------------------------
+
+   inline uint hash( uint sequence )
+   {
+      return ( sequence * 2654435761U ) >> ( 32 - HASH_BITS );
+   }
+
+   // -------------------------------------------------------------------------
+
+   inline byte* writeLength( byte* outPtr, uint length )
+   {
+      // the first 15 units of the length are stored in the token, the rest in the subsequent bytes
+      length -= 15;
+      while ( length >= 255 )
+      {
+         *outPtr++ = 255;
+         length -= 255;
+      }
+      *outPtr++ = (byte)length;
+      return outPtr;
+   }
+
+   // -------------------------------------------------------------------------
+
+   inline bool readLength( const byte*& inPtr, const byte* inEnd, uint& length )
+   {
+      byte val;
+      do
+      {
+         if ( inPtr >= inEnd )
+         {
+            return false;
+         }
+         val = *inPtr++;
+         length += val;
+      } while ( val == 255 );
+
+      return true;
+   }
+
+   // -------------------------------------------------------------------------
+
+   byte* writeSequence( byte* outPtr, const byte* literals, uint literalsCount, uint matchOffset, uint matchLength )
+   {
+      byte* token = outPtr++;
+      uint encodedMatchLength = matchLength > 0 ? matchLength - MIN_MATCH_LENGTH : 0;
+
+      *token = (byte)( ( literalsCount < 15 ? literalsCount : 15 ) << 4 );
+      if ( literalsCount >= 15 )
+      {
+         outPtr = writeLength( outPtr, literalsCount );
+      }
+
+      memcpy( outPtr, literals, literalsCount );
+      outPtr += literalsCount;
+
+      if ( matchLength > 0 )
+      {
+         *outPtr++ = (byte)( matchOffset & 0xff );
+         *outPtr++ = (byte)( matchOffset >> 8 );
+
+         *token |= (byte)( encodedMatchLength < 15 ? encodedMatchLength : 15 );
+         if ( encodedMatchLength >= 15 )
+         {
+            outPtr = writeLength( outPtr, encodedMatchLength );
+         }
+      }
+
+      return outPtr;
+   }
+
+} // anonymous
+
+///////////////////////////////////////////////////////////////////////////////
+
+uint LZCompressor::getMaxCompressedSize( uint dataSize )
+{
+   // in the worst case the data is stored as a single run of literals
+   return dataSize + dataSize / 255 + 16;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+uint LZCompressor::compress( const byte* data, uint dataSize, byte* outCompressedData )
+{
+   byte* outPtr = outCompressedData;
+
+   const byte* literalsStart = data;
+   if ( dataSize >= MIN_MATCH_LENGTH )
+   {
+      // positions of the recently encountered sequences of bytes, relative to the beginning of the data
+      uint* hashTable = new uint[ HASH_TABLE_SIZE ];
+      memset( hashTable, 0xff, sizeof( uint ) * HASH_TABLE_SIZE );
+
+      const byte* dataEnd = data + dataSize;
+      const byte* matchLimit = dataEnd - MIN_MATCH_LENGTH;
+      const byte* inPtr = data;
+      while ( inPtr <= matchLimit )
+      {
+         uint sequence = read32( inPtr );
+         uint& hashEntry = hashTable[ hash( sequence ) ];
+         uint candidatePos = hashEntry;
+         uint currPos = inPtr - data;
+         hashEntry = currPos;
+
+         if ( candidatePos == (uint)-1 || currPos - candidatePos > MAX_OFFSET || read32( data + candidatePos ) != sequence )
+         {
+            ++inPtr;
+            continue;
+         }
+
+         // we found a match - see how far it goes
+         const byte* matchPtr = data + candidatePos;
+         uint matchLength = MIN_MATCH_LENGTH;
+         while ( inPtr + matchLength < dataEnd && inPtr[matchLength] == matchPtr[matchLength] )
+         {
+            ++matchLength;
+         }
+
+         outPtr = writeSequence( outPtr, literalsStart, inPtr - literalsStart, currPos - candidatePos, matchLength );
+         inPtr += matchLength;
+         literalsStart = inPtr;
+      }
+
+      delete [] hashTable;
+   }
+
+   // store the remaining literals
+   uint remainingLiterals = ( data + dataSize ) - literalsStart;
+   if ( remainingLiterals > 0 )
+   {
+      outPtr = writeSequence( outPtr, literalsStart, remainingLiterals, 0, 0 );
+   }
+
+   return outPtr - outCompressedData;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool LZCompressor::decompress( const byte* compressedData, uint compressedDataSize, byte* outData, uint dataSize )
+{
+   const byte* inPtr = compressedData;
+   const byte* inEnd = compressedData + compressedDataSize;
+   byte* outPtr = outData;
+   byte* outEnd = outData + dataSize;
+
+   while ( inPtr < inEnd )
+   {
+      byte token = *inPtr++;
+
+      // copy the literals
+      uint literalsCount = token >> 4;
+      if ( literalsCount == 15 && !readLength( inPtr, inEnd, literalsCount ) )
+      {
+         return false;
+      }
+      if ( literalsCount > (uint)( inEnd - inPtr ) || literalsCount > (uint)( outEnd - outPtr ) )
+      {
+         return false;
+      }
+      memcpy( outPtr, inPtr, literalsCount );
+      inPtr += literalsCount;
+      outPtr += literalsCount;
+
+      if ( inPtr >= inEnd )
+      {
+         // the last sequence contains literals only
+         break;
+      }
+
+      // copy the match
+      if ( inEnd - inPtr < 2 )
+      {
+         return false;
+      }
+      uint matchOffset = inPtr[0] | ( inPtr[1] << 8 );
+      inPtr += 2;
+
+      uint matchLength = token & 0xf;
+      if ( matchLength == 15 && !readLength( inPtr, inEnd, matchLength ) )
+      {
+         return false;
+      }
+      matchLength += MIN_MATCH_LENGTH;
+
+      if ( matchOffset == 0 || matchOffset > (uint)( outPtr - outData ) || matchLength > (uint)( outEnd - outPtr ) )
+      {
+         return false;
+      }
+
+      const byte* matchPtr = outPtr - matchOffset;
+      if ( matchOffset >= matchLength )
+      {
+         memcpy( outPtr, matchPtr, matchLength );
+         outPtr += matchLength;
+      }
+      else
+      {
+         // the match overlaps the data it's copying, so it needs to be copied byte by byte
+         for ( uint i = 0; i < matchLength; ++i )
+         {
+            *outPtr++ = *matchPtr++;
+         }
+      }
+   }
+
+   return outPtr == outEnd;
+}
+
+///////////////////////////////////////////////////////////////////////////////
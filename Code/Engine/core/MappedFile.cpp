@@ -0,0 +1,77 @@
+#include "core.h"
+#include "core\MappedFile.h"
+#include "core\Filesystem.h"
+#include <windows.h>
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+MappedFile::MappedFile( const Filesystem& hostFS, const FilePath& name )
+   : m_name( name )
+   , m_file( INVALID_HANDLE_VALUE )
+   , m_mapping( NULL )
+   , m_data( NULL )
+   , m_size( 0 )
+{
+   std::string absoluteName = m_name.toAbsolutePath( hostFS );
+
+   m_file = CreateFileA( absoluteName.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL );
+   if ( m_file == INVALID_HANDLE_VALUE )
+   {
+      return;
+   }
+
+   // empty files can't be mapped
+   LARGE_INTEGER fileSize;
+   if ( !GetFileSizeEx( m_file, &fileSize ) || fileSize.QuadPart == 0 )
+   {
+      return;
+   }
+
+   m_mapping = CreateFileMappingA( m_file, NULL, PAGE_READONLY, 0, 0, NULL );
+   if ( m_mapping == NULL )
+   {
+      return;
+   }
+
+   m_data = ( const byte* )MapViewOfFile( m_mapping, FILE_MAP_READ, 0, 0, 0 );
+   if ( m_data != NULL )
+   {
+      m_size = ( std::size_t )fileSize.QuadPart;
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+MappedFile::MappedFile( const FilePath& name, const byte* data, std::size_t size )
+   : m_name( name )
+   , m_file( INVALID_HANDLE_VALUE )
+   , m_mapping( NULL )
+   , m_data( data )
+   , m_size( size )
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+MappedFile::~MappedFile()
+{
+   // the views of the archived files don't own the mapping
+   if ( m_mapping )
+   {
+      UnmapViewOfFile( m_data );
+      CloseHandle( m_mapping );
+      m_mapping = NULL;
+   }
+   m_data = NULL;
+
+   if ( m_file != INVALID_HANDLE_VALUE )
+   {
+      CloseHandle( m_file );
+      m_file = INVALID_HANDLE_VALUE;
+   }
+
+   m_size = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
@@ -4,6 +4,7 @@
 #include "core\CallstackTracer.h"
 #include "core\dostream.h"
 #include <strstream>
+#include <windows.h>
 
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -17,6 +18,10 @@ MemoryRouter::MemoryRouter()
 #ifdef _TRACK_MEMORY_ALLOCATIONS
    m_tracer = new CallstackTracer();
    m_callstacksTree = new CallstackTree();
+
+   CRITICAL_SECTION* trackingLock = new CRITICAL_SECTION;
+   InitializeCriticalSection( trackingLock );
+   m_trackingLock = trackingLock;
 #endif
 }
 
@@ -30,6 +35,11 @@ MemoryRouter::~MemoryRouter()
 
    delete m_callstacksTree;
    m_callstacksTree = NULL;
+
+   CRITICAL_SECTION* trackingLock = static_cast< CRITICAL_SECTION* >( m_trackingLock );
+   DeleteCriticalSection( trackingLock );
+   delete trackingLock;
+   m_trackingLock = NULL;
 #endif
 }
 
@@ -39,7 +49,12 @@ MemoryRouter& MemoryRouter::getInstance()
 {
    if ( !s_theInstance )
    {
-      s_theInstance = new MemoryRouter();
+      // two threads may get here at the same time - only one of the instances gets published
+      MemoryRouter* router = new MemoryRouter();
+      if ( InterlockedCompareExchangePointer( (void* volatile*)&s_theInstance, router, NULL ) != NULL )
+      {
+         delete router;
+      }
    }
    return *s_theInstance;
 }
@@ -109,9 +124,14 @@ void* MemoryRouter::alloc( size_t size, AllocationMode allocMode, MemoryAllocato
 #ifdef _TRACK_MEMORY_ALLOCATIONS
    {
       // memorize the callstack
+      CRITICAL_SECTION* trackingLock = static_cast< CRITICAL_SECTION* >( m_trackingLock );
+      EnterCriticalSection( trackingLock );
+
       ulong callstack[64];
       uint callstackSize = m_tracer->getStackTrace( callstack, 64 );
       m_callstacksTree->insert( (uint)pa, callstack, callstackSize );
+
+      LeaveCriticalSection( trackingLock );
    }
 #endif
 
@@ -142,7 +162,10 @@ void MemoryRouter::dealloc( void* ptr, AllocationMode allocMode )
    {
 #ifdef _TRACK_MEMORY_ALLOCATIONS
       // remove the callstack
+      CRITICAL_SECTION* trackingLock = static_cast< CRITICAL_SECTION* >( m_trackingLock );
+      EnterCriticalSection( trackingLock );
       m_callstacksTree->remove( (uint)origPtr );
+      LeaveCriticalSection( trackingLock );
 #endif
 
       allocator->dealloc( origPtr );
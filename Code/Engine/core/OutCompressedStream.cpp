@@ -0,0 +1,102 @@
+#include "core.h"
+#include "core\OutCompressedStream.h"
+#include "core\LZCompressor.h"
+#include "core\Assert.h"
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+OutCompressedStream::OutCompressedStream( OutStream& stream, uint blockSize )
+   : m_stream( stream )
+   , m_blockSize( blockSize > 0 ? blockSize : DEFAULT_BLOCK_SIZE )
+   , m_writePos( 0 )
+   , m_isFinished( false )
+{
+   m_block.resizeWithoutInitializing( m_blockSize );
+   m_compressedBlock.resizeWithoutInitializing( LZCompressor::getMaxCompressedSize( m_blockSize ) );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+OutCompressedStream::~OutCompressedStream()
+{
+   finish();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void OutCompressedStream::flush()
+{
+   if ( m_writePos == 0 )
+   {
+      return;
+   }
+
+   uint compressedSize = LZCompressor::compress( (byte*)m_block, m_writePos, (byte*)m_compressedBlock );
+
+   m_stream << m_writePos;
+   if ( compressedSize < m_writePos )
+   {
+      m_stream << compressedSize;
+      m_stream.save( (byte*)m_compressedBlock, compressedSize );
+   }
+   else
+   {
+      // the data didn't compress well - store it as it is
+      m_stream << m_writePos;
+      m_stream.save( (byte*)m_block, m_writePos );
+   }
+
+   m_writePos = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void OutCompressedStream::finish()
+{
+   if ( m_isFinished )
+   {
+      return;
+   }
+
+   flush();
+
+   // an empty block marks the end of the compressed data
+   uint endMarker = 0;
+   m_stream << endMarker;
+
+   m_isFinished = true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void OutCompressedStream::save( const void* val, unsigned int dataSize )
+{
+   ASSERT_MSG( !m_isFinished, "Writing to a finished compressed stream" );
+   if ( m_isFinished )
+   {
+      return;
+   }
+
+   const byte* data = (const byte*)val;
+   while ( dataSize > 0 )
+   {
+      uint chunkSize = m_blockSize - m_writePos;
+      if ( chunkSize > dataSize )
+      {
+         chunkSize = dataSize;
+      }
+
+      memcpy( (byte*)m_block + m_writePos, data, chunkSize );
+      m_writePos += chunkSize;
+      data += chunkSize;
+      dataSize -= chunkSize;
+
+      if ( m_writePos == m_blockSize )
+      {
+         flush();
+      }
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
@@ -6,28 +6,66 @@
 
 ///////////////////////////////////////////////////////////////////////////////
 
-OutFileStream::OutFileStream( File* archive )
+OutFileStream::OutFileStream( File* archive, uint bufferSize )
    : m_archive( archive )
+   , m_buffer( NULL )
+   , m_bufferSize( bufferSize )
+   , m_writePos( 0 )
 {
    if ( m_archive == NULL )
    {
       ASSERT_MSG( false, "NULL pointer instead a File instance" );
    }
+
+   if ( m_bufferSize > 0 )
+   {
+      m_buffer = new byte[ m_bufferSize ];
+   }
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
 OutFileStream::~OutFileStream()
 {
+   flush();
+
    delete m_archive;
    m_archive = NULL;
+
+   delete [] m_buffer;
+   m_buffer = NULL;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void OutFileStream::flush()
+{
+   if ( m_writePos > 0 )
+   {
+      m_archive->write( m_buffer, m_writePos );
+      m_writePos = 0;
+   }
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
 void OutFileStream::save( const void* val, unsigned int dataSize )
 {
-   m_archive->write( (byte*)val, dataSize );
+   if ( m_writePos + dataSize > m_bufferSize )
+   {
+      // there's not enough room left in the buffer
+      flush();
+
+      if ( dataSize >= m_bufferSize )
+      {
+         // the data wouldn't fit in the buffer anyway - write it straight to the file
+         m_archive->write( (byte*)val, dataSize );
+         return;
+      }
+   }
+
+   memcpy( m_buffer + m_writePos, val, dataSize );
+   m_writePos += dataSize;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -1,12 +1,22 @@
 #include "core.h"
 #include "core/OutStream.h"
 #include "core/types.h"
+#include "core/IDString.h"
+#include "core/ReflectionStringTable.h"
 
 
 ///////////////////////////////////////////////////////////////////////////////
 
 OutStream& OutStream::operator<<( const std::string& val )
 {
+   if ( m_stringTable )
+   {
+      // save the index of the string in the table instead
+      uint idx = m_stringTable->add( val );
+      save( (void*)&idx, sizeof( uint ) );
+      return *this;
+   }
+
    // save the string length
    uint len = val.length();
    save( (void*)&len, sizeof( uint ) );
@@ -18,3 +28,10 @@ OutStream& OutStream::operator<<( const std::string& val )
 }
 
 ///////////////////////////////////////////////////////////////////////////////
+
+OutStream& OutStream::operator<<( const IDString& val )
+{
+   return *this << std::string( val.c_str() );
+}
+
+///////////////////////////////////////////////////////////////////////////////
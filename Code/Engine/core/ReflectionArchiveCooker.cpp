@@ -0,0 +1,164 @@
+#include "core.h"
+#include "core/ReflectionArchiveCooker.h"
+#include "core/InStream.h"
+#include "core/OutStream.h"
+#include "core/OutArrayStream.h"
+#include "core/ReflectionStringTable.h"
+#include "core/Array.h"
+#include "core/ReflectionObject.h"
+#include "core/ReflectionSerializationMacros.h"
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace // anonymous
+{
+   void appendData( Array< byte >& buffer, const void* data, uint dataSize )
+   {
+      uint prevBufSize = buffer.size();
+      buffer.resizeWithoutInitializing( prevBufSize + dataSize );
+      memcpy( (byte*)buffer + prevBufSize, data, dataSize );
+   }
+
+} // anonymous
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool ReflectionArchiveCooker::cook( InStream& archive, OutStream& outCookedArchive )
+{
+   // 1. check if it's indeed one of our archives. If the archive comes with a string table,
+   // the data refers to the strings by their indices in it, so the cooked archive needs to carry it as well
+   uint magicNo = 0;
+   archive >> magicNo;
+
+   ReflectionStringTable stringTable;
+   Array< byte > stringTableData;
+   bool hasStringTable = ( magicNo == TAMY_STRING_TABLE_MAGIC_NO );
+   if ( hasStringTable )
+   {
+      stringTable.load( archive );
+
+      OutArrayStream stringTableStream( stringTableData );
+      stringTable.save( stringTableStream );
+
+      archive >> magicNo;
+   }
+
+   if ( magicNo != TAMY_ARCHIVE_MAGIC_NO )
+   {
+      return false;
+   }
+
+   const ReflectionStringTable* prevStringTable = archive.getStringTable();
+   if ( hasStringTable )
+   {
+      archive.setStringTable( &stringTable );
+   }
+
+   Array< byte > tempDataBuf;
+
+   // 2. copy the external dependencies section, along with its skip size, so that
+   // the loader can parse it the same way it does in case of a regular archive
+   Array< byte > externalDependencies;
+   {
+      uint skipSize = 0;
+      archive >> skipSize;
+
+      tempDataBuf.resize( skipSize + 1 );
+      archive.load( (byte*)tempDataBuf, skipSize );
+
+      appendData( externalDependencies, &skipSize, sizeof( uint ) );
+      appendData( externalDependencies, (byte*)tempDataBuf, skipSize );
+   }
+
+   // 3. collect the serialized objects - we'll store their unique ids and data in two separate
+   // sections, so that the data can be skipped without touching the ids and vice versa
+   std::vector< CookedArchiveObject > objects;
+   Array< byte > uniqueIds;
+   Array< byte > objectsData;
+   {
+      uint objectsCount = 0;
+      archive >> objectsCount;
+      objects.resize( objectsCount );
+      for ( uint i = 0; i < objectsCount; ++i )
+      {
+         CookedArchiveObject& entry = objects[i];
+
+         ReflectionObject::UniqueId objId;
+         archive >> objId;
+
+         uint skipSize = 0;
+         archive >> skipSize;
+
+         entry.m_uniqueIdOffset = uniqueIds.size();
+         entry.m_uniqueIdLength = objId.length();
+         appendData( uniqueIds, objId.c_str(), entry.m_uniqueIdLength );
+
+         if ( skipSize > tempDataBuf.size() )
+         {
+            tempDataBuf.resize( skipSize + 1 );
+         }
+         archive.load( (byte*)tempDataBuf, skipSize );
+
+         entry.m_dataOffset = objectsData.size();
+         entry.m_dataSize = skipSize;
+         appendData( objectsData, (byte*)tempDataBuf, skipSize );
+      }
+   }
+
+   // 4. indices of the main objects
+   std::vector< uint > indices;
+   {
+      uint indicesCount = 0;
+      archive >> indicesCount;
+      indices.resize( indicesCount );
+      for ( uint i = 0; i < indicesCount; ++i )
+      {
+         archive >> indices[i];
+      }
+   }
+
+   // 5. lay the sections out - the tables go first, right after the header, so that they stay aligned
+   CookedArchiveHeader header;
+   header.m_objectsOffset = sizeof( CookedArchiveHeader );
+   header.m_objectsCount = objects.size();
+   header.m_indicesOffset = header.m_objectsOffset + header.m_objectsCount * sizeof( CookedArchiveObject );
+   header.m_indicesCount = indices.size();
+   header.m_externalDependenciesOffset = header.m_indicesOffset + header.m_indicesCount * sizeof( uint );
+   header.m_externalDependenciesSize = externalDependencies.size();
+   header.m_stringTableOffset = header.m_externalDependenciesOffset + header.m_externalDependenciesSize;
+   header.m_stringTableSize = stringTableData.size();
+
+   uint uniqueIdsOffset = header.m_stringTableOffset + header.m_stringTableSize;
+   uint objectsDataOffset = uniqueIdsOffset + uniqueIds.size();
+   uint archiveSize = objectsDataOffset + objectsData.size();
+
+   for ( uint i = 0; i < header.m_objectsCount; ++i )
+   {
+      objects[i].m_uniqueIdOffset += uniqueIdsOffset;
+      objects[i].m_dataOffset += objectsDataOffset;
+   }
+
+   // 6. write the cooked archive
+   outCookedArchive << (uint)TAMY_COOKED_ARCHIVE_MAGIC_NO;
+   outCookedArchive << archiveSize;
+   outCookedArchive.save( &header, sizeof( CookedArchiveHeader ) );
+   if ( header.m_objectsCount > 0 )
+   {
+      outCookedArchive.save( &objects[0], header.m_objectsCount * sizeof( CookedArchiveObject ) );
+   }
+   if ( header.m_indicesCount > 0 )
+   {
+      outCookedArchive.save( &indices[0], header.m_indicesCount * sizeof( uint ) );
+   }
+   outCookedArchive.save( (byte*)externalDependencies, externalDependencies.size() );
+   outCookedArchive.save( (byte*)stringTableData, stringTableData.size() );
+   outCookedArchive.save( (byte*)uniqueIds, uniqueIds.size() );
+   outCookedArchive.save( (byte*)objectsData, objectsData.size() );
+
+   archive.setStringTable( prevStringTable );
+
+   return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
@@ -1,16 +1,36 @@
 #include "core.h"
 #include "core/ReflectionEnum.h"
+#include "core/ReflectionTypesRegistry.h"
+#include "core/Thread.h"
 
 
 ///////////////////////////////////////////////////////////////////////////////
 
 ReflectionEnum::ReflectionEnum( const std::string& typeName )
    : ReflectionType( typeName )
+   , m_isDefined( false )
 {
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
+void ReflectionEnum::define() const
+{
+   if ( m_isDefined )
+   {
+      return;
+   }
+
+   CriticalSectionLock lock( *ReflectionTypesRegistry::getInstance().m_definitionsLock );
+   if ( !m_isDefined )
+   {
+      const_cast< ReflectionEnum* >( this )->registerEnumerators();
+      m_isDefined = true;
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 bool ReflectionEnum::isA( const ReflectionType& referenceType ) const
 {
    ReflectionTypeID< ReflectionEnum > id;
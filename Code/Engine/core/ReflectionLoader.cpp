@@ -2,17 +2,83 @@
 #include "core/ReflectionLoader.h"
 #include "core/InStream.h"
 #include "core/InArrayStream.h"
+#include "core/InMemoryStream.h"
+#include "core/InMappedFileStream.h"
+#include "core/InCompressedStream.h"
 #include "core/ReflectionType.h"
 #include "core/ReflectionObject.h"
 #include "core/ReflectionObjectsTracker.h"
 #include "core/ResourcesManager.h"
 #include "core/ReflectionSerializationMacros.h"
+#include "core/ReflectionArchiveCooker.h"
+#include "core/ReflectionStringTable.h"
+#include "core/Log.h"
 
 
+///////////////////////////////////////////////////////////////////////////////
+
+namespace // anonymous
+{
+   bool isCookedSectionValid( uint offset, uint size, uint archiveSize )
+   {
+      // written this way so that corrupted offsets can't overflow the check
+      return offset <= archiveSize && size <= archiveSize - offset;
+   }
+
+   bool isCookedTableValid( uint offset, uint entriesCount, uint entrySize, uint archiveSize )
+   {
+      if ( entriesCount > archiveSize / entrySize )
+      {
+         return false;
+      }
+      return isCookedSectionValid( offset, entriesCount * entrySize, archiveSize );
+   }
+
+   /**
+    * Makes sure that every section and every entry of a cooked archive lies within the archive,
+    * and that the main objects indices point to the existing entries of the objects table.
+    */
+   bool isCookedArchiveValid( const byte* archive, uint archiveSize )
+   {
+      const CookedArchiveHeader* header = reinterpret_cast< const CookedArchiveHeader* >( archive );
+      if ( !isCookedTableValid( header->m_objectsOffset, header->m_objectsCount, sizeof( CookedArchiveObject ), archiveSize ) ||
+           !isCookedTableValid( header->m_indicesOffset, header->m_indicesCount, sizeof( uint ), archiveSize ) ||
+           !isCookedSectionValid( header->m_externalDependenciesOffset, header->m_externalDependenciesSize, archiveSize ) ||
+           !isCookedSectionValid( header->m_stringTableOffset, header->m_stringTableSize, archiveSize ) )
+      {
+         return false;
+      }
+
+      const CookedArchiveObject* objects = reinterpret_cast< const CookedArchiveObject* >( archive + header->m_objectsOffset );
+      for ( uint i = 0; i < header->m_objectsCount; ++i )
+      {
+         const CookedArchiveObject& entry = objects[i];
+         if ( !isCookedSectionValid( entry.m_uniqueIdOffset, entry.m_uniqueIdLength, archiveSize ) ||
+              !isCookedSectionValid( entry.m_dataOffset, entry.m_dataSize, archiveSize ) )
+         {
+            return false;
+         }
+      }
+
+      const uint* indices = reinterpret_cast< const uint* >( archive + header->m_indicesOffset );
+      for ( uint i = 0; i < header->m_indicesCount; ++i )
+      {
+         if ( indices[i] >= header->m_objectsCount )
+         {
+            return false;
+         }
+      }
+
+      return true;
+   }
+
+} // anonymous
+
 ///////////////////////////////////////////////////////////////////////////////
 
 ReflectionLoader::ReflectionLoader( ReflectionObjectsTracker* tracker )
    : m_instancesTracker( tracker )
+   , m_wasCompressed( false )
 {
 }
 
@@ -35,7 +101,38 @@ void ReflectionLoader::deserialize( InStream& inStream, std::vector< FilePath >*
    // 1. check if it's indeed one of our resources and it's version number
    uint magicNo;
    inStream >> magicNo;
-   if ( magicNo != TAMY_ARCHIVE_MAGIC_NO )
+   if ( magicNo == TAMY_COMPRESSED_ARCHIVE_MAGIC_NO )
+   {
+      m_wasCompressed = true;
+
+      InCompressedStream compressedStream( inStream );
+      deserialize( compressedStream, outDependenciesToLoad, outRemappedDependencies );
+
+      // leave the stream right past the compressed data, so that the next archive can be read from it
+      compressedStream.finish();
+      return;
+   }
+   else if ( magicNo == TAMY_STRING_TABLE_MAGIC_NO )
+   {
+      // the archive that follows refers to the strings it contains by their indices in this table,
+      // so every string needs to be read ( and interned, in case of the IDStrings ) only once
+      ReflectionStringTable stringTable;
+      stringTable.load( inStream );
+
+      const ReflectionStringTable* prevStringTable = inStream.getStringTable();
+      inStream.setStringTable( &stringTable );
+      deserialize( inStream, outDependenciesToLoad, outRemappedDependencies );
+      inStream.setStringTable( prevStringTable );
+
+      CONDITIONAL_LOG( stringTable.hasInvalidReferences(), "The archive refers to strings from outside of its string table - it's corrupted\n" );
+      return;
+   }
+   else if ( magicNo == TAMY_COOKED_ARCHIVE_MAGIC_NO )
+   {
+      deserializeCooked( inStream, outDependenciesToLoad, outRemappedDependencies );
+      return;
+   }
+   else if ( magicNo != TAMY_ARCHIVE_MAGIC_NO )
    {
       return;
    }
@@ -54,6 +151,201 @@ void ReflectionLoader::deserialize( InStream& inStream, std::vector< FilePath >*
    // 4. load the indices of serialized objects
    uint serializedObjectsCount = 0;
    inStream >> serializedObjectsCount;
+
+   std::vector< uint > serializedObjectsIndices( serializedObjectsCount );
+   for ( uint i = 0; i < serializedObjectsCount; ++i )
+   {
+      inStream >> serializedObjectsIndices[i];
+   }
+
+   // 5. gather the deserialized objects
+   collectLoadedObjects( serializedObjectsCount > 0 ? &serializedObjectsIndices[0] : NULL, serializedObjectsCount );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ReflectionLoader::readExternalDependencies( InStream& inStream, std::vector< FilePath >& outDependencies )
+{
+   // the dependencies are stored right after the archive's headers, so there's no need to read any further
+   std::vector< FilePath > remappedDependencies;
+
+   uint magicNo = 0;
+   inStream >> magicNo;
+   if ( magicNo == TAMY_COMPRESSED_ARCHIVE_MAGIC_NO )
+   {
+      InCompressedStream compressedStream( inStream );
+      readExternalDependencies( compressedStream, outDependencies );
+   }
+   else if ( magicNo == TAMY_STRING_TABLE_MAGIC_NO )
+   {
+      ReflectionStringTable stringTable;
+      stringTable.load( inStream );
+
+      const ReflectionStringTable* prevStringTable = inStream.getStringTable();
+      inStream.setStringTable( &stringTable );
+      readExternalDependencies( inStream, outDependencies );
+      inStream.setStringTable( prevStringTable );
+   }
+   else if ( magicNo == TAMY_COOKED_ARCHIVE_MAGIC_NO )
+   {
+      uint archiveSize = 0;
+      inStream >> archiveSize;
+      if ( archiveSize < sizeof( CookedArchiveHeader ) )
+      {
+         return;
+      }
+
+      // read the archive up to the end of the sections we're interested in
+      CookedArchiveHeader header;
+      inStream.load( &header, sizeof( CookedArchiveHeader ) );
+
+      if ( !isCookedSectionValid( header.m_externalDependenciesOffset, header.m_externalDependenciesSize, archiveSize ) ||
+           !isCookedSectionValid( header.m_stringTableOffset, header.m_stringTableSize, archiveSize ) )
+      {
+         return;
+      }
+
+      uint dependenciesEnd = header.m_externalDependenciesOffset + header.m_externalDependenciesSize;
+      uint stringTableEnd = header.m_stringTableOffset + header.m_stringTableSize;
+      uint requiredSize = dependenciesEnd > stringTableEnd ? dependenciesEnd : stringTableEnd;
+
+      Array< byte > archiveBuf;
+      archiveBuf.resizeWithoutInitializing( requiredSize > sizeof( CookedArchiveHeader ) ? requiredSize : sizeof( CookedArchiveHeader ) );
+      byte* archive = (byte*)archiveBuf;
+      memcpy( archive, &header, sizeof( CookedArchiveHeader ) );
+      if ( requiredSize > sizeof( CookedArchiveHeader ) )
+      {
+         inStream.load( archive + sizeof( CookedArchiveHeader ), requiredSize - sizeof( CookedArchiveHeader ) );
+      }
+
+      ReflectionStringTable stringTable;
+      const ReflectionStringTable* archiveStringTable = NULL;
+      if ( header.m_stringTableSize > 0 )
+      {
+         InMemoryStream stringTableStream( archive + header.m_stringTableOffset, header.m_stringTableSize );
+         stringTable.load( stringTableStream );
+         archiveStringTable = &stringTable;
+      }
+
+      InMemoryStream externalDependenciesStream( archive + header.m_externalDependenciesOffset, header.m_externalDependenciesSize );
+      externalDependenciesStream.setStringTable( archiveStringTable );
+      loadExternalDependencies( externalDependenciesStream, &outDependencies, &remappedDependencies );
+   }
+   else if ( magicNo == TAMY_ARCHIVE_MAGIC_NO )
+   {
+      loadExternalDependencies( inStream, &outDependencies, &remappedDependencies );
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ReflectionLoader::deserializeCooked( InStream& inStream, std::vector< FilePath >* outDependenciesToLoad, std::vector< FilePath >* outRemappedDependencies )
+{
+   uint archiveSize = 0;
+   inStream >> archiveSize;
+   if ( archiveSize < sizeof( CookedArchiveHeader ) )
+   {
+      return;
+   }
+
+   // 1. bring the whole archive into memory. If the stream reads from a mapped file,
+   // or from a memory block ( a prefetched file ), we can address its contents directly, 
+   // otherwise it takes a single read
+   Array< byte > archiveBuf;
+   const byte* archive = NULL;
+   InMappedFileStream* mappedStream = dynamic_cast< InMappedFileStream* >( &inStream );
+   InMemoryStream* memoryStream = dynamic_cast< InMemoryStream* >( &inStream );
+   if ( mappedStream && mappedStream->getRemainingSize() >= archiveSize )
+   {
+      archive = mappedStream->getCurrentData();
+      mappedStream->skip( archiveSize );
+   }
+   else if ( memoryStream && memoryStream->getRemainingSize() >= archiveSize )
+   {
+      archive = memoryStream->getCurrentData();
+      memoryStream->skip( archiveSize );
+   }
+   else
+   {
+      archiveBuf.resizeWithoutInitializing( archiveSize );
+      inStream.load( (byte*)archiveBuf, archiveSize );
+      archive = (const byte*)archiveBuf;
+   }
+
+   // the offsets and counts come straight from the file - make sure they don't point outside of it
+   // before we start indexing the tables with them
+   if ( !isCookedArchiveValid( archive, archiveSize ) )
+   {
+      return;
+   }
+
+   // the tables of the archive can be used in place
+   const CookedArchiveHeader* header = reinterpret_cast< const CookedArchiveHeader* >( archive );
+   const CookedArchiveObject* objects = reinterpret_cast< const CookedArchiveObject* >( archive + header->m_objectsOffset );
+   const uint* serializedObjectsIndices = reinterpret_cast< const uint* >( archive + header->m_indicesOffset );
+
+   // 2. load the string table the archive data refers to
+   ReflectionStringTable stringTable;
+   const ReflectionStringTable* archiveStringTable = NULL;
+   if ( header->m_stringTableSize > 0 )
+   {
+      InMemoryStream stringTableStream( archive + header->m_stringTableOffset, header->m_stringTableSize );
+      stringTable.load( stringTableStream );
+      archiveStringTable = &stringTable;
+   }
+
+   // 3. load external dependencies
+   InMemoryStream externalDependenciesStream( archive + header->m_externalDependenciesOffset, header->m_externalDependenciesSize );
+   externalDependenciesStream.setStringTable( archiveStringTable );
+   uint firstExternalDependencyIdx = loadExternalDependencies( externalDependenciesStream, outDependenciesToLoad, outRemappedDependencies );
+
+   // 4. load internal dependencies
+   if ( header->m_objectsCount == 0 )
+   {
+      // no dependencies restored - bail
+      return;
+   }
+
+   m_dependencies.reserve( header->m_objectsCount );
+   for ( uint i = 0; i < header->m_objectsCount; ++i )
+   {
+      const CookedArchiveObject& entry = objects[i];
+
+      // if we're using an instances tracker, we may not need to touch the object's data at all
+      ReflectionObject* dependency = NULL;
+      if ( m_instancesTracker )
+      {
+         ReflectionObject::UniqueId objId( (const char*)( archive + entry.m_uniqueIdOffset ), entry.m_uniqueIdLength );
+         dependency = m_instancesTracker->findInstance( objId );
+      }
+
+      if ( !dependency )
+      {
+         // this is a new instance - load it
+         InMemoryStream objectStream( archive + entry.m_dataOffset, entry.m_dataSize );
+         objectStream.setStringTable( archiveStringTable );
+         dependency = SerializableReflectionType::load< ReflectionObject >( objectStream );
+
+         if ( m_instancesTracker && dependency )
+         {
+            m_instancesTracker->trackInstance( dependency );
+         }
+      }
+
+      m_dependencies.push_back( dependency );
+   }
+   restoreAllDependencies( firstExternalDependencyIdx );
+
+   // 5. gather the deserialized objects
+   collectLoadedObjects( serializedObjectsIndices, header->m_indicesCount );
+
+   CONDITIONAL_LOG( stringTable.hasInvalidReferences(), "The cooked archive refers to strings from outside of its string table - it's corrupted\n" );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ReflectionLoader::collectLoadedObjects( const uint* serializedObjectsIndices, uint serializedObjectsCount )
+{
    if ( serializedObjectsCount == 0 )
    {
       // no serialized objects - something's wrong
@@ -68,11 +360,10 @@ void ReflectionLoader::deserialize( InStream& inStream, std::vector< FilePath >*
       return;
    }
 
-   // 5. deserialize the objects
+   // 1. deserialize the objects
    for ( uint i = 0; i < serializedObjectsCount; ++i )
    {
-      uint serializedObjectIdx = -1;
-      inStream >> serializedObjectIdx;
+      uint serializedObjectIdx = serializedObjectsIndices[i];
       
       ReflectionObject* obj = m_dependencies[serializedObjectIdx];
       if ( obj )
@@ -81,7 +372,7 @@ void ReflectionLoader::deserialize( InStream& inStream, std::vector< FilePath >*
       }
    }
 
-   // 6. copy all encountered dependencies to the list of all objects this loader's ever loaded
+   // 2. copy all encountered dependencies to the list of all objects this loader's ever loaded
    uint dependenciesCount = m_dependencies.size();
    for ( uint i = 0; i < dependenciesCount; ++i )
    {
@@ -92,7 +383,7 @@ void ReflectionLoader::deserialize( InStream& inStream, std::vector< FilePath >*
       }
    }
 
-   // 7. clean temporary data
+   // 3. clean temporary data
    m_dependencies.clear();
 }
 
@@ -194,11 +485,21 @@ bool ReflectionLoader::loadInternalDependencies( InStream& stream, uint firstExt
       m_dependencies.push_back( dependency );
    }
 
+   restoreAllDependencies( firstExternalDependencyIdx );
+
+   return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ReflectionLoader::restoreAllDependencies( uint firstExternalDependencyIdx )
+{
    // store the remapping offset for the callback
    m_externalDependenciesOffset = firstExternalDependencyIdx;
 
    // now that we have the dependencies, it's time to map them in the loaded objects,
    // and remap the external dependency pointers to match the dependencies order stored in the array 'outExternalDependencies'
+   uint dependenciesCount = m_dependencies.size();
    for ( uint i = 0; i < dependenciesCount; ++i )
    {
       ReflectionObject* object = m_dependencies[i];
@@ -207,8 +508,6 @@ bool ReflectionLoader::loadInternalDependencies( InStream& stream, uint firstExt
          restoreDependencies( object );
       }
    }
-
-   return true;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -6,6 +6,15 @@
 #include "core/ReflectionObjectChangeListener.h"
 
 
+///////////////////////////////////////////////////////////////////////////////
+
+namespace // anonymous
+{
+   // objects can be created by the resources loading thread as well, hence the interlocked increments
+   volatile LONG g_nextChangeStamp = 0;
+
+} // anonymous
+
 ///////////////////////////////////////////////////////////////////////////////
 
 BEGIN_OBJECT( ReflectionObject )
@@ -16,6 +25,7 @@ END_OBJECT()
 ReflectionObject::ReflectionObject( const char* uniqueId ) 
    : m_uniqueId( uniqueId ? uniqueId : "" ) 
    , m_referencesCounter( 1 )
+   , m_changeStamp( InterlockedIncrement( &g_nextChangeStamp ) )
 {}
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -79,27 +89,8 @@ void ReflectionObject::detachListener( ReflectionObjectChangeListener& listener
 void ReflectionObject::notifyPropertyChange( const std::string& propertyName )
 {
    // find the field in this or the parent types
-   ReflectionTypeComponent* propertyField = NULL;
-   {
-      std::vector< const SerializableReflectionType* > types;
-      types.push_back( &getVirtualRTTI() );
-
-      while( !types.empty() )
-      {
-         const SerializableReflectionType* analyzedType = types.back();
-         types.pop_back();
-
-         propertyField = analyzedType->findMemberField( propertyName );
-         if ( propertyField != NULL )
-         {
-            // found it !!!
-            break;
-         }
-
-         // collect parent types for further analysis
-         analyzedType->collectParents( types );
-      }
-   }
+   uint propertyId = ReflectionTypeComponent::generateId( propertyName );
+   ReflectionTypeComponent* propertyField = getVirtualRTTI().findHierarchyMemberField( propertyId );
 
    if ( !propertyField )
    {
@@ -108,6 +99,7 @@ void ReflectionObject::notifyPropertyChange( const std::string& propertyName )
    }
 
    ReflectionProperty* property = propertyField->createProperty( this );
+   markDirty();
 
    // notify the object itself
    onPropertyChanged( *property );
@@ -125,6 +117,13 @@ void ReflectionObject::notifyPropertyChange( const std::string& propertyName )
 
 ///////////////////////////////////////////////////////////////////////////////
 
+void ReflectionObject::markDirty()
+{
+   m_changeStamp = InterlockedIncrement( &g_nextChangeStamp );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void ReflectionObject::addReference()
 {
    ++m_referencesCounter;
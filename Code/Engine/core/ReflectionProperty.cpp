@@ -31,6 +31,7 @@ void ReflectionProperty::notifyAfterChange()
 {
    if ( m_observer )
    {
+      m_observer->markDirty();
       m_observer->onPropertyChanged( *this );
    }
 }
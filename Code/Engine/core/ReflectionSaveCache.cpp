@@ -0,0 +1,78 @@
+#include "core.h"
+#include "core/ReflectionSaveCache.h"
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+ReflectionSaveCache::~ReflectionSaveCache()
+{
+   clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+ReflectionSaveCache::Entry* ReflectionSaveCache::find( const ReflectionObject* object )
+{
+   EntriesMap::iterator it = m_entries.find( object );
+   if ( it == m_entries.end() )
+   {
+      return NULL;
+   }
+
+   it->second->m_wasUsed = true;
+   return it->second;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+ReflectionSaveCache::Entry& ReflectionSaveCache::store( const ReflectionObject* object )
+{
+   Entry*& entry = m_entries[object];
+   if ( !entry )
+   {
+      entry = new Entry();
+   }
+
+   entry->m_wasUsed = true;
+   entry->m_data.clear();
+   entry->m_dependencies.clear();
+   entry->m_dependencyIndices.clear();
+
+   return *entry;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ReflectionSaveCache::removeUnused()
+{
+   for ( EntriesMap::iterator it = m_entries.begin(); it != m_entries.end(); )
+   {
+      Entry* entry = it->second;
+      if ( entry->m_wasUsed )
+      {
+         entry->m_wasUsed = false;
+         ++it;
+      }
+      else
+      {
+         delete entry;
+         it = m_entries.erase( it );
+      }
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ReflectionSaveCache::clear()
+{
+   for ( EntriesMap::iterator it = m_entries.begin(); it != m_entries.end(); ++it )
+   {
+      delete it->second;
+   }
+   m_entries.clear();
+
+   // the table can only be cleared along with the data that refers to it
+   m_stringTable.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
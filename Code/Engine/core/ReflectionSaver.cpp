@@ -1,6 +1,9 @@
 #include "core.h"
 #include "core/ReflectionSaver.h"
 #include "core/OutStream.h"
+#include "core/OutCompressedStream.h"
+#include "core/OutArrayStream.h"
+#include "core/ReflectionStringTable.h"
 #include "core/ReflectionObject.h"
 #include "core/Resource.h"
 #include "core/ReflectionSerializationMacros.h"
@@ -8,8 +11,10 @@
 
 ///////////////////////////////////////////////////////////////////////////////
 
-ReflectionSaver::ReflectionSaver( OutStream& outStream ) 
+ReflectionSaver::ReflectionSaver( OutStream& outStream, ReflectionSaveCache* cache ) 
    : m_outStream( outStream )
+   , m_cache( cache )
+   , m_compress( false )
 {
 }
 
@@ -26,15 +31,12 @@ void ReflectionSaver::save( const ReflectionObject* object )
 {
    // Check if the object isn't already stored somewhere in the dependencies map.
    // If it is, there's no point in serializing it again.
-   uint count = m_dependencies.size();
-   for ( uint i = 0; i < count; ++i )
+   DependencyIndicesMap::const_iterator it = m_dependencyIndices.find( object );
+   if ( it != m_dependencyIndices.end() )
    {
-      if ( m_dependencies[i] == object )
-      {
-         // it was already serialized - just add its dependency index to the saved objects list
-         m_serializedObjectsIndices.push_back( i );
-         return;
-      }
+      // it was already serialized - just add its dependency index to the saved objects list
+      m_serializedObjectsIndices.push_back( it->second );
+      return;
    }
 
    // Create a map of all pointers we're about to serialize.
@@ -79,18 +81,15 @@ void ReflectionSaver::addDependency( const ReflectionObject* dependency )
 void ReflectionSaver::addExternalDependency( const ReflectionObject* dependency )
 {
    // check the uniqueness of the dependency
-   uint count = m_externalDependencies.size();
-   for ( uint i = 0; i < count; ++i )
+   if ( m_externalDependencyIndices.find( dependency ) != m_externalDependencyIndices.end() )
    {
-      if ( m_externalDependencies[i] == dependency )
-      {
-         // this external dependency is already known
-         return;
-      }
+      // this external dependency is already known
+      return;
    }
 
    // don't save a resource, flag it as an external dependency instead
    const Resource* res = static_cast< const Resource* >( dependency );
+   m_externalDependencyIndices.insert( std::make_pair( dependency, m_externalDependencies.size() ) );
    m_externalDependencies.push_back( res );
 }
 
@@ -99,20 +98,17 @@ void ReflectionSaver::addExternalDependency( const ReflectionObject* dependency
 void ReflectionSaver::addInternalDependency( const ReflectionObject* dependency )
 {
    // check the uniqueness of the dependency
-   uint count = m_dependencies.size();
-   for ( uint i = 0; i < count; ++i )
+   if ( m_dependencyIndices.find( dependency ) != m_dependencyIndices.end() )
    {
-      if ( m_dependencies[i] == dependency )
-      {
-         // this dependency is already known
-         return;
-      }
+      // this dependency is already known
+      return;
    }
 
    // notify the object that it's about to be serialized
    const_cast< ReflectionObject* >( dependency )->onObjectPreSave();
 
    // this is a new dependency
+   m_dependencyIndices.insert( std::make_pair( dependency, m_dependencies.size() ) );
    m_dependencies.push_back( dependency );
    m_objectsToMap.push_back( dependency );
 }
@@ -147,27 +143,68 @@ void ReflectionSaver::mapDependencies( const ReflectionObject* object )
 
 void ReflectionSaver::flush()
 {
+   if ( m_compress )
+   {
+      // the compressed archive is preceded by a marker that tells the loader to decompress it
+      m_outStream << TAMY_COMPRESSED_ARCHIVE_MAGIC_NO;
+
+      OutCompressedStream compressedStream( m_outStream );
+      writeArchive( compressedStream );
+      compressedStream.finish();
+   }
+   else
+   {
+      writeArchive( m_outStream );
+   }
+
+   // drop the cached data of the objects that are no longer a part of the archive
+   if ( m_cache )
+   {
+      m_cache->removeUnused();
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ReflectionSaver::writeArchive( OutStream& outStream )
+{
+   // The strings the archive contains are replaced with their indices in a string table that precedes
+   // the archive. The table is filled as the archive is being written, so the archive needs to be written
+   // to a temporary buffer first.
+   // The cached data refers to the table the cache maintains, so if we're using a cache, we need to use its table.
+   ReflectionStringTable localStringTable;
+   ReflectionStringTable& stringTable = m_cache ? m_cache->getStringTable() : localStringTable;
+
+   Array< byte > archiveBuf;
+   OutArrayStream archiveStream( archiveBuf );
+   archiveStream.setStringTable( &stringTable );
+
    // 1. save the archive magic number
-   m_outStream << TAMY_ARCHIVE_MAGIC_NO;
+   archiveStream << TAMY_ARCHIVE_MAGIC_NO;
 
    // 2. serialize the external dependencies
-   saveExternalDependencies( m_outStream );
+   saveExternalDependencies( archiveStream );
 
    // 3. we need to serialize the dependencies map.
-   saveInternalDependencies( m_outStream );
+   saveInternalDependencies( archiveStream );
 
    // 4. now serialize the indices of the saved objects
    {
       uint savedObjectsCount = m_serializedObjectsIndices.size();
-      m_outStream << savedObjectsCount;
+      archiveStream << savedObjectsCount;
       for ( uint i = 0; i < savedObjectsCount; ++i )
       {
-         m_outStream << m_serializedObjectsIndices[i];
+         archiveStream << m_serializedObjectsIndices[i];
       }
 
       // clear the saved objects indices list
       m_serializedObjectsIndices.clear();
    }
+
+   // 5. write the string table, followed by the archive itself
+   outStream << TAMY_STRING_TABLE_MAGIC_NO;
+   stringTable.save( outStream );
+   outStream.save( (byte*)archiveBuf, archiveBuf.size() );
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -177,6 +214,7 @@ void ReflectionSaver::saveExternalDependencies( OutStream& outStream )
    // use a temporary stream, 'cause we need to write a skip size for this piece of data
    Array< byte > tmpDataBuf;
    OutArrayStream tmpDataStream( tmpDataBuf );
+   tmpDataStream.setStringTable( outStream.getStringTable() );
 
    // number of stored dependencies
    {
@@ -207,20 +245,40 @@ void ReflectionSaver::saveInternalDependencies( OutStream& outStream )
    outStream << dependenciesCount;
 
    // dependencies themselves
+   Array< byte > tmpDataBuf;
    for ( uint i = 0; i < dependenciesCount; ++i )
    {
+      const ReflectionObject* dependency = m_dependencies[i];
+
       // store the unique id of the type so that we can look it up quickly afterwards
-      outStream << m_dependencies[i]->m_uniqueId;
+      outStream << dependency->m_uniqueId;
+
+      // if the object hasn't changed since it was last saved, reuse its data
+      if ( m_cache )
+      {
+         ReflectionSaveCache::Entry* entry = m_cache->find( dependency );
+         if ( entry && isCacheEntryValid( dependency, *entry ) )
+         {
+            uint dataSize = entry->m_data.size();
+            outStream << dataSize;
+            outStream.save( (byte*)entry->m_data, dataSize );
+            continue;
+         }
+      }
 
       // save the data to a temp buffer, 'cause we'll be needing a skip size of the data
       // so that if we manage to find this instance in our records during deserialization ( providing
       // that we keep track of course ), we can just skip reading it
       {
-         Array< byte > tmpDataBuf;
+         tmpDataBuf.clear();
          OutArrayStream tmpDataStream( tmpDataBuf );
+         tmpDataStream.setStringTable( outStream.getStringTable() );
+
+         m_queriedDependencies.clear();
+         m_queriedDependencyIndices.clear();
 
-         const SerializableReflectionType& depTypeInfo = m_dependencies[i]->getVirtualRTTI();
-         depTypeInfo.save( *m_dependencies[i], *this, tmpDataStream );
+         const SerializableReflectionType& depTypeInfo = dependency->getVirtualRTTI();
+         depTypeInfo.save( *dependency, *this, tmpDataStream );
 
          // store the size of the data
          uint dataSize = tmpDataBuf.size();
@@ -229,48 +287,87 @@ void ReflectionSaver::saveInternalDependencies( OutStream& outStream )
          // and then the data itself
          outStream.save( (byte*)tmpDataBuf, dataSize );
       }
+
+      // cache the data
+      if ( m_cache )
+      {
+         ReflectionSaveCache::Entry& entry = m_cache->store( dependency );
+         entry.m_changeStamp = dependency->getChangeStamp();
+         entry.m_data.copyFrom( tmpDataBuf );
+         entry.m_dependencies = m_queriedDependencies;
+         entry.m_dependencyIndices = m_queriedDependencyIndices;
+      }
    }
 
    // clear the dependencies list
    m_dependencies.clear();
+   m_dependencyIndices.clear();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
-uint ReflectionSaver::findDependency( const ReflectionObject* dependency ) const
+bool ReflectionSaver::isCacheEntryValid( const ReflectionObject* object, const ReflectionSaveCache::Entry& entry ) const
 {
-   if ( dependency->isA< Resource >() )
+   if ( entry.m_changeStamp != object->getChangeStamp() )
    {
-      const Resource* resDep = static_cast< const Resource* >( dependency );
+      return false;
+   }
 
-      // it's an external dependency
-      uint dependenciesCount = m_externalDependencies.size();
-      for ( uint i = 0; i < dependenciesCount; ++i )
+   // the referenced objects may have been deleted in the meantime, so we can't access them -
+   // compare the pointers only. The cached index tells us which table to look in
+   uint count = entry.m_dependencies.size();
+   for ( uint i = 0; i < count; ++i )
+   {
+      uint cachedIdx = entry.m_dependencyIndices[i];
+      bool isExternal = ( cachedIdx & EXTERNAL_DEPENDENCY_MARKER ) == EXTERNAL_DEPENDENCY_MARKER;
+
+      uint dependencyIdx = 0;
+      if ( !findDependencyIndex( entry.m_dependencies[i], isExternal, dependencyIdx ) || dependencyIdx != cachedIdx )
       {
-         if ( m_externalDependencies[i] == resDep )
-         {
-            // found it - mark that's an external dependency by setting the 
-            return CREATE_EXTERNAL_DEPENDENCY_INDEX( i );
-         }
+         return false;
       }
    }
-   else
+
+   return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool ReflectionSaver::findDependencyIndex( const ReflectionObject* dependency, bool external, uint& outIdx ) const
+{
+   const DependencyIndicesMap& indices = external ? m_externalDependencyIndices : m_dependencyIndices;
+   DependencyIndicesMap::const_iterator it = indices.find( dependency );
+   if ( it == indices.end() )
    {
-      // it's an internal dependency
-      uint dependenciesCount = m_dependencies.size();
-      for ( uint i = 0; i < dependenciesCount; ++i )
-      {
-         if ( m_dependencies[i] == dependency )
-         {
-            // found it
-            return CREATE_INTERNAL_DEPENDENCY_INDEX( i );
-         }
-      }
+      return false;
+   }
+
+   outIdx = external ? CREATE_EXTERNAL_DEPENDENCY_INDEX( it->second ) : CREATE_INTERNAL_DEPENDENCY_INDEX( it->second );
+   return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+uint ReflectionSaver::findDependency( const ReflectionObject* dependency ) const
+{
+   // resources are always stored as external dependencies - the same way 'addDependency' maps them
+   uint dependencyIdx = 0;
+   if ( !findDependencyIndex( dependency, dependency->isA< Resource >(), dependencyIdx ) )
+   {
+      // we didn't map such a dependency - how did it got queried for then?
+      ASSERT_MSG( false, "Unmapped dependency queried - check the dependency mapping related code" );
+      return 0;
+   }
+
+   if ( m_cache )
+   {
+      // memorize the dependencies the serialized object references, so that we can tell
+      // when its cached data goes out of date
+      m_queriedDependencies.push_back( dependency );
+      m_queriedDependencyIndices.push_back( dependencyIdx );
    }
 
-   // we didn't map such a dependency - how did it got queried for then?
-   ASSERT_MSG( false, "Unmapped dependency queried - check the dependency mapping related code" );
-   return 0;
+   return dependencyIdx;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
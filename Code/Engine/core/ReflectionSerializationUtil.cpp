@@ -2,6 +2,8 @@
 #include "core/ReflectionSerializationUtil.h"
 #include "core/FilePath.h"
 #include "core/InFileStream.h"
+#include "core/InMappedFileStream.h"
+#include "core/MappedFile.h"
 #include "core/OutFileStream.h"
 #include "core/ReflectionLoader.h"
 #include "core/ReflectionSaver.h"
@@ -9,9 +11,39 @@
 #include "core/ReflectionObject.h"
 #include "core/IProgressObserver.h"
 #include "core/ResourceDependenciesMapper.h"
+#include "core/ResourcesPrefetcher.h"
 #include "core/Assert.h"
 
 
+///////////////////////////////////////////////////////////////////////////////
+
+namespace // anonymous
+{
+   /**
+    * Opens a stream that reads the specified file. Binary files are read straight from 
+    * a memory mapping, while the remaining ones go through a regular file stream.
+    *
+    * @return     a stream the caller takes the ownership of, or NULL if the file couldn't be opened
+    */
+   InStream* openInStream( const Filesystem& filesystem, const FilePath& path, std::ios_base::openmode accessMode )
+   {
+      if ( ( accessMode & std::ios_base::binary ) == std::ios_base::binary )
+      {
+         MappedFile* mappedFile = filesystem.map( path );
+         if ( mappedFile )
+         {
+            return new InMappedFileStream( mappedFile );
+         }
+      }
+
+      File* file = filesystem.open( path, std::ios_base::in | accessMode );
+      return file ? new InFileStream( file ) : NULL;
+   }
+
+} // anonymous
+
+///////////////////////////////////////////////////////////////////////////////
+
 ///////////////////////////////////////////////////////////////////////////////
 
 void ReflectionSerializationUtil::saveObject( const ReflectionObject* object, const FilePath& savePath, IProgressObserver* progressObserver )
@@ -76,13 +108,17 @@ void ReflectionSerializationUtil::loadObjects( const FilePath& loadPath, std::ve
    ResourcesManager& resMgr = ResourcesManager::getInstance();
    Filesystem& filesystem = resMgr.getFilesystem();
 
-   File* file = filesystem.open( loadPath, std::ios_base::in | std::ios_base::binary );
-   InFileStream stream( file );
+   InStream* stream = openInStream( filesystem, loadPath, std::ios_base::binary );
+   if ( !stream )
+   {
+      return;
+   }
 
    std::vector< FilePath > resourcesToLoad;
    std::vector< FilePath > resourcesMap;
    ReflectionLoader loader;
-   loader.deserialize( stream, &resourcesToLoad, &resourcesMap );
+   loader.deserialize( *stream, &resourcesToLoad, &resourcesMap );
+   delete stream;
 
    ASSERT_MSG( resourcesToLoad.empty(), "The archive contains references to external Resources, which won't be loaded by this method. Use 'loadResources' instead." );
    if ( !resourcesToLoad.empty() )
@@ -185,8 +221,10 @@ void ReflectionSerializationUtil::saveResources( const std::vector< const Resour
 
       // save the resource
       OutFileStream outStream( file );
-      ReflectionSaver saver( outStream );
+      ReflectionSaver saver( outStream, res->getSaveCache() );
+      saver.setCompressed( res->isCompressed() );
       saver.save( res );
+      res->markClean();
 
       // add the mapped resources to the save list, providing they are unique
       saver.collectExternalDependencies( resourcesToSave );
@@ -214,11 +252,17 @@ Resource* ReflectionSerializationUtil::loadResource( const FilePath& loadPath, I
 void ReflectionSerializationUtil::loadResources( const FilePath& loadPath, std::vector< Resource* >& outResources, IProgressObserver* progressObserver )
 {
    ResourcesManager& resMgr = ResourcesManager::getInstance();
-   Filesystem& filesystem = resMgr.getFilesystem();
 
+   DeserializedResources resources;
+   deserializeResources( resMgr.getFilesystem(), loadPath, resources, &resMgr, progressObserver );
+   finishLoadingResources( resources, outResources );
+}
 
-   std::vector< FilePath > resourcesToLoad;
-   std::vector< FilePath > resourcesMap;
+///////////////////////////////////////////////////////////////////////////////
+
+void ReflectionSerializationUtil::deserializeResources( const Filesystem& filesystem, const FilePath& loadPath, DeserializedResources& outResources, ResourcesManager* resourcesManager, IProgressObserver* progressObserver, ResourcesPrefetcher* prefetcher )
+{
+   std::vector< FilePath >& resourcesToLoad = outResources.m_paths;
    resourcesToLoad.push_back( loadPath );
 
    // notify about the serialization progress
@@ -230,8 +274,6 @@ void ReflectionSerializationUtil::loadResources( const FilePath& loadPath, std::
 
    // Go through all resources in the list and load them. New resources
    // will be added to the list as we keep mapping them.
-   std::vector< ReflectionObject* > loadedResources;
-   std::vector< ReflectionObject* > allLoadedObjects;
    uint loadedResourceIdx = 0;
    while( loadedResourceIdx < resourcesToLoad.size() )
    {
@@ -239,86 +281,125 @@ void ReflectionSerializationUtil::loadResources( const FilePath& loadPath, std::
       ++loadedResourceIdx;
 
       // first check if such a resource is not yet loaded ( perhaps it's already there, and we can save time )
-      Resource* res = resMgr.findResource( loadedResourcePath );
+      Resource* res = resourcesManager ? resourcesManager->findResource( loadedResourcePath ) : NULL;
+      uint objectsCount = 0;
       if ( res == NULL )
       {
-         // open the file for loading
-         std::string extension = loadedResourcePath.extractExtension();
-         std::ios_base::openmode accessMode = Resource::getFileAccessMode( extension );
-         File* file = filesystem.open( loadedResourcePath, std::ios_base::in | accessMode );
+         // open the file for loading - unless it's been prefetched ( the file may have appeared in the meantime )
+         InStream* inStream = prefetcher ? prefetcher->open( loadedResourcePath ) : NULL;
+         if ( !inStream )
+         {
+            inStream = openResourceStream( filesystem, loadedResourcePath );
+         }
 
-         if ( file )
+         if ( inStream )
          {
-            InFileStream inStream( file );
             ReflectionLoader loader;
-            loader.deserialize( inStream, &resourcesToLoad, &resourcesMap );
-            res = loader.getNextObject< Resource >();
+            loader.deserialize( *inStream, &resourcesToLoad, &outResources.m_remappedDependencies );
+            delete inStream;
 
-            allLoadedObjects.insert( allLoadedObjects.end(), loader.m_allLoadedObjects.begin(), loader.m_allLoadedObjects.end() );
+            // the prefetched data is no longer needed
+            if ( prefetcher )
+            {
+               prefetcher->release( loadedResourcePath );
+            }
+
+            res = loader.getNextObject< Resource >();
+            if ( res )
+            {
+               // the resource will be saved the same way it was stored
+               res->setCompressed( loader.wasCompressed() );
+
+               objectsCount = loader.m_allLoadedObjects.size();
+               outResources.m_allLoadedObjects.insert( outResources.m_allLoadedObjects.end(), loader.m_allLoadedObjects.begin(), loader.m_allLoadedObjects.end() );
+            }
          }
       }
 
-      if ( res )
-      {
-         // memorize the loaded resource
-         loadedResources.push_back( res );
-      }
-      else
+      if ( !res && resourcesManager )
       {
          // if any of the dependencies were not loaded, break the process
          break;
       }
 
+      // memorize the loaded resource ( if we can't access the resources manager, the resource may still turn out to be loaded
+      // once we can )
+      outResources.m_resources.push_back( res );
+      outResources.m_objectsCount.push_back( objectsCount );
+
       // advance the observer ONLY when the resource was successfully loaded
-      if ( progressObserver )
+      if ( progressObserver && res )
       {
          progressObserver->advance();
       }
    }
+}
 
-   // Only if there are as many loaded resources as there were mapped resource names can we consider
-   // loading to be successful.
-   if ( loadedResources.size() == resourcesToLoad.size() )
+///////////////////////////////////////////////////////////////////////////////
+
+void ReflectionSerializationUtil::finishLoadingResources( DeserializedResources& resources, std::vector< Resource* >& outResources )
+{
+   ResourcesManager& resMgr = ResourcesManager::getInstance();
+
+   // look up the resources that couldn't be deserialized - they may be the ones that only exist in the manager
+   bool allResourcesLoaded = ( resources.m_resources.size() == resources.m_paths.size() );
+   uint count = resources.m_resources.size();
+   for ( uint i = 0; i < count && allResourcesLoaded; ++i )
    {
-      // But before we do, let's register the resources with the manager,
-      // `cause the mapper references the manager to query for those resources.
-      // We're gonna need to add them anyway, so this is the perfect spot.
-      uint count = loadedResources.size();
-      for ( uint i = 0; i < count; ++i )
+      if ( !resources.m_resources[i] )
       {
-         Resource* res = static_cast< Resource* >( loadedResources[i] );
-         if ( !res->isManaged() )
-         {
-            // register the managed resources
-            res->setFilePath( resourcesToLoad[i] );
-            resMgr.registerNewResource( res );
-         }
-
-         // and since we're already iterating over the resources and casting them - put the resources in the output array
-         outResources.push_back( res );
+         resources.m_resources[i] = resMgr.findResource( resources.m_paths[i] );
+         allResourcesLoaded = ( resources.m_resources[i] != NULL );
       }
-
-      // it was successful - map inter-resource dependencies on all loaded objects
-      ExternalDependenciesLinker linker( resourcesMap );
-      linker.linkDependencies( allLoadedObjects );
    }
-   else
+
+   // Only if there are as many loaded resources as there were mapped resource names can we consider
+   // loading to be successful.
+   if ( !allResourcesLoaded )
    {
       // loading failed - delete what we created so far in the process
-      uint count = loadedResources.size();
-      for ( uint i = 0; i < count; ++i )
+      // and exit - no further steps should be taken at this point
+      discardResources( resources );
+      return;
+   }
+
+   // But before we do, let's register the resources with the manager,
+   // `cause the mapper references the manager to query for those resources.
+   // We're gonna need to add them anyway, so this is the perfect spot.
+   std::vector< ReflectionObject* > allLoadedObjects;
+   uint firstObjectIdx = 0;
+   for ( uint i = 0; i < count; ++i )
+   {
+      Resource* res = resources.m_resources[i];
+      uint objectsCount = resources.m_objectsCount[i];
+      if ( !res->isManaged() )
       {
-         Resource* res = static_cast< Resource* >( loadedResources[i] );
-         if ( !res->isManaged() )
+         // register the managed resources
+         res->setFilePath( resources.m_paths[i] );
+         if ( resMgr.registerNewResource( res ) )
+         {
+            allLoadedObjects.insert( allLoadedObjects.end(), resources.m_allLoadedObjects.begin() + firstObjectIdx, resources.m_allLoadedObjects.begin() + firstObjectIdx + objectsCount );
+         }
+         else
          {
-            // delete only the unmanaged resources ( we could have encountered resources that are already registered with the resources manager - DO NOT touch those )
-            delete res;
+            // the resource was loaded in the meantime - the manager deleted our copy, so use the managed instance instead
+            res = resMgr.findResource( resources.m_paths[i] );
+            resources.m_resources[i] = res;
          }
       }
+      firstObjectIdx += objectsCount;
 
-      // and exit - no further steps should be taken at this point
-      return;
+      // and since we're already iterating over the resources and casting them - put the resources in the output array
+      if ( res )
+      {
+         outResources.push_back( res );
+      }
    }
+   resources.m_allLoadedObjects.clear();
+
+   // it was successful - map inter-resource dependencies on all loaded objects
+   ExternalDependenciesLinker linker( resources.m_remappedDependencies );
+   linker.linkDependencies( allLoadedObjects );
 
    // make sure that all loaded objects are informed that they were loaded
    uint allLoadedObjectsCount = allLoadedObjects.size();
@@ -332,12 +413,86 @@ void ReflectionSerializationUtil::loadResources( const FilePath& loadPath, std::
    // Since it's the resources that manage the loaded objects, perform one last step -
    // inform them that everything has been successfully loaded so that they can kick off any final
    // post-load group activities
-   uint allLoadedResources = loadedResources.size();
-   for ( uint i = 0; i < allLoadedResources; ++i )
+   for ( uint i = 0; i < count; ++i )
+   {
+      Resource* res = resources.m_resources[i];
+      if ( res )
+      {
+         res->finalizeResourceLoading();
+      }
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ReflectionSerializationUtil::discardResources( DeserializedResources& resources )
+{
+   uint count = resources.m_resources.size();
+   for ( uint i = 0; i < count; ++i )
    {
-      Resource* res = static_cast< Resource* >( loadedResources[i] );
-      res->finalizeResourceLoading();
+      Resource* res = resources.m_resources[i];
+      if ( res && !res->isManaged() )
+      {
+         // delete only the unmanaged resources ( we could have encountered resources that are already registered with the resources manager - DO NOT touch those )
+         delete res;
+      }
    }
+
+   resources.m_resources.clear();
+   resources.m_objectsCount.clear();
+   resources.m_allLoadedObjects.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+Resource* ReflectionSerializationUtil::loadResourceCopy( const Resource& resource )
+{
+   ResourcesManager& resMgr = ResourcesManager::getInstance();
+   const FilePath& path = resource.getFilePath();
+
+   InStream* inStream = openResourceStream( resMgr.getFilesystem(), path );
+   if ( !inStream )
+   {
+      return NULL;
+   }
+
+   // the resource itself goes first on the list of dependencies, so that it's not treated as one
+   std::vector< FilePath > dependencies;
+   std::vector< FilePath > remappedDependencies;
+   dependencies.push_back( path );
+
+   ReflectionLoader loader;
+   loader.deserialize( *inStream, &dependencies, &remappedDependencies );
+   delete inStream;
+
+   Resource* copy = loader.getNextObject< Resource >();
+   if ( !copy )
+   {
+      return NULL;
+   }
+   copy->setFilePath( path );
+   copy->setCompressed( loader.wasCompressed() );
+
+   // make sure the referenced resources are loaded, and link them. The copy doesn't use them
+   // on its own behalf - whoever takes over its contents keeps them from being evicted
+   uint count = dependencies.size();
+   for ( uint i = 1; i < count; ++i )
+   {
+      Resource* dependency = resMgr.create( dependencies[i], true );
+      resMgr.release( dependency );
+   }
+
+   std::vector< ReflectionObject* > allLoadedObjects( loader.m_allLoadedObjects.begin(), loader.m_allLoadedObjects.end() );
+   ExternalDependenciesLinker linker( remappedDependencies );
+   linker.linkDependencies( allLoadedObjects );
+
+   uint allLoadedObjectsCount = allLoadedObjects.size();
+   for ( uint i = 0; i < allLoadedObjectsCount; ++i )
+   {
+      allLoadedObjects[i]->onObjectLoaded();
+   }
+
+   return copy;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -350,3 +505,12 @@ void ReflectionSerializationUtil::collectExternalDependencies( const ReflectionO
 }
 
 ///////////////////////////////////////////////////////////////////////////////
+
+InStream* ReflectionSerializationUtil::openResourceStream( const Filesystem& filesystem, const FilePath& path )
+{
+   std::string extension = path.extractExtension();
+   std::ios_base::openmode accessMode = Resource::getFileAccessMode( extension );
+   return openInStream( filesystem, path, accessMode );
+}
+
+///////////////////////////////////////////////////////////////////////////////
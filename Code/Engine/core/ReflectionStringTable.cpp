@@ -0,0 +1,119 @@
+#include "core.h"
+#include "core/ReflectionStringTable.h"
+#include "core/InStream.h"
+#include "core/OutStream.h"
+#include "core/IDString.h"
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+ReflectionStringTable::ReflectionStringTable()
+   : m_hasInvalidReferences( false )
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+uint ReflectionStringTable::add( const std::string& str )
+{
+   IndicesMap::iterator it = m_indices.find( str );
+   if ( it != m_indices.end() )
+   {
+      return it->second;
+   }
+
+   uint idx = m_strings.size();
+   m_strings.push_back( str );
+   m_stringIds.push_back( -1 );
+   m_indices.insert( std::make_pair( str, idx ) );
+
+   return idx;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+const std::string& ReflectionStringTable::getString( uint idx ) const
+{
+   // the index comes straight from the archive, so a corrupted file can contain just about anything
+   if ( idx >= m_strings.size() )
+   {
+      static std::string emptyString;
+      m_hasInvalidReferences = true;
+      return emptyString;
+   }
+
+   return m_strings[idx];
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+uint ReflectionStringTable::getStringId( uint idx ) const
+{
+   if ( idx >= m_strings.size() )
+   {
+      m_hasInvalidReferences = true;
+      return IDStringsPool::getInstance().registerString( "" );
+   }
+
+   uint& stringId = m_stringIds[idx];
+   if ( stringId == (uint)-1 )
+   {
+      stringId = IDStringsPool::getInstance().registerString( m_strings[idx].c_str() );
+   }
+
+   return stringId;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ReflectionStringTable::clear()
+{
+   m_indices.clear();
+   m_strings.clear();
+   m_stringIds.clear();
+   m_hasInvalidReferences = false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ReflectionStringTable::save( OutStream& stream ) const
+{
+   // the strings are written directly, so that the table can be saved to a stream
+   // that has a string table attached as well
+   uint count = m_strings.size();
+   stream.save( &count, sizeof( uint ) );
+   for ( uint i = 0; i < count; ++i )
+   {
+      const std::string& str = m_strings[i];
+      uint len = str.length();
+      stream.save( &len, sizeof( uint ) );
+      stream.save( str.c_str(), len );
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ReflectionStringTable::load( InStream& stream )
+{
+   clear();
+
+   uint count = 0;
+   stream.load( &count, sizeof( uint ) );
+   m_strings.resize( count );
+   m_stringIds.resize( count, -1 );
+
+   for ( uint i = 0; i < count; ++i )
+   {
+      uint len = 0;
+      stream.load( &len, sizeof( uint ) );
+
+      std::string& str = m_strings[i];
+      str.resize( len );
+      if ( len > 0 )
+      {
+         stream.load( &str[0], len );
+      }
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
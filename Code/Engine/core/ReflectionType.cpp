@@ -2,16 +2,24 @@
 #include "core/ReflectionType.h"
 #include "core/ReflectionTypeComponent.h"
 #include "core/Assert.h"
-#include "core/List.h"
 #include "core/MemoryPoolAllocator.h"
+#include "core/Thread.h"
 
 
 SerializationFlag SerializationFlag::s_theInstance;
 
 ///////////////////////////////////////////////////////////////////////////////
 
+namespace // anonymous
+{
+   // each thread deserializes its own objects, so the flag can't be shared between them
+   __declspec( thread ) bool g_serializationInProgress = false;
+
+} // anonymous
+
+///////////////////////////////////////////////////////////////////////////////
+
 SerializationFlag::SerializationFlag()
-   : m_serializationInProgress( false )
 {
 }
 
@@ -19,14 +27,14 @@ SerializationFlag::SerializationFlag()
 
 bool SerializationFlag::isSerializationInProgress()
 {
-   return m_serializationInProgress;
+   return g_serializationInProgress;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
 void SerializationFlag::flagSerializationInProgress( bool inProgress )
 {
-   m_serializationInProgress = inProgress;
+   g_serializationInProgress = inProgress;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -55,7 +63,11 @@ SerializableReflectionType::SerializableReflectionType( const std::string& name,
    , m_patchedName( patchedName )
    , m_instantiator( NULL )
    , m_patchedId( -1 )
-   , m_searchMemPool( new MemoryPool( 256 ) )
+   , m_searchMemPool( NULL )
+   , m_hierarchyIdx( -1 )
+   , m_definition( NULL )
+   , m_isDefined( false )
+   , m_ancestryVersion( -1 )
 {
    if ( !m_patchedName.empty() )
    {
@@ -90,22 +102,98 @@ void SerializableReflectionType::setupInstantiator( SerializableTypeInstantiator
 
 ///////////////////////////////////////////////////////////////////////////////
 
+void SerializableReflectionType::setupDefinition( TypeDefinition definition )
+{
+   m_definition = definition;
+   m_isDefined = false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void SerializableReflectionType::define() const
+{
+   if ( m_isDefined )
+   {
+      return;
+   }
+
+   // the types may be used by the resources loading thread as well
+   ReflectionTypesRegistry& typesRegistry = ReflectionTypesRegistry::getInstance();
+   CriticalSectionLock lock( *typesRegistry.m_definitionsLock );
+   if ( m_isDefined )
+   {
+      return;
+   }
+
+   SerializableReflectionType* definedType = const_cast< SerializableReflectionType* >( this );
+   if ( !m_searchMemPool )
+   {
+      definedType->m_searchMemPool = new MemoryPool( 256 );
+   }
+   if ( m_definition )
+   {
+      m_definition( *definedType );
+   }
+   m_isDefined = true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 bool SerializableReflectionType::isA( const ReflectionType& referenceType ) const
+{
+   const SerializableReflectionType* serializableRefType = dynamic_cast< const SerializableReflectionType* >( &referenceType );
+   if ( serializableRefType )
+   {
+      return isA( *serializableRefType );
+   }
+   else
+   {
+      // a type that's not serializable can't be a part of a serializable types hierarchy
+      return isExactlyA( referenceType );
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void SerializableReflectionType::rebuildAncestry() const
 {
    ReflectionTypesRegistry& typesRegistry = ReflectionTypesRegistry::getInstance();
 
-   List< const SerializableReflectionType*, MemoryPoolAllocator > bfs( typesRegistry.m_sharedMemoryPoolAllocator );
-   bfs.pushBack( this );
-   while ( !bfs.empty() )
+   // the types may be queried by the resources loading thread as well
+   CriticalSectionLock lock( *typesRegistry.m_definitionsLock );
+   uint hierarchyVersion = typesRegistry.m_hierarchyVersion;
+   if ( m_ancestryVersion == hierarchyVersion )
+   {
+      // another thread rebuilt it in the meantime
+      return;
+   }
+
+   std::vector< uint > ancestorsMask;
+   MembersMap hierarchyMembersMap;
+
+   // a breadth-first traversal - the queue is consumed from the front, but its entries aren't removed
+   std::vector< const SerializableReflectionType* > bfs;
+   bfs.push_back( this );
+   for ( uint queueIdx = 0; queueIdx < bfs.size(); ++queueIdx )
    {
-      const SerializableReflectionType* currType = bfs.front();
-      bfs.popFront();
+      const SerializableReflectionType* currType = bfs[queueIdx];
+      currType->define();
 
-      if ( currType->m_id == referenceType.m_id )
+      uint idx = currType->m_hierarchyIdx;
+      if ( idx != (uint)-1 )
       {
-         return true;
+         uint wordIdx = idx >> 5;
+         if ( wordIdx >= ancestorsMask.size() )
+         {
+            ancestorsMask.resize( wordIdx + 1, 0 );
+         }
+         ancestorsMask[wordIdx] |= 1u << ( idx & 31 );
       }
 
+      // members defined closer to this type take precedence, and since we're
+      // traversing the hierarchy breadth-first, those are the ones that get inserted first
+      hierarchyMembersMap.insert( currType->m_membersMap.begin(), currType->m_membersMap.end() );
+
       // gather the base types
       uint childrenCount = currType->m_baseTypesIds.size();
       for ( uint i = 0; i < childrenCount; ++i )
@@ -113,13 +201,15 @@ bool SerializableReflectionType::isA( const ReflectionType& referenceType ) cons
          const SerializableReflectionType* parentType = typesRegistry.findSerializable( currType->m_baseTypesIds[i] );
          if ( parentType )
          {
-            bfs.pushBack( parentType );
+            bfs.push_back( parentType );
          }
       }
    }
-   typesRegistry.m_sharedMemoryPool->reset();
 
-   return false;
+   // publish the version only once the rebuilt data is in place
+   m_ancestorsMask.swap( ancestorsMask );
+   m_hierarchyMembersMap.swap( hierarchyMembersMap );
+   m_ancestryVersion = hierarchyVersion;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -149,6 +239,7 @@ void SerializableReflectionType::addMemberField( ReflectionTypeComponent* member
    if ( member )
    {
       m_memberFields.push_back( member );
+      m_membersMap.insert( std::make_pair( member->m_id, member ) );
    }
 }
 
@@ -165,6 +256,8 @@ ReflectionTypeComponent* SerializableReflectionType::findMemberField( const std:
 
 ReflectionTypeComponent* SerializableReflectionType::findMemberField( uint memberId ) const
 {
+   define();
+
    // check if this is not one of the patched members
    NamesMap::const_iterator it = m_patchedMemberNames.find( memberId );
    if ( it != m_patchedMemberNames.end() )
@@ -174,17 +267,43 @@ ReflectionTypeComponent* SerializableReflectionType::findMemberField( uint membe
    }
 
    // find the member with a matching id
-   uint count = m_memberFields.size();
-   for ( uint i = 0; i < count; ++i )
+   MembersMap::const_iterator memberIt = m_membersMap.find( memberId );
+   if ( memberIt != m_membersMap.end() )
+   {
+      return memberIt->second;
+   }
+
+   // a member with such id is not defined
+   return NULL;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+ReflectionTypeComponent* SerializableReflectionType::findHierarchyMemberField( uint memberId ) const
+{
+   if ( m_ancestryVersion != ReflectionTypesRegistry::getInstance().m_hierarchyVersion )
+   {
+      rebuildAncestry();
+   }
+
+   MembersMap::const_iterator memberIt = m_hierarchyMembersMap.find( memberId );
+   if ( memberIt != m_hierarchyMembersMap.end() )
+   {
+      return memberIt->second;
+   }
+
+   // it may be one of the patched members - and those need to be looked up type by type
+   std::list< const SerializableReflectionType* > reflectionTypesList;
+   mapTypesHierarchy( reflectionTypesList );
+   for ( std::list< const SerializableReflectionType* >::const_iterator it = reflectionTypesList.begin(); it != reflectionTypesList.end(); ++it )
    {
-      if ( m_memberFields[i]->m_id == memberId )
+      ReflectionTypeComponent* member = (*it)->findMemberField( memberId );
+      if ( member )
       {
-         // found it
-         return m_memberFields[i];
+         return member;
       }
    }
 
-   // a member with such id is not defined
    return NULL;
 }
 
@@ -217,6 +336,7 @@ void SerializableReflectionType::mapTypesHierarchy( std::list< const Serializabl
    {
       const SerializableReflectionType* nextType = dfs.back();
       dfs.pop_back();
+      nextType->define();
       outReflectionTypesList.push_back( nextType );
 
       // go through the parent types
@@ -272,7 +392,8 @@ void SerializableReflectionType::collectProperties( void* hostObj, std::vector<
 void SerializableReflectionType::collectParents( std::vector< const SerializableReflectionType* >& outParentTypes ) const
 {
    const ReflectionTypesRegistry& registry = ReflectionTypesRegistry::getInstance();
-   
+   define();
+
    uint count = m_baseTypesIds.size();
    for ( uint i = 0; i < count; ++i )
    {
@@ -2,7 +2,7 @@
 #include "core/ReflectionTypesRegistry.h"
 #include "core/ReflectionType.h"
 #include "core/ReflectionEnum.h"
-#include "core/MemoryPoolAllocator.h"
+#include "core/Thread.h"
 #include "core/types.h"
 
 
@@ -12,13 +12,45 @@ ReflectionTypesRegistry* ReflectionTypesRegistry::s_theInstance = NULL;
 
 ///////////////////////////////////////////////////////////////////////////////
 
+TypesRegistration* TypesRegistration::s_first = NULL;
+TypesRegistration* TypesRegistration::s_last = NULL;
+
+///////////////////////////////////////////////////////////////////////////////
+
+TypesRegistration::TypesRegistration()
+   : m_next( NULL )
+{
+   if ( s_last )
+   {
+      s_last->m_next = this;
+   }
+   else
+   {
+      s_first = this;
+   }
+   s_last = this;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void TypesRegistration::registerAll()
+{
+   for ( TypesRegistration* registration = s_first; registration != NULL; registration = registration->m_next )
+   {
+      registration->registerTypes();
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 ReflectionTypesRegistry::ReflectionTypesRegistry()
-   : m_genericEnumType( NULL )
+   : m_hierarchyVersion( 0 )
+   , m_genericEnumType( NULL )
+   , m_nextHierarchyIdx( 0 )
 {
    m_genericEnumType = new ReflectionEnum( "ReflectionEnum" );
 
-   m_sharedMemoryPool = new MemoryPool( 2048 );
-   m_sharedMemoryPoolAllocator = new MemoryPoolAllocator( m_sharedMemoryPool );
+   m_definitionsLock = new CriticalSection();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -30,11 +62,8 @@ ReflectionTypesRegistry::~ReflectionTypesRegistry()
    delete m_genericEnumType;
    m_genericEnumType = NULL;
 
-   delete m_sharedMemoryPoolAllocator;
-   m_sharedMemoryPoolAllocator = NULL;
-
-   delete m_sharedMemoryPool;
-   m_sharedMemoryPool = NULL;
+   delete m_definitionsLock;
+   m_definitionsLock = NULL;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -125,6 +154,26 @@ void ReflectionTypesRegistry::getMatchingSerializableTypes( uint id, std::vector
 
 ///////////////////////////////////////////////////////////////////////////////
 
+void ReflectionTypesRegistry::defineAllTypes()
+{
+   for ( SerializableTypesMap::const_iterator it = m_serializableTypesMap.begin(); it != m_serializableTypesMap.end(); ++it )
+   {
+      it->second->define();
+   }
+
+   uint count = m_allTypes.size();
+   for ( uint i = 0; i < count; ++i )
+   {
+      ReflectionEnum* enumType = dynamic_cast< ReflectionEnum* >( m_allTypes[i] );
+      if ( enumType )
+      {
+         enumType->define();
+      }
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void ReflectionTypesRegistry::clear()
 {
    uint count = m_allTypes.size();
@@ -135,6 +184,9 @@ void ReflectionTypesRegistry::clear()
    m_allTypes.clear();
    m_externalTypesMap.clear();
    m_serializableTypesMap.clear();
+
+   m_nextHierarchyIdx = 0;
+   ++m_hierarchyVersion;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -2,6 +2,7 @@
 #include "core\Resource.h"
 #include "core\ResourcesManager.h"
 #include "core\ReflectionTypesRegistry.h"
+#include "core\ReflectionSaveCache.h"
 #include "core\Assert.h"
 
 
@@ -49,6 +50,12 @@ END_OBJECT()
 Resource::Resource( const FilePath& filePath )
 : m_filePath( filePath )
 , m_host( NULL )
+, m_saveCache( NULL )
+, m_isCompressed( false )
+, m_savedChangeStamp( 0 )
+, m_lastAccessStamp( 0 )
+, m_usersCount( 0 )
+, m_isReleased( false )
 {
 }
 
@@ -71,6 +78,9 @@ Resource::~Resource()
    }
    m_managedObjects.clear();
    m_freeIds.clear();
+
+   delete m_saveCache;
+   m_saveCache = NULL;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -102,6 +112,28 @@ void Resource::saveResource()
 
 ///////////////////////////////////////////////////////////////////////////////
 
+void Resource::setIncrementalSaving( bool enable )
+{
+   if ( enable && !m_saveCache )
+   {
+      m_saveCache = new ReflectionSaveCache();
+   }
+   else if ( !enable )
+   {
+      delete m_saveCache;
+      m_saveCache = NULL;
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+uint Resource::getMemoryUsage() const
+{
+   return sizeof( Resource ) + m_managedObjects.size() * sizeof( ResourceObject );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void Resource::setResourcesManager( ResourcesManager& mgr )
 {
    ASSERT_MSG( m_host == NULL, "This resource is already added to a resources manager" );
@@ -207,6 +239,7 @@ void Resource::addObject( ResourceObject* object )
       }
 
       object->setHostResource( *this, id );
+      markDirty();
    }
 }
 
@@ -234,6 +267,7 @@ void Resource::removeObject( int objectId )
 
    delete m_managedObjects[ objectId ];
    m_managedObjects[ objectId ] = NULL;
+   markDirty();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -254,6 +288,7 @@ void Resource::removeObjectExternally( int objectId )
 
    m_freeIds.push_back( objectId );
    m_managedObjects[ objectId ] = NULL;
+   markDirty();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -289,6 +324,43 @@ void Resource::finalizeResourceLoading()
    {
       onComponentAdded( *m_host->getComponent( i ) );
    }
+
+   // the resource is just as it was stored
+   markClean();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+bool Resource::isDirty() const
+{
+   return m_savedChangeStamp == 0 || getContentsChangeStamp() != m_savedChangeStamp;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void Resource::markClean()
+{
+   m_savedChangeStamp = getContentsChangeStamp();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+uint Resource::getContentsChangeStamp() const
+{
+   // the stamps only grow, so the most recent one changes whenever any of the objects does
+   uint changeStamp = getChangeStamp();
+
+   uint count = m_managedObjects.size();
+   for ( uint i = 0; i < count; ++i )
+   {
+      const ResourceObject* object = m_managedObjects[i];
+      if ( object && object->getChangeStamp() > changeStamp )
+      {
+         changeStamp = object->getChangeStamp();
+      }
+   }
+
+   return changeStamp;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -4,12 +4,17 @@
 #include "core/ReflectionTypeComponent.h"
 #include "core/ReflectionObject.h"
 #include "core/Resource.h"
+#include "core/ResourcesManager.h"
+#include "core/ReflectionLoader.h"
+#include "core/ReflectionSerializationUtil.h"
+#include "core/InStream.h"
 
 
 ///////////////////////////////////////////////////////////////////////////////
 
 ResourceDepenenciesMapper::ResourceDepenenciesMapper( std::vector< FilePath >& outExternalDependencies )
    : m_outExternalDependencies( outExternalDependencies )
+   , m_mappedPaths( outExternalDependencies.begin(), outExternalDependencies.end() )
 {
 }
 
@@ -40,6 +45,53 @@ void ResourceDepenenciesMapper::mapDependencies( const ReflectionObject* objectT
 
 ///////////////////////////////////////////////////////////////////////////////
 
+void ResourceDepenenciesMapper::mapFileDependencies( const Filesystem& filesystem, const FilePath& resourcePath, ResourcesManager* loadedResources )
+{
+   if ( !m_mappedPaths.insert( resourcePath ).second )
+   {
+      // it's already been mapped
+      return;
+   }
+
+   uint firstMappedPathIdx = m_outExternalDependencies.size();
+   m_outExternalDependencies.push_back( resourcePath );
+
+   // keep checking the size with each iteration - the array is going to grow
+   ReflectionLoader loader;
+   for( uint i = firstMappedPathIdx; i < m_outExternalDependencies.size(); ++i )
+   {
+      // copy the path - the array may get reallocated when it grows
+      FilePath path = m_outExternalDependencies[i];
+      if ( loadedResources && loadedResources->findResource( path ) )
+      {
+         // the resource won't have to be loaded, and neither will its dependencies
+         continue;
+      }
+
+      InStream* inStream = ReflectionSerializationUtil::openResourceStream( filesystem, path );
+      if ( !inStream )
+      {
+         continue;
+      }
+
+      // read the dependencies of the file alone, and filter out the ones that were mapped already
+      m_fileDependencies.clear();
+      loader.readExternalDependencies( *inStream, m_fileDependencies );
+      delete inStream;
+
+      uint dependenciesCount = m_fileDependencies.size();
+      for ( uint j = 0; j < dependenciesCount; ++j )
+      {
+         if ( m_mappedPaths.insert( m_fileDependencies[j] ).second )
+         {
+            m_outExternalDependencies.push_back( m_fileDependencies[j] );
+         }
+      }
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void ResourceDepenenciesMapper::analyzeDependency( const ReflectionObject* object )
 {
    if ( object->isA< Resource >() )
@@ -47,19 +99,11 @@ void ResourceDepenenciesMapper::analyzeDependency( const ReflectionObject* objec
       const Resource* resource = static_cast< const Resource* >( object );
       const FilePath& resourcePath = resource->getFilePath();
 
-      // verify that the path's not on the list already
-      uint count = m_outExternalDependencies.size();
-      for ( uint i = 0; i < count; ++i )
+      // add the path unless it's on the list already
+      if ( m_mappedPaths.insert( resourcePath ).second )
       {
-         if ( m_outExternalDependencies[i] == resourcePath )
-         {
-            // it's already on the list
-            return;
-         }
+         m_outExternalDependencies.push_back( resourcePath );
       }
-
-      // it's not on the list - add it
-      m_outExternalDependencies.push_back( resourcePath );
    }
 }
 
@@ -1,6 +1,7 @@
 #include "core.h"
 #include "core/ResourceHandle.h"
 #include "core/Resource.h"
+#include "core/ResourcesManager.h"
 
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -16,6 +17,8 @@ END_OBJECT();
 ResourceHandle::ResourceHandle( const std::string& resourcePath, int objectId )
    : m_resourcePath( resourcePath )
    , m_objectId( objectId )
+   , m_resource( NULL )
+   , m_resourcesGeneration( 0 )
 {
 
 }
@@ -27,6 +30,27 @@ void ResourceHandle::onObjectPreSave()
 
 }
 
+///////////////////////////////////////////////////////////////////////////////
+
+Resource* ResourceHandle::getResource() const
+{
+   ResourcesManager& resMgr = ResourcesManager::getInstance();
+
+   uint currentGeneration = resMgr.getResourcesGeneration();
+   if ( m_resource == NULL || m_resourcesGeneration != currentGeneration )
+   {
+      m_resource = resMgr.findResource( m_resourcePath );
+      m_resourcesGeneration = currentGeneration;
+   }
+   else
+   {
+      // the manager needs to know the resource is still in use
+      resMgr.touch( m_resource );
+   }
+
+   return m_resource;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,100 @@
+#include "core.h"
+#include "core/ResourceLoadingHandle.h"
+#include <algorithm>
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+ResourceLoadingHandle::ResourceLoadingHandle( const FilePath& path )
+   : m_path( path )
+   , m_state( RLS_PENDING )
+   , m_resource( NULL )
+   , m_referencesCounter( 1 )
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+ResourceLoadingHandle::~ResourceLoadingHandle()
+{
+   if ( m_resource )
+   {
+      m_resource->removeReference();
+      m_resource = NULL;
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ResourceLoadingHandle::attach( ResourceLoadingListener& listener )
+{
+   if ( m_state != RLS_PENDING )
+   {
+      // the loading's already finished
+      listener.onResourceLoaded( *this );
+      return;
+   }
+
+   std::vector< ResourceLoadingListener* >::iterator it = std::find( m_listeners.begin(), m_listeners.end(), &listener );
+   if ( it == m_listeners.end() )
+   {
+      m_listeners.push_back( &listener );
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ResourceLoadingHandle::detach( ResourceLoadingListener& listener )
+{
+   std::vector< ResourceLoadingListener* >::iterator it = std::find( m_listeners.begin(), m_listeners.end(), &listener );
+   if ( it != m_listeners.end() )
+   {
+      m_listeners.erase( it );
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ResourceLoadingHandle::addReference()
+{
+   ++m_referencesCounter;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ResourceLoadingHandle::removeReference()
+{
+   --m_referencesCounter;
+   if ( m_referencesCounter <= 0 )
+   {
+      delete this;
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ResourceLoadingHandle::complete( Resource* resource )
+{
+   // the handle keeps the resource alive, so that the manager doesn't evict it while it's being used
+   m_resource = resource;
+   if ( m_resource )
+   {
+      m_resource->addReference();
+   }
+   m_state = resource ? RLS_LOADED : RLS_FAILED;
+
+   // the listeners are notified only once
+   std::vector< ResourceLoadingListener* > listeners;
+   listeners.swap( m_listeners );
+
+   // a listener may release the handle, so make sure it outlives the notifications
+   addReference();
+   uint count = listeners.size();
+   for ( uint i = 0; i < count; ++i )
+   {
+      listeners[i]->onResourceLoaded( *this );
+   }
+   removeReference();
+}
+
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,119 @@
+#include "core.h"
+#include "core/ResourcesLoadingThread.h"
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+ResourcesLoadingThread::ResourcesLoadingThread()
+   : m_exit( false )
+{
+   start();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+ResourcesLoadingThread::~ResourcesLoadingThread()
+{
+   {
+      CriticalSectionLock lock( m_lock );
+      m_exit = true;
+   }
+   m_requestAdded.signal();
+   join();
+
+   deleteRequests( m_pendingRequests );
+   deleteRequests( m_completedRequests );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ResourcesLoadingThread::deleteRequests( std::list< Request* >& requests )
+{
+   for ( std::list< Request* >::iterator it = requests.begin(); it != requests.end(); ++it )
+   {
+      delete *it;
+   }
+   requests.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ResourcesLoadingThread::addRequest( Request* request )
+{
+   {
+      CriticalSectionLock lock( m_lock );
+      m_pendingRequests.push_back( request );
+   }
+   m_requestAdded.signal();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+ResourcesLoadingThread::Request* ResourcesLoadingThread::popCompletedRequest()
+{
+   CriticalSectionLock lock( m_lock );
+   if ( m_completedRequests.empty() )
+   {
+      return NULL;
+   }
+
+   Request* request = m_completedRequests.front();
+   m_completedRequests.pop_front();
+   return request;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ResourcesLoadingThread::waitForCompletedRequest()
+{
+   {
+      CriticalSectionLock lock( m_lock );
+      if ( !m_completedRequests.empty() )
+      {
+         return;
+      }
+   }
+
+   m_requestCompleted.wait();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ResourcesLoadingThread::run()
+{
+   while( true )
+   {
+      // take the next request
+      Request* request = NULL;
+      {
+         CriticalSectionLock lock( m_lock );
+         if ( m_exit )
+         {
+            break;
+         }
+
+         if ( !m_pendingRequests.empty() )
+         {
+            request = m_pendingRequests.front();
+            m_pendingRequests.pop_front();
+         }
+      }
+
+      if ( !request )
+      {
+         m_requestAdded.wait();
+         continue;
+      }
+
+      // only read the files - without accessing the resources manager, which can only be used from the main thread
+      request->m_prefetcher.prefetch( request->m_path );
+
+      {
+         CriticalSectionLock lock( m_lock );
+         m_completedRequests.push_back( request );
+      }
+      m_requestCompleted.signal();
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
@@ -4,8 +4,70 @@
 #include "core\ReflectionSerializationUtil.h"
 #include "core\Profiler.h"
 #include "core\Log.h"
+#include "core\ResourceLoadingHandle.h"
+#include "core\ResourcesLoadingThread.h"
+#include "core\MappedFile.h"
+#include "core\Thread.h"
+#include "core\ResourceDependenciesMapper.h"
+#include <algorithm>
 
 
+///////////////////////////////////////////////////////////////////////////////
+
+namespace // anonymous
+{
+   /**
+    * Runs the first stage of the imports, taking them from a list shared by all parsing threads.
+    */
+   class ImportsParser
+   {
+   private:
+      const std::vector< ResourceImporter* >&   m_importers;
+      CriticalSection                           m_lock;
+      uint                                      m_nextImporterIdx;
+
+   public:
+      ImportsParser( const std::vector< ResourceImporter* >& importers )
+         : m_importers( importers )
+         , m_nextImporterIdx( 0 )
+      {
+      }
+
+      void parse()
+      {
+         while( true )
+         {
+            uint importerIdx = 0;
+            {
+               CriticalSectionLock lock( m_lock );
+               importerIdx = m_nextImporterIdx++;
+            }
+
+            if ( importerIdx >= m_importers.size() )
+            {
+               break;
+            }
+            m_importers[importerIdx]->parse();
+         }
+      }
+   };
+
+   // -------------------------------------------------------------------------
+
+   class ImportsParsingThread : public Thread
+   {
+   private:
+      ImportsParser&    m_parser;
+
+   public:
+      ImportsParsingThread( ImportsParser& parser ) : m_parser( parser ) {}
+
+   protected:
+      void run() { m_parser.parse(); }
+   };
+
+} // anonymous
+
 ///////////////////////////////////////////////////////////////////////////////
 
 ResourcesManager* ResourcesManager::s_theInstance = new ResourcesManager();
@@ -14,15 +76,41 @@ ResourcesManager* ResourcesManager::s_theInstance = new ResourcesManager();
 
 ResourcesManager::ResourcesManager()
 : m_filesystem( new Filesystem() )
+, m_resourcesGeneration( 0 )
 , m_progressObserverCreator( NULL )
+, m_loadingThread( NULL )
+, m_memoryBudget( 0 )
+, m_accessCounter( 0 )
+, m_importCacheEnabled( true )
+, m_incrementalSaving( false )
+, m_importThreadsCount( 1 )
+, m_timeSinceLastEdit( 0.0f )
+, m_hotReloadDelay( 0.5f )
+, m_isSaving( false )
 {
    m_filesystem->attach( *this );
+
+   SYSTEM_INFO systemInfo;
+   GetSystemInfo( &systemInfo );
+   setImportThreadsCount( systemInfo.dwNumberOfProcessors );
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
 ResourcesManager::~ResourcesManager()
 {
+   // stop loading the resources - the thread uses the filesystem, and the loaded resources would have nowhere to go
+   delete m_loadingThread;
+   m_loadingThread = NULL;
+
+   uint pendingLoadsCount = m_pendingLoads.size();
+   for ( uint i = 0; i < pendingLoadsCount; ++i )
+   {
+      m_pendingLoads[i]->complete( NULL );
+      m_pendingLoads[i]->removeReference();
+   }
+   m_pendingLoads.clear();
+
    // delete the loaders
    for ( ResourceImportersMap::iterator itArr = m_importers.begin(); itArr != m_importers.end(); ++itArr )
    {
@@ -74,6 +162,10 @@ void ResourcesManager::reset()
    }
 
    m_resources.clear();
+   ++m_resourcesGeneration;
+
+   // there's nothing left to reload
+   m_editedFiles.clear();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -86,6 +178,12 @@ void ResourcesManager::setFilesystem( Filesystem* filesystem )
       return;
    }
 
+   // the resources that are being loaded come from the current filesystem - let them finish loading first,
+   // and stop the loading thread, since it uses the filesystem
+   finishLoading();
+   delete m_loadingThread;
+   m_loadingThread = NULL;
+
    // we need to delete all resources along with changing the filesystem
    reset();
 
@@ -146,6 +244,7 @@ bool ResourcesManager::registerNewResource( Resource* resource )
    resource->setFilePath( correctResourcePath );
    m_resources.insert( std::make_pair( correctResourcePath, resource ) );
    resource->setResourcesManager( *this );
+   touch( resource );
 
    return true;
 }
@@ -178,6 +277,7 @@ void ResourcesManager::moveResource( Resource* resource, const FilePath& newPath
    resource->setFilePath( correctResourcePath );
    m_resources.erase( it );
    m_resources.insert( std::make_pair( correctResourcePath, resource ) );
+   ++m_resourcesGeneration;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -189,6 +289,7 @@ Resource* ResourcesManager::findResource( const FilePath& name )
    ResourcesMap::iterator it = m_resources.find( name );
    if ( it != m_resources.end() )
    {
+      touch( it->second );
       return it->second;
    }
    else
@@ -246,9 +347,17 @@ Resource* ResourcesManager::create( const FilePath& filePath, bool loadOnly )
    PROFILED();
 
    Resource* res = findResource( filePath );
-   if ( res == NULL )
+   if ( res )
+   {
+      ++m_statistics.m_hits;
+
+      // whoever asked for it is going to use it
+      acquire( res );
+   }
+   else
    {
       // the resource doesn't exist yet - try loading it
+      ++m_statistics.m_misses;
       res = loadResource( filePath );
 
       if ( !res && !loadOnly )
@@ -270,6 +379,11 @@ Resource* ResourcesManager::create( const FilePath& filePath, bool loadOnly )
             res->saveResource();
          }
       }
+
+      if ( res )
+      {
+         acquire( res );
+      }
    }
    
    return res;
@@ -277,6 +391,103 @@ Resource* ResourcesManager::create( const FilePath& filePath, bool loadOnly )
 
 ///////////////////////////////////////////////////////////////////////////////
 
+ResourceLoadingHandle* ResourcesManager::loadAsync( const FilePath& filePath )
+{
+   PROFILED();
+
+   // if the resource is already being loaded, share the handle
+   uint pendingLoadsCount = m_pendingLoads.size();
+   for ( uint i = 0; i < pendingLoadsCount; ++i )
+   {
+      ResourceLoadingHandle* pendingHandle = m_pendingLoads[i];
+      if ( pendingHandle->getPath() == filePath )
+      {
+         pendingHandle->addReference();
+         return pendingHandle;
+      }
+   }
+
+   ResourceLoadingHandle* handle = new ResourceLoadingHandle( filePath );
+
+   Resource* res = findResource( filePath );
+   if ( res )
+   {
+      // the resource is already loaded
+      ++m_statistics.m_hits;
+      acquire( res );
+      handle->complete( res );
+      return handle;
+   }
+
+   if ( !m_loadingThread )
+   {
+      m_loadingThread = new ResourcesLoadingThread();
+   }
+
+   ++m_statistics.m_misses;
+
+   // the manager holds a reference to the handle until the loading finishes
+   handle->addReference();
+   m_pendingLoads.push_back( handle );
+   m_loadingThread->addRequest( new ResourcesLoadingThread::Request( *m_filesystem, filePath, handle ) );
+
+   return handle;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ResourcesManager::processLoadedResources()
+{
+   PROFILED();
+
+   if ( !m_loadingThread )
+   {
+      return;
+   }
+
+   ResourcesLoadingThread::Request* request = NULL;
+   while( ( request = m_loadingThread->popCompletedRequest() ) != NULL )
+   {
+      // deserialize the prefetched files and register the loaded resources - the requested one comes first
+      DeserializedResources resources;
+      ReflectionSerializationUtil::deserializeResources( *m_filesystem, request->m_path, resources, this, NULL, &request->m_prefetcher );
+
+      std::vector< Resource* > loadedResources;
+      ReflectionSerializationUtil::finishLoadingResources( resources, loadedResources );
+      Resource* res = resources.m_resources.empty() ? NULL : resources.m_resources[0];
+      if ( res )
+      {
+         // whoever asked for it is going to use it
+         acquire( res );
+      }
+
+      ResourceLoadingHandle* handle = request->m_handle;
+      delete request;
+
+      std::vector< ResourceLoadingHandle* >::iterator it = std::find( m_pendingLoads.begin(), m_pendingLoads.end(), handle );
+      if ( it != m_pendingLoads.end() )
+      {
+         m_pendingLoads.erase( it );
+      }
+
+      handle->complete( res );
+      handle->removeReference();
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ResourcesManager::finishLoading()
+{
+   while( !m_pendingLoads.empty() )
+   {
+      m_loadingThread->waitForCompletedRequest();
+      processLoadedResources();
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 Resource* ResourcesManager::loadResource( const FilePath& filePath )
 {
    PROFILED();
@@ -291,6 +502,444 @@ Resource* ResourcesManager::loadResource( const FilePath& filePath )
 
 ///////////////////////////////////////////////////////////////////////////////
 
+uint ResourcesManager::getMemoryUsage() const
+{
+   uint memoryUsage = 0;
+   for ( ResourcesMap::const_iterator it = m_resources.begin(); it != m_resources.end(); ++it )
+   {
+      memoryUsage += it->second->getMemoryUsage();
+   }
+
+   return memoryUsage;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace // anonymous
+{
+   struct EvictionCandidate
+   {
+      Resource*      m_resource;
+      uint           m_memoryUsage;
+      uint           m_lastAccessStamp;
+
+      EvictionCandidate( Resource* resource, uint memoryUsage, uint lastAccessStamp ) 
+         : m_resource( resource )
+         , m_memoryUsage( memoryUsage )
+         , m_lastAccessStamp( lastAccessStamp )
+      {}
+
+      bool operator<( const EvictionCandidate& rhs ) const
+      {
+         return m_lastAccessStamp < rhs.m_lastAccessStamp;
+      }
+   };
+
+} // anonymous
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ResourcesManager::enforceMemoryBudget()
+{
+   PROFILED();
+
+   if ( m_memoryBudget == 0 )
+   {
+      return;
+   }
+
+   uint memoryUsage = getMemoryUsage();
+   if ( memoryUsage <= m_memoryBudget )
+   {
+      return;
+   }
+
+   // the resources other resources depend on can't go, even if they were released - the resources
+   // that depend on them hold plain pointers to them. They can go once the resources depending on them do
+   std::unordered_set< FilePath, FilePathHash > requiredPaths;
+   std::vector< FilePath > dependencies;
+   for ( ResourcesMap::const_iterator it = m_resources.begin(); it != m_resources.end(); ++it )
+   {
+      dependencies.clear();
+      ResourceDepenenciesMapper mapper( dependencies );
+      mapper.mapDependencies( it->second );
+
+      uint count = dependencies.size();
+      for ( uint i = 0; i < count; ++i )
+      {
+         if ( dependencies[i] != it->first )
+         {
+            requiredPaths.insert( dependencies[i] );
+         }
+      }
+   }
+
+   // gather the resources that were released and that only the manager references - those are the ones we can evict.
+   // The changed resources stay, otherwise their changes would be lost
+   std::vector< EvictionCandidate > candidates;
+   for ( ResourcesMap::iterator it = m_resources.begin(); it != m_resources.end(); ++it )
+   {
+      Resource* resource = it->second;
+      if ( resource->m_isReleased && resource->getReferencesCount() == 1 && !resource->isDirty() && requiredPaths.find( it->first ) == requiredPaths.end() )
+      {
+         candidates.push_back( EvictionCandidate( resource, resource->getMemoryUsage(), resource->m_lastAccessStamp ) );
+      }
+   }
+
+   // evict the least recently used resources first
+   std::sort( candidates.begin(), candidates.end() );
+
+   uint count = candidates.size();
+   for ( uint i = 0; i < count && memoryUsage > m_memoryBudget; ++i )
+   {
+      const EvictionCandidate& candidate = candidates[i];
+      memoryUsage -= candidate.m_memoryUsage;
+
+      ++m_statistics.m_evictions;
+      m_statistics.m_evictedMemory += candidate.m_memoryUsage;
+
+      evict( candidate.m_resource );
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ResourcesManager::release( Resource* resource )
+{
+   if ( resource && resource->m_host == this && resource->m_usersCount > 0 )
+   {
+      --resource->m_usersCount;
+      resource->m_isReleased = ( resource->m_usersCount == 0 );
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ResourcesManager::acquire( Resource* resource )
+{
+   ++resource->m_usersCount;
+   resource->m_isReleased = false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ResourcesManager::touch( Resource* resource )
+{
+   resource->m_lastAccessStamp = ++m_accessCounter;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ResourcesManager::evict( Resource* resource )
+{
+   ResourcesMap::iterator it = m_resources.find( resource->getFilePath() );
+   if ( it == m_resources.end() || it->second != resource )
+   {
+      ASSERT_MSG( false, "Trying to evict a resource that's not managed by this manager" );
+      return;
+   }
+   m_resources.erase( it );
+   ++m_resourcesGeneration;
+
+   // inform the resource about the components being removed
+   unsigned int componentsCount = getComponentsCount();
+   for ( unsigned int compIdx = 0; compIdx < componentsCount; ++compIdx )
+   {
+      Component< ResourcesManager >* comp = getComponent( compIdx );
+      resource->onComponentRemoved( *comp );
+   }
+
+   resource->resetResourcesManager();
+   resource->removeReference();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ResourcesManager::processEditedFiles( float timeElapsed )
+{
+   if ( m_editedFiles.empty() )
+   {
+      return;
+   }
+
+   // wait until the files stop changing
+   m_timeSinceLastEdit += timeElapsed;
+   if ( m_timeSinceLastEdit < m_hotReloadDelay )
+   {
+      return;
+   }
+
+   reloadEditedResources();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace // anonymous
+{
+   struct ReloadCandidate
+   {
+      Resource*                        m_resource;
+      const std::vector< FilePath >*   m_dependencies;                  // the resource itself included
+      uint                             m_reloadedDependenciesCount;     // number of the reloaded resources it depends on ( itself included )
+
+      ReloadCandidate( Resource* resource, const std::vector< FilePath >* dependencies, uint reloadedDependenciesCount ) 
+         : m_resource( resource )
+         , m_dependencies( dependencies )
+         , m_reloadedDependenciesCount( reloadedDependenciesCount )
+      {}
+
+      bool operator<( const ReloadCandidate& rhs ) const
+      {
+         // a resource depends on more of the reloaded resources than any of its dependencies does
+         if ( m_reloadedDependenciesCount != rhs.m_reloadedDependenciesCount )
+         {
+            return m_reloadedDependenciesCount < rhs.m_reloadedDependenciesCount;
+         }
+         return m_resource->getFilePath().getRelativePath() < rhs.m_resource->getFilePath().getRelativePath();
+      }
+   };
+
+} // anonymous
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ResourcesManager::reloadEditedResources()
+{
+   PROFILED();
+
+   if ( m_editedFiles.empty() )
+   {
+      return;
+   }
+
+   // find the loaded resources that depend on the edited files, be it directly or through other 
+   // resources ( a resource is the first of its own dependencies )
+   std::vector< Resource* > affectedResources;
+   std::vector< std::vector< FilePath > > affectedResourcesDependencies;
+   EditedFiles affectedPaths;
+   for ( ResourcesMap::const_iterator it = m_resources.begin(); it != m_resources.end(); ++it )
+   {
+      std::vector< FilePath > dependencies;
+      ResourceDepenenciesMapper mapper( dependencies );
+      mapper.mapDependencies( it->second );
+
+      uint count = dependencies.size();
+      for ( uint i = 0; i < count; ++i )
+      {
+         if ( m_editedFiles.find( dependencies[i] ) != m_editedFiles.end() )
+         {
+            affectedResources.push_back( it->second );
+            affectedResourcesDependencies.push_back( dependencies );
+            affectedPaths.insert( it->first );
+            break;
+         }
+      }
+   }
+   EditedFiles editedFiles;
+   editedFiles.swap( m_editedFiles );
+
+   // reload the dependencies before the resources that depend on them, so that the resources that depend
+   // on them get to see their new contents
+   std::vector< ReloadCandidate > candidates;
+   uint affectedCount = affectedResources.size();
+   for ( uint i = 0; i < affectedCount; ++i )
+   {
+      const std::vector< FilePath >& dependencies = affectedResourcesDependencies[i];
+
+      uint reloadedDependenciesCount = 0;
+      uint count = dependencies.size();
+      for ( uint j = 0; j < count; ++j )
+      {
+         if ( affectedPaths.find( dependencies[j] ) != affectedPaths.end() )
+         {
+            ++reloadedDependenciesCount;
+         }
+      }
+      candidates.push_back( ReloadCandidate( affectedResources[i], &affectedResourcesDependencies[i], reloadedDependenciesCount ) );
+   }
+   std::sort( candidates.begin(), candidates.end() );
+
+   // reload the edited resources in place - whoever references them keeps a valid pointer
+   EditedFiles reloadedPaths;
+   for ( uint i = 0; i < affectedCount; ++i )
+   {
+      Resource* resource = candidates[i].m_resource;
+      const FilePath& path = resource->getFilePath();
+      if ( editedFiles.find( path ) == editedFiles.end() )
+      {
+         // only its dependencies were edited
+         continue;
+      }
+
+      if ( !resource->canReplaceContents() )
+      {
+         LOG( "Resource '" << path.getRelativePath() << "' can't be reloaded in place\n" );
+         continue;
+      }
+
+      Resource* loadedCopy = ReflectionSerializationUtil::loadResourceCopy( *resource );
+      if ( !loadedCopy )
+      {
+         // keep the current contents then
+         continue;
+      }
+
+      resource->replaceContents( *loadedCopy );
+      resource->markClean();
+      delete loadedCopy;
+
+      reloadedPaths.insert( path );
+      ++m_statistics.m_reloads;
+   }
+
+   // inform the listeners about the reloaded resources, and about the resources that depend on them - each of them once
+   uint listenersCount = m_reloadListeners.size();
+   for ( uint i = 0; i < affectedCount && listenersCount > 0; ++i )
+   {
+      const std::vector< FilePath >& dependencies = *candidates[i].m_dependencies;
+      uint count = dependencies.size();
+      for ( uint j = 0; j < count; ++j )
+      {
+         if ( reloadedPaths.find( dependencies[j] ) != reloadedPaths.end() )
+         {
+            for ( uint k = 0; k < listenersCount; ++k )
+            {
+               m_reloadListeners[k]->onResourceReloaded( *candidates[i].m_resource );
+            }
+            break;
+         }
+      }
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ResourcesManager::attachReloadListener( ResourcesReloadListener& listener )
+{
+   // check for duplicates
+   if ( std::find( m_reloadListeners.begin(), m_reloadListeners.end(), &listener ) != m_reloadListeners.end() )
+   {
+      // such a listener already exists
+      return;
+   }
+
+   m_reloadListeners.push_back( &listener );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ResourcesManager::detachReloadListener( ResourcesReloadListener& listener )
+{
+   std::vector< ResourcesReloadListener* >::iterator it = std::find( m_reloadListeners.begin(), m_reloadListeners.end(), &listener );
+   if ( it != m_reloadListeners.end() )
+   {
+      m_reloadListeners.erase( it );
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+FilePath ResourcesManager::getCachedImportPath( const ResourceImporter& importer, const char* resourceExtension ) const
+{
+   const FilePath& importedFilePath = importer.getImportedFilePath();
+
+   // hash the contents of the imported file ( FNV-1a )
+   uint contentsHash = 2166136261u;
+   uint contentsSize = 0;
+   MappedFile* importedFile = m_filesystem->map( importedFilePath );
+   if ( importedFile )
+   {
+      const byte* data = importedFile->getData();
+      contentsSize = importedFile->size();
+      for ( uint i = 0; i < contentsSize; ++i )
+      {
+         contentsHash ^= data[i];
+         contentsHash *= 16777619u;
+      }
+      delete importedFile;
+   }
+
+   // the imported resources are often named after the imported file, so the path needs to be a part of the key as well
+   char cachedImportName[128];
+   sprintf_s( cachedImportName, "%s%08x_%08x_%x_v%u.%s", IMPORT_CACHE_DIR, importedFilePath.getHash(), contentsHash, contentsSize, importer.getVersion(), resourceExtension );
+   return FilePath( cachedImportName );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+Resource* ResourcesManager::loadCachedImport( const FilePath& cachedImportPath )
+{
+   if ( !m_filesystem->doesExist( cachedImportPath ) )
+   {
+      ++m_statistics.m_importCacheMisses;
+      return NULL;
+   }
+
+   Resource* cachedImport = create( cachedImportPath, true );
+   if ( cachedImport )
+   {
+      ++m_statistics.m_importCacheHits;
+   }
+   else
+   {
+      ++m_statistics.m_importCacheMisses;
+   }
+   return cachedImport;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+Resource* ResourcesManager::storeCachedImport( Resource* importedResource )
+{
+   FilePath cachedImportPath = importedResource->getFilePath();
+   if ( !addResource( importedResource ) )
+   {
+      // the manager deleted the resource
+      return findResource( cachedImportPath );
+   }
+
+   m_filesystem->mkdir( FilePath( IMPORT_CACHE_DIR ) );
+   importedResource->saveResource();
+
+   return importedResource;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ResourcesManager::releaseCachedImport( Resource* cachedImport )
+{
+   // the results were merged into another resource - so unless someone else holds on to them, they can go
+   evict( cachedImport );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ResourcesManager::parseImports( const std::vector< ResourceImporter* >& importers )
+{
+   ImportsParser parser( importers );
+
+   // the calling thread parses the files as well, so a single file doesn't need a thread of its own
+   uint threadsCount = importers.size() < m_importThreadsCount ? importers.size() : m_importThreadsCount;
+   std::vector< ImportsParsingThread* > threads;
+   for ( uint i = 1; i < threadsCount; ++i )
+   {
+      ImportsParsingThread* thread = new ImportsParsingThread( parser );
+      thread->start();
+      threads.push_back( thread );
+   }
+
+   parser.parse();
+
+   uint count = threads.size();
+   for ( uint i = 0; i < count; ++i )
+   {
+      threads[i]->join();
+      delete threads[i];
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void ResourcesManager::save( const FilePath& filePath )
 {
    PROFILED();
@@ -302,9 +951,17 @@ void ResourcesManager::save( const FilePath& filePath )
       return;
    }
 
+   if ( m_incrementalSaving )
+   {
+      resourceToSave->setIncrementalSaving( true );
+   }
+
+   // the saved files reflect the resources we already have in memory - there's no need to reload them
+   m_isSaving = true;
    IProgressObserver* progressObserver = createObserver();
    ReflectionSerializationUtil::saveResource( resourceToSave, progressObserver );
    delete progressObserver;
+   m_isSaving = false;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -336,6 +993,7 @@ void ResourcesManager::free( Resource* resource )
    if ( it != m_resources.end() )
    {
       m_resources.erase( it );
+      ++m_resourcesGeneration;
    }
 }
 
@@ -409,6 +1067,7 @@ void ResourcesManager::onDirRemoved( const FilePath& dir )
       ResourcesMap::iterator it = m_resources.find( entriesToRemove[i] );
       Resource* res = it->second;
       m_resources.erase( it );
+      ++m_resourcesGeneration;
 
       res->resetResourcesManager();
       res->removeReference();
@@ -419,7 +1078,14 @@ void ResourcesManager::onDirRemoved( const FilePath& dir )
 
 void ResourcesManager::onFileEdited( const FilePath& path )
 {
-   // nothing to do here
+   if ( m_isSaving )
+   {
+      return;
+   }
+
+   // don't reload anything just yet - more files may be about to get edited
+   m_editedFiles.insert( path );
+   m_timeSinceLastEdit = 0.0f;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -432,6 +1098,7 @@ void ResourcesManager::onFileRemoved( const FilePath& path )
    {
       Resource* res = it->second;
       m_resources.erase( it );
+      ++m_resourcesGeneration;
 
       res->resetResourcesManager();
       res->removeReference();
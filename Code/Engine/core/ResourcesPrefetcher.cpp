@@ -0,0 +1,206 @@
+#include "core.h"
+#include "core\ResourcesPrefetcher.h"
+#include "core\ReflectionLoader.h"
+#include "core\ResourcesManager.h"
+#include "core\Resource.h"
+#include "core\Filesystem.h"
+#include "core\File.h"
+#include "core\MappedFile.h"
+#include "core\InMemoryStream.h"
+#include <algorithm>
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace // anonymous
+{
+   bool isLocatedBefore( const FilePath& lhs, const FilePath& rhs )
+   {
+      return lhs.getRelativePath() < rhs.getRelativePath();
+   }
+
+} // anonymous
+
+///////////////////////////////////////////////////////////////////////////////
+
+ResourcesPrefetcher::ResourcesPrefetcher( const Filesystem& filesystem )
+   : m_filesystem( filesystem )
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+ResourcesPrefetcher::~ResourcesPrefetcher()
+{
+   clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ResourcesPrefetcher::prefetch( const FilePath& resourcePath, ResourcesManager* loadedResources )
+{
+   m_dependencies.clear();
+
+   MappedPaths mappedPaths;
+   mappedPaths.insert( resourcePath );
+
+   std::vector< FilePath > level;
+   std::vector< FilePath > nextLevel;
+   std::vector< FilePath > fileDependencies;
+   level.push_back( resourcePath );
+
+   ReflectionLoader loader;
+   while ( !level.empty() )
+   {
+      // read the files in the order they're laid out in, rather than the order they'll be deserialized in
+      std::sort( level.begin(), level.end(), &isLocatedBefore );
+
+      uint count = level.size();
+      for ( uint i = 0; i < count; ++i )
+      {
+         const FilePath& path = level[i];
+         m_dependencies.push_back( path );
+
+         if ( loadedResources && loadedResources->findResource( path ) )
+         {
+            // the resource won't have to be loaded, and neither will its dependencies
+            continue;
+         }
+
+         PrefetchedFile* file = NULL;
+         PrefetchedFiles::const_iterator it = m_prefetchedFiles.find( path );
+         if ( it != m_prefetchedFiles.end() )
+         {
+            file = it->second;
+         }
+         else
+         {
+            file = read( path );
+            if ( !file )
+            {
+               continue;
+            }
+            m_prefetchedFiles.insert( std::make_pair( path, file ) );
+         }
+
+         // map the dependencies using the data we already have
+         fileDependencies.clear();
+         InMemoryStream stream( file->getData(), file->size() );
+         loader.readExternalDependencies( stream, fileDependencies );
+
+         uint dependenciesCount = fileDependencies.size();
+         for ( uint j = 0; j < dependenciesCount; ++j )
+         {
+            if ( mappedPaths.insert( fileDependencies[j] ).second )
+            {
+               nextLevel.push_back( fileDependencies[j] );
+            }
+         }
+      }
+
+      level.swap( nextLevel );
+      nextLevel.clear();
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+ResourcesPrefetcher::PrefetchedFile* ResourcesPrefetcher::read( const FilePath& path ) const
+{
+   std::string extension = path.extractExtension();
+   std::ios_base::openmode accessMode = Resource::getFileAccessMode( extension );
+
+   // binary files can be accessed through a memory mapping directly
+   if ( ( accessMode & std::ios_base::binary ) == std::ios_base::binary )
+   {
+      MappedFile* mappedFile = m_filesystem.map( path );
+      if ( mappedFile )
+      {
+         PrefetchedFile* prefetchedFile = new PrefetchedFile();
+         prefetchedFile->m_mappedFile = mappedFile;
+         return prefetchedFile;
+      }
+   }
+
+   File* file = m_filesystem.open( path, std::ios_base::in | accessMode );
+   if ( !file )
+   {
+      return NULL;
+   }
+
+   PrefetchedFile* prefetchedFile = new PrefetchedFile();
+   Array< byte >& contents = prefetchedFile->m_contents;
+   std::size_t fileSize = file->size();
+   if ( fileSize > 0 )
+   {
+      contents.resizeWithoutInitializing( fileSize );
+
+      // in the text mode, the number of the characters read may be smaller than the size of the file
+      std::size_t readSize = file->read( (byte*)contents, fileSize );
+      contents.resizeWithoutInitializing( readSize );
+   }
+   delete file;
+
+   return prefetchedFile;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+InStream* ResourcesPrefetcher::open( const FilePath& path ) const
+{
+   PrefetchedFiles::const_iterator it = m_prefetchedFiles.find( path );
+   if ( it == m_prefetchedFiles.end() )
+   {
+      return NULL;
+   }
+
+   const PrefetchedFile* file = it->second;
+   return new InMemoryStream( file->getData(), file->size() );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ResourcesPrefetcher::release( const FilePath& path )
+{
+   PrefetchedFiles::iterator it = m_prefetchedFiles.find( path );
+   if ( it != m_prefetchedFiles.end() )
+   {
+      delete it->second;
+      m_prefetchedFiles.erase( it );
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ResourcesPrefetcher::clear()
+{
+   for ( PrefetchedFiles::iterator it = m_prefetchedFiles.begin(); it != m_prefetchedFiles.end(); ++it )
+   {
+      delete it->second;
+   }
+   m_prefetchedFiles.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+ResourcesPrefetcher::PrefetchedFile::~PrefetchedFile()
+{
+   delete m_mappedFile;
+   m_mappedFile = NULL;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+const byte* ResourcesPrefetcher::PrefetchedFile::getData() const
+{
+   return m_mappedFile ? m_mappedFile->getData() : (const byte*)m_contents;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+uint ResourcesPrefetcher::PrefetchedFile::size() const
+{
+   return m_mappedFile ? (uint)m_mappedFile->size() : m_contents.size();
+}
+
+///////////////////////////////////////////////////////////////////////////////
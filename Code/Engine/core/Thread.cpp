@@ -0,0 +1,123 @@
+#include "core.h"
+#include "core/Thread.h"
+#include "core/Assert.h"
+#include <windows.h>
+#include <process.h>
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+CriticalSection::CriticalSection()
+   : m_section( new CRITICAL_SECTION )
+{
+   InitializeCriticalSection( static_cast< CRITICAL_SECTION* >( m_section ) );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+CriticalSection::~CriticalSection()
+{
+   CRITICAL_SECTION* section = static_cast< CRITICAL_SECTION* >( m_section );
+   DeleteCriticalSection( section );
+   delete section;
+   m_section = NULL;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void CriticalSection::enter()
+{
+   EnterCriticalSection( static_cast< CRITICAL_SECTION* >( m_section ) );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void CriticalSection::leave()
+{
+   LeaveCriticalSection( static_cast< CRITICAL_SECTION* >( m_section ) );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+ThreadEvent::ThreadEvent()
+{
+   m_event = CreateEvent( NULL, FALSE, FALSE, NULL );
+   ASSERT_MSG( m_event != NULL, "Failed to create an event" );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+ThreadEvent::~ThreadEvent()
+{
+   CloseHandle( m_event );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ThreadEvent::signal()
+{
+   SetEvent( m_event );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ThreadEvent::wait()
+{
+   WaitForSingleObject( m_event, INFINITE );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+Thread::Thread()
+   : m_thread( NULL )
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+Thread::~Thread()
+{
+   ASSERT_MSG( m_thread == NULL, "The thread wasn't joined before it was destroyed" );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void Thread::start()
+{
+   if ( m_thread )
+   {
+      ASSERT_MSG( false, "The thread is already running" );
+      return;
+   }
+
+   m_thread = (void*)_beginthreadex( NULL, 0, &Thread::threadProc, this, 0, NULL );
+   ASSERT_MSG( m_thread != NULL, "Failed to start a thread" );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void Thread::join()
+{
+   if ( !m_thread )
+   {
+      return;
+   }
+
+   WaitForSingleObject( m_thread, INFINITE );
+   CloseHandle( m_thread );
+   m_thread = NULL;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+unsigned int __stdcall Thread::threadProc( void* thread )
+{
+   static_cast< Thread* >( thread )->run();
+   return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
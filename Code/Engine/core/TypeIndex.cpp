@@ -0,0 +1,13 @@
+#include "core.h"
+#include "core\TypeIndex.h"
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+unsigned int TypeIndexCounter::allocate()
+{
+   static unsigned int s_nextIndex = 0;
+   return s_nextIndex++;
+}
+
+///////////////////////////////////////////////////////////////////////////////
@@ -5,6 +5,12 @@
 #include "core-Renderer/Skeleton.h"
 
 
+///////////////////////////////////////////////////////////////////////////////
+
+// max errors the imported animation keys can be compressed with
+#define BVH_ORIENTATION_TOLERANCE         0.002f      // radians
+#define BVH_TRANSLATION_TOLERANCE         0.01f
+
 ///////////////////////////////////////////////////////////////////////////////
 
 namespace // anonymous
@@ -14,22 +20,26 @@ namespace // anonymous
    public:
       virtual ~BVHNode() {}
 
-      virtual void parse( std::stringstream& inStream ) = 0;
+      virtual void parse( std::stringstream& inStream, std::string& outErrorMsg ) = 0;
 
       virtual void parseAnimationFrames( std::stringstream& inStream, float frameTime ) = 0;
 
       virtual SpatialEntity* instantiate( SkeletonAnimation& animation ) = 0;
 
    protected:
-      void validateLabel( std::stringstream& inStream, const char* label )
+      /**
+       * The files are parsed on worker threads, so instead of asserting, the method memorizes
+       * the first encountered error.
+       */
+      void validateLabel( std::stringstream& inStream, const char* label, std::string& outErrorMsg )
       {
          std::string tempText;
          inStream >> tempText;
-         if ( tempText != label )
+         if ( tempText != label && outErrorMsg.empty() )
          {
             char tmpStr[128];
             sprintf_s( tmpStr, "'%s' scope begin sign expected", label );
-            ASSERT_MSG( false, tmpStr );
+            outErrorMsg = tmpStr;
          }
       }
    };
@@ -42,9 +52,9 @@ namespace // anonymous
       Vector                m_offset;
 
    public:
-      void parse( std::stringstream& inStream )
+      void parse( std::stringstream& inStream, std::string& outErrorMsg )
       {
-         validateLabel( inStream, "{" );
+         validateLabel( inStream, "{", outErrorMsg );
 
          std::string variable;
          inStream >> variable;
@@ -54,7 +64,7 @@ namespace // anonymous
             inStream >> m_offset[0] >> m_offset[1] >> m_offset[2];
          }
 
-         validateLabel( inStream, "}" );
+         validateLabel( inStream, "}", outErrorMsg );
       }
 
       void parseAnimationFrames( std::stringstream& inStream, float frameTime )
@@ -100,7 +110,7 @@ namespace // anonymous
          m_children.clear();
       }
 
-      void parse( std::stringstream& inStream )
+      void parse( std::stringstream& inStream, std::string& outErrorMsg )
       {
          // extract the bone name
          inStream >> m_boneName;
@@ -110,7 +120,7 @@ namespace // anonymous
          m_keyframes = new BoneSRTAnimation( m_boneName );
 
          // parse the structure
-         validateLabel( inStream, "{" );
+         validateLabel( inStream, "{", outErrorMsg );
          
          std::string variable;
          while( true )
@@ -142,15 +152,15 @@ namespace // anonymous
             {
                BVHNode* child = new BVHBone();
                m_children.push_back( child );
-               child->parse( inStream );
+               child->parse( inStream, outErrorMsg );
             }
             else if ( variable == "End" )
             {
-               validateLabel( inStream, "Site" );
+               validateLabel( inStream, "Site", outErrorMsg );
 
                BVHNode* child = new BVHEndSite();
                m_children.push_back( child );
-               child->parse( inStream );
+               child->parse( inStream, outErrorMsg );
             }
          }
       }
@@ -253,84 +263,140 @@ namespace // anonymous
       }
    };
 
-   // -----------------------------------------------------------------------------------
+} // anonymous
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Contents of a parsed BVH file.
+ */
+class BVHHierarchy
+{
+private:
+   BVHBone*                m_skeletonRoot;
+   std::string             m_errorMsg;
 
-   class BVHHierarchy
+public:
+   BVHHierarchy()
+      : m_skeletonRoot( NULL )
    {
-   private:
-      BVHBone*                m_skeletonRoot;
-      ResourcesManager&       m_rm;
-      IProgressObserver&      m_observer;
-     
-   public:
-      BVHHierarchy( ResourcesManager& rm, IProgressObserver& observer )
-         : m_skeletonRoot( NULL )
-         , m_rm( rm )
-         , m_observer( observer )
+   }
+
+   ~BVHHierarchy()
+   {
+      delete m_skeletonRoot;
+      m_skeletonRoot = NULL;
+   }
+
+   /**
+    * Parses the skeleton and the motion data. It may run on a worker thread, so it doesn't
+    * report the errors - 'instantiate' does.
+    *
+    * @param inStream
+    */
+   void parse( std::stringstream& inStream )
+   {
+      // parse the skeleton
+      std::string hierarchyLabel, rootLabel;
+      inStream >> hierarchyLabel >> rootLabel;
+      if ( hierarchyLabel != "HIERARCHY" || rootLabel != "ROOT" )
       {
+         m_errorMsg = "Invalid BVH file - missing skeleton definition";
+         return;
       }
 
-      ~BVHHierarchy()
+      BVHBone* skeletonRoot = new BVHBone();
+      skeletonRoot->parse( inStream, m_errorMsg );
+
+      // parse the motion
+      std::string motionLabel;
+      inStream >> motionLabel;
+      if ( motionLabel != "MOTION" )
       {
-         delete m_skeletonRoot;
-         m_skeletonRoot = NULL;
+         m_errorMsg = "Invalid BVH file - missing motion definition";
+         delete skeletonRoot;
+         return;
       }
 
-      void parse( const char* animationName, std::stringstream& inStream, SkeletonAnimation& animation, Model& scene )
+      std::string framesLabel, frameTimeLabel0, frameTimeLabel1;
+      unsigned int framesCount = 0;
+      float frameTimeDelta = 0.f;
+
+      inStream >> framesLabel >> framesCount >> frameTimeLabel0 >> frameTimeLabel1 >> frameTimeDelta;
+      if ( framesLabel != "Frames:" || frameTimeLabel0 != "Frame" || frameTimeLabel1 != "Time:" )
       {
-         // parse the skeleton
-         m_observer.initialize( "Parsing the skeleton structure", 1 );
-         std::string hierarchyLabel, rootLabel;
-         inStream >> hierarchyLabel >> rootLabel;
-         if ( hierarchyLabel != "HIERARCHY" || rootLabel != "ROOT" )
-         {
-            ASSERT_MSG( false, "Invalid BVH file - missing skeleton definition" );
-            return;
-         }
+         m_errorMsg = "Invalid BVH file - missing frames definition";
+         delete skeletonRoot;
+         return;
+      }
 
-         BVHBone* skeletonRoot = new BVHBone();
-         skeletonRoot->parse( inStream );
-         m_observer.advance();
+      // load the frames
+      float currTime = 0.f;
+      for ( unsigned int frameIdx = 0; frameIdx < framesCount; ++frameIdx )
+      {
+         skeletonRoot->parseAnimationFrames( inStream, currTime );
+         currTime += frameTimeDelta;
+      }
 
-         // parse the motion
-         std::string motionLabel;
-         inStream >> motionLabel;
-         if ( motionLabel != "MOTION" )
-         {
-            ASSERT_MSG( false, "Invalid BVH file - missing motion definition" );
-            return;
-         }
+      m_skeletonRoot = skeletonRoot;
+   }
+
+   /**
+    * Creates the skeleton entities and fills the animation with the parsed keys.
+    * Can be called only once, since the keys are handed over to the animation.
+    *
+    * @param animation
+    * @param scene
+    * @param observer
+    */
+   void instantiate( SkeletonAnimation& animation, Model& scene, IProgressObserver& observer )
+   {
+      if ( !m_errorMsg.empty() )
+      {
+         ASSERT_MSG( false, m_errorMsg.c_str() );
+      }
 
-         std::string framesLabel, frameTimeLabel0, frameTimeLabel1;
-         unsigned int framesCount = 0;
-         float frameTimeDelta = 0.f;
+      if ( !m_skeletonRoot )
+      {
+         return;
+      }
 
-         inStream >> framesLabel >> framesCount >> frameTimeLabel0 >> frameTimeLabel1 >> frameTimeDelta;
-         if ( framesLabel != "Frames:" || frameTimeLabel0 != "Frame" || frameTimeLabel1 != "Time:" )
-         {
-            ASSERT_MSG( false, "Invalid BVH file - missing frames definition" );
-            return;
-         }
+      observer.initialize( "Initializing scene", 1 );
 
-         // load the frames
-         m_observer.initialize( "Parsing motion data", framesCount );
-         float currTime = 0.f;
-         for ( unsigned int frameIdx = 0; frameIdx < framesCount; ++frameIdx )
-         {
-            skeletonRoot->parseAnimationFrames( inStream, currTime );
-            currTime += frameTimeDelta;
-            m_observer.advance();
-         }
+      SpatialEntity* skeletonRootEntity = m_skeletonRoot->instantiate( animation );
+      scene.add( skeletonRootEntity );
 
-         // create an animation resource
-         m_observer.initialize( "Initializing scene", 1 );
-         
-         SpatialEntity* skeletonRootEntity = skeletonRoot->instantiate( animation );
-         scene.add( skeletonRootEntity );
+      delete m_skeletonRoot;
+      m_skeletonRoot = NULL;
+
+      observer.advance();
+   }
+};
 
-         m_observer.advance();
+///////////////////////////////////////////////////////////////////////////////
+
+namespace // anonymous
+{
+   BVHHierarchy* parseBVHFile( const Filesystem& fs, const FilePath& path )
+   {
+      BVHHierarchy* hierarchy = new BVHHierarchy();
+
+      // load the file contents into a string
+      File* bvhFile = fs.open( path );
+      if ( !bvhFile )
+      {
+         return hierarchy;
       }
-   };
+      StreamBuffer< char > fileReader( *bvhFile );
+      std::string fileContents = fileReader.getBuffer();
+      delete bvhFile;
+
+      // parse the bone structure
+      std::stringstream inStream( fileContents );
+      hierarchy->parse( inStream );
+
+      return hierarchy;
+   }
 
 } // anonymous
 
@@ -338,27 +404,37 @@ namespace // anonymous
 
 BVHModelLoader::BVHModelLoader( const FilePath& path, ResourcesManager& rm, IProgressObserver* observer )
    : TResourceImporter< Model >( path, rm, observer )
+   , m_hierarchy( NULL )
 {
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
-void BVHModelLoader::import( Model& scene )
+BVHModelLoader::~BVHModelLoader()
 {
-   const Filesystem& fs = m_rm.getFilesystem();
+   delete m_hierarchy;
+   m_hierarchy = NULL;
+}
+
+///////////////////////////////////////////////////////////////////////////////
 
-   // load the file contents into a string
-   File* bvhFile = fs.open( m_loadedFileName );
-   StreamBuffer< char > fileReader( *bvhFile );
-   std::string fileContents = fileReader.getBuffer();
-   delete bvhFile;
+void BVHModelLoader::parse()
+{
+   delete m_hierarchy;
+   m_hierarchy = parseBVHFile( m_rm.getFilesystem(), m_loadedFileName );
+}
 
-   // parse the bone structure
-   std::stringstream inStream( fileContents );
-   BVHHierarchy hierarchy( m_rm, *m_observer );
+///////////////////////////////////////////////////////////////////////////////
+
+void BVHModelLoader::import( Model& scene )
+{
+   if ( !m_hierarchy )
+   {
+      parse();
+   }
 
    SkeletonAnimation* animation = new SkeletonAnimation();
-   hierarchy.parse( m_loadedFileName.c_str(), inStream, *animation, scene );
+   m_hierarchy->instantiate( *animation, scene, *m_observer );
 
    delete animation;
    animation = NULL;
@@ -370,28 +446,41 @@ void BVHModelLoader::import( Model& scene )
 
 BVHSkeletonAnimationLoader::BVHSkeletonAnimationLoader( const FilePath& path, ResourcesManager& rm, IProgressObserver* observer )
    : TResourceImporter< SkeletonAnimation >( path, rm, observer )
+   , m_hierarchy( NULL )
 {
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
-void BVHSkeletonAnimationLoader::import( SkeletonAnimation& animation )
+BVHSkeletonAnimationLoader::~BVHSkeletonAnimationLoader()
+{
+   delete m_hierarchy;
+   m_hierarchy = NULL;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void BVHSkeletonAnimationLoader::parse()
 {
-   const Filesystem& fs = m_rm.getFilesystem();
+   delete m_hierarchy;
+   m_hierarchy = parseBVHFile( m_rm.getFilesystem(), m_loadedFileName );
+}
 
-   // load the file contents into a string
-   File* bvhFile = fs.open( m_loadedFileName );
-   StreamBuffer< char > fileReader( *bvhFile );
-   std::string fileContents = fileReader.getBuffer();
-   delete bvhFile;
+///////////////////////////////////////////////////////////////////////////////
 
-   // parse the bone structure
-   std::stringstream inStream( fileContents );
-   BVHHierarchy hierarchy( m_rm, *m_observer );
+void BVHSkeletonAnimationLoader::import( SkeletonAnimation& animation )
+{
+   if ( !m_hierarchy )
+   {
+      parse();
+   }
 
    Model* scene = new Model();
-   hierarchy.parse( m_loadedFileName.c_str(), inStream, animation, *scene );
+   m_hierarchy->instantiate( animation, *scene, *m_observer );
    delete scene;
+
+   // motion capture data samples every bone at every frame - most of those keys are redundant
+   animation.compress( BVH_ORIENTATION_TOLERANCE, BVH_TRANSLATION_TOLERANCE );
 }
 
 ///////////////////////////////////////////////////////////////////////////////
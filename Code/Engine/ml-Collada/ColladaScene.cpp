@@ -51,11 +51,18 @@ ColladaScene::~ColladaScene()
 
 ///////////////////////////////////////////////////////////////////////////////
 
-void ColladaScene::import( Model& scene )
+void ColladaScene::parse()
 {
+   delete m_document;
+   m_document = NULL;
+
    // load the file contents into a string
    const Filesystem& fs = m_rm.getFilesystem();
    File* sceneFile = fs.open( m_loadedFileName );
+   if ( !sceneFile )
+   {
+      return;
+   }
    StreamBuffer< char > fileReader( *sceneFile );
    std::string sceneContents = fileReader.getBuffer();
    delete sceneFile;
@@ -67,6 +74,23 @@ void ColladaScene::import( Model& scene )
    bool result = m_document->LoadFile( xmlStr, sceneContents.size(), TIXML_DEFAULT_ENCODING );
 
    if ( !result )
+   {
+      // 'import' will report it - this method may be running on a worker thread
+      delete m_document;
+      m_document = NULL;
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void ColladaScene::import( Model& scene )
+{
+   if ( !m_document )
+   {
+      parse();
+   }
+
+   if ( !m_document )
    {
       ASSERT_MSG( false, "Error loading an XML file" );
       return;
@@ -21,6 +21,8 @@ namespace // anonymous
 
 IWFScene::IWFScene( const FilePath& path, ResourcesManager& rm, IProgressObserver* observer )
    : TResourceImporter< Model >( path, rm, observer )
+   , m_sceneFile( NULL )
+   , m_loadError( S_OK )
 {
 }
 
@@ -28,17 +30,47 @@ IWFScene::IWFScene( const FilePath& path, ResourcesManager& rm, IProgressObserve
 
 IWFScene::~IWFScene()
 {
+   delete m_sceneFile;
+   m_sceneFile = NULL;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 
-void IWFScene::import( Model& scene )
+void IWFScene::parse()
 {
    const Filesystem& fs = m_rm.getFilesystem();
 
-   // load the IWF file
-   CFileIWF sceneFile;
-   sceneFile.Load( fs, m_loadedFileName );
+   delete m_sceneFile;
+   m_sceneFile = new CFileIWF();
+   m_loadError = S_OK;
+
+   // load the IWF file. The loader reports errors with exceptions, and this method may be running
+   // on a worker thread - so memorize the error and let 'import' rethrow it
+   try
+   {
+      m_sceneFile->Load( fs, m_loadedFileName );
+   }
+   catch ( HRESULT errCode )
+   {
+      m_loadError = errCode;
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void IWFScene::import( Model& scene )
+{
+   if ( !m_sceneFile )
+   {
+      parse();
+   }
+
+   if ( FAILED( m_loadError ) )
+   {
+      throw m_loadError;
+   }
+
+   CFileIWF& sceneFile = *m_sceneFile;
 
    // parse entities
    m_observer->initialize( "Importing entities", sceneFile.m_vpEntityList.size() );
@@ -8,6 +8,7 @@
 // Animation
 // ----------------------------------------------------------------------------
 #include "core-AI/SkeletonAnimationController.h"
+#include "core-AI/SkeletonPoseSampler.h"
 #include "core-AI/BoneEntity.h"
 // ----------------------------------------------------------------------------
 // -->Resources
@@ -5,6 +5,7 @@
 
 #include "core/MemoryRouter.h"
 #include "core/Array.h"
+#include "core/FastFloat.h"
 
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -18,22 +19,26 @@
  * public:
  *    void operator()( T& outValue, const T& start, const T& end, float percentage ) const;
  * };
+ *
+ * The keys can be stored in a more compact form than the one they are evaluated in - STORAGE
+ * needs to be implicitly convertible to and from T then ( see QuantizedQuaternion ).
  */
-template< typename T, typename LERP >
+template< typename T, typename LERP, typename STORAGE = T >
 class AnimationTimeline
 {
    DECLARE_ALLOCATOR( AnimationTimeline, AM_ALIGNED_16 );
 
 public:
    Array< float >          m_time;
-   Array< T >              m_keys;
+   Array< STORAGE >        m_keys;
 
 private:
    LERP                    m_lerp;
 
 public:
    /**
-    * Adds the specified key at the specified time.
+    * Adds the specified key at the specified time. Appending the keys in the chronological
+    * order takes a constant time.
     *
     * @param time
     * @param key
@@ -43,6 +48,9 @@ public:
    /**
     * Returns the key value at the specified time.
     *
+    * The index of the key span the previous lookup ended in speeds up the lookups made
+    * during a regular playback - any other lookup takes a logarithmic time.
+    *
     * @param lastCheckedKeyIdx
     * @param time
     * @param outKey
@@ -50,6 +58,42 @@ public:
     * @return  'true' if a value was found, 'false' otherwise
     */
    bool getKey( unsigned int& lastCheckedKeyIdx, float time, T& outKey ) const;
+
+   /**
+    * Returns the two keys the specified time falls between, and the factor the value
+    * at that time can be interpolated between them with. Allows to interpolate
+    * the keys of many timelines in one batch.
+    *
+    * @param lastCheckedKeyIdx
+    * @param time
+    * @param outStartKey
+    * @param outEndKey
+    * @param outLerpFactor
+    *
+    * @return  'true' if the keys were found, 'false' otherwise
+    */
+   bool getKeys( unsigned int& lastCheckedKeyIdx, float time, T& outStartKey, T& outEndKey, FastFloat& outLerpFactor ) const;
+
+   /**
+    * Removes the keys that can be interpolated from their neighbors with an error
+    * that doesn't exceed the specified tolerance. If all keys are that close to the first one,
+    * the timeline collapses to that single key.
+    *
+    * The kept keys are never more than 64 keys apart, which keeps the running time
+    * linear in the number of keys.
+    *
+    * The user needs to specify an ERROR functor with a signature:
+    * class ERROR
+    * {
+    * public:
+    *    float operator()( const T& value, const T& referenceValue ) const;
+    * };
+    *
+    * @param tolerance
+    * @param error         measures how much a value differs from the reference value
+    */
+   template< typename ERROR >
+   void removeRedundantKeys( float tolerance, const ERROR& error );
 };
 
 ///////////////////////////////////////////////////////////////////////////////
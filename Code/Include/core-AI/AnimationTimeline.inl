@@ -4,12 +4,13 @@
 
 #include "core/Assert.h"
 #include "core/FastFloat.h"
+#include <algorithm>
 
 
 ///////////////////////////////////////////////////////////////////////////////
 
-template< typename T, typename LERP >
-void AnimationTimeline< T, LERP >::addKey( float time, const T& key )
+template< typename T, typename LERP, typename STORAGE >
+void AnimationTimeline< T, LERP, STORAGE >::addKey( float time, const T& key )
 {
    // time needs to be specified in range <0, inf )
    if ( time < 0.0f )
@@ -17,45 +18,34 @@ void AnimationTimeline< T, LERP >::addKey( float time, const T& key )
       time = 0.0f;
    }
 
-   // find the first appropriate time to insert the orientation key at
+   // the keys are usually added in the chronological order
    unsigned int count = m_time.size();
-   unsigned int idx = 0;
-   bool replace = false;
-   for ( idx = 0; idx < count; ++idx )
+   if ( count == 0 || m_time.back() < time )
    {
-      // find the first entry larger than the specified time, and insert directly before it
-      if ( m_time[idx] == time )
-      {
-         replace = true;
-         break;
-      }
-      else if ( m_time[idx] > time )
-      {
-         replace = false;
-         break;
-      }
+      m_time.push_back( time );
+      m_keys.push_back( key );
+      return;
    }
 
-   if ( replace )
+   // find the first key that's not earlier than the specified time
+   const float* times = m_time;
+   unsigned int idx = std::lower_bound( times, times + count, time ) - times;
+   if ( m_time[idx] == time )
    {
-      ASSERT_MSG( idx < count, "Trying to replace a non-existent key" );
       m_keys[idx] = key;
+      return;
    }
-   else
+
+   // insert the key directly before it
+   m_time.push_back( time );
+   m_keys.push_back( key );
+   for ( unsigned int i = count; i > idx; --i )
    {
-      if ( idx < count )
-      {
-         // this is the very first key
-         m_time.push_front( time );
-         m_keys.push_front( key );
-      }
-      else
-      {
-         // this is the very last key
-         m_time.push_back( time );
-         m_keys.push_back( key );
-      }
+      m_time[i] = m_time[i - 1];
+      m_keys[i] = m_keys[i - 1];
    }
+   m_time[idx] = time;
+   m_keys[idx] = key;
 
    // make sure there's the same number of entries in both list that describe the orientation timeline
    ASSERT_MSG( m_time.size() == m_keys.size(), "Animation timeline discrepancy" );
@@ -63,22 +53,28 @@ void AnimationTimeline< T, LERP >::addKey( float time, const T& key )
 
 ///////////////////////////////////////////////////////////////////////////////
 
-template< typename T, typename LERP >
-bool AnimationTimeline< T, LERP >::getKey( unsigned int& lastCheckedKeyIdx, float time, T& outKey ) const
+template< typename T, typename LERP, typename STORAGE >
+bool AnimationTimeline< T, LERP, STORAGE >::getKey( unsigned int& lastCheckedKeyIdx, float time, T& outKey ) const
 {
-   if ( m_keys.empty() )
+   T startKey, endKey;
+   FastFloat lerpFactor;
+   if ( !getKeys( lastCheckedKeyIdx, time, startKey, endKey, lerpFactor ) )
    {
       return false;
    }
 
-   if ( time <= 0.0f )
-   {
-      // fetch the first key
-      outKey = m_keys[ 0 ];
-   }
-   else if ( time >= m_time.back() )
+   m_lerp( outKey, startKey, endKey, lerpFactor );
+   return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+template< typename T, typename LERP, typename STORAGE >
+bool AnimationTimeline< T, LERP, STORAGE >::getKeys( unsigned int& lastCheckedKeyIdx, float time, T& outStartKey, T& outEndKey, FastFloat& outLerpFactor ) const
+{
+   if ( m_keys.empty() )
    {
-      outKey = m_keys.back();
+      return false;
    }
 
    // verify if the passed index is within the animation bounds
@@ -89,37 +85,133 @@ bool AnimationTimeline< T, LERP >::getKey( unsigned int& lastCheckedKeyIdx, floa
       lastCheckedKeyIdx = 0;
    }
 
-   // find the time
-   FastFloat ffTime;
+   // outside of the timeline the value of the nearest key is used
+   if ( count == 1 || time <= m_time[ 0 ] )
+   {
+      outStartKey = m_keys[ 0 ];
+      outEndKey = m_keys[ 0 ];
+      outLerpFactor = Float_0;
+      return true;
+   }
+   else if ( time >= m_time.back() )
+   {
+      outStartKey = m_keys.back();
+      outEndKey = m_keys.back();
+      outLerpFactor = Float_0;
+      return true;
+   }
+
+   // the key span the last lookup ended in is the most probable one, followed by the next one
+   // - check them first, and resort to a binary search only after a jump in time
+   unsigned int lastIdx = lastCheckedKeyIdx;
+   if ( lastIdx + 1 < count && m_time[ lastIdx ] <= time && time < m_time[ lastIdx + 1 ] )
+   {
+      // still in the same span
+   }
+   else if ( lastIdx + 2 < count && m_time[ lastIdx + 1 ] <= time && time < m_time[ lastIdx + 2 ] )
+   {
+      ++lastIdx;
+   }
+   else
+   {
+      // the time is within the timeline bounds, so there's always a key later than it
+      const float* times = m_time;
+      lastIdx = ( std::upper_bound( times, times + count, time ) - times ) - 1;
+   }
+   unsigned int nextIdx = lastIdx + 1;
+
+   FastFloat ffTime, lastTime, nextTime, duration;
    ffTime.setFromFloat( time );
+   lastTime.setFromFloat( m_time[ lastIdx ] );
+   nextTime.setFromFloat( m_time[ nextIdx ] );
+
+   duration.setSub( nextTime, lastTime );
+   ASSERT_MSG( duration > Float_0, "Two keys can't occupy the same time frame" );
+   outLerpFactor.setSub( ffTime, lastTime );
+   outLerpFactor.div( duration );
+
+   outStartKey = m_keys[ lastIdx ];
+   outEndKey = m_keys[ nextIdx ];
+   lastCheckedKeyIdx = lastIdx;
+
+   return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
 
-   unsigned lastIdx, nextIdx;
-   FastFloat lastTime, nextTime, lerpFactor, duration;
-   lastIdx = lastCheckedKeyIdx;
+template< typename T, typename LERP, typename STORAGE > template< typename ERROR >
+void AnimationTimeline< T, LERP, STORAGE >::removeRedundantKeys( float tolerance, const ERROR& error )
+{
+   unsigned int count = m_time.size();
+   if ( count < 2 )
+   {
+      return;
+   }
+
+   // the error is measured against the values the keys are sampled with, so decode them first
+   Array< T > values( count );
    for ( unsigned int i = 0; i < count; ++i )
    {
-      nextIdx = ( lastIdx + 1 ) % count;
-      lastTime.setFromFloat( m_time[ lastIdx ] );
-      nextTime.setFromFloat( m_time[ nextIdx ] );
+      values.push_back( m_keys[i] );
+   }
+
+   Array< float > reducedTime( count );
+   Array< STORAGE > reducedKeys( count );
+   reducedTime.push_back( m_time[0] );
+   reducedKeys.push_back( m_keys[0] );
+
+   // a track that doesn't change is represented by its first key only
+   bool isConstant = true;
+   for ( unsigned int i = 1; i < count && isConstant; ++i )
+   {
+      isConstant = error( values[i], values[0] ) <= tolerance;
+   }
 
-      if ( lastTime <= ffTime && ffTime < nextTime )
+   if ( !isConstant )
+   {
+      // extend the span that starts at the last kept key for as long as all the keys it spans
+      // can be interpolated between its ends. Every extension checks all the keys the span covers,
+      // so the spans are limited in length - otherwise a long, smooth track ( a mocap recording )
+      // would take a quadratic time to process
+      const unsigned int maxSpanLength = 64;
+
+      T interpolatedValue;
+      FastFloat spanStart, spanDuration, lerpFactor;
+      unsigned int anchorIdx = 0;
+      for ( unsigned int endIdx = 2; endIdx < count; ++endIdx )
       {
-         duration.setSub( nextTime, lastTime );
-         ASSERT_MSG( duration > Float_0, "Two keys can't occupy the same time frame" );
-         lerpFactor.setSub( ffTime, lastTime );
-         lerpFactor.div( duration );
-
-         // we found our key space
-         m_lerp( outKey, m_keys[ lastIdx ], m_keys[ nextIdx ], lerpFactor );
-         lastCheckedKeyIdx = lastIdx;
-         break;
+         spanStart.setFromFloat( m_time[anchorIdx] );
+         spanDuration.setFromFloat( m_time[endIdx] );
+         spanDuration.sub( spanStart );
+
+         bool canSkip = ( endIdx - anchorIdx ) <= maxSpanLength;
+         for ( unsigned int i = anchorIdx + 1; i < endIdx && canSkip; ++i )
+         {
+            lerpFactor.setFromFloat( m_time[i] );
+            lerpFactor.sub( spanStart );
+            lerpFactor.div( spanDuration );
+
+            m_lerp( interpolatedValue, values[anchorIdx], values[endIdx], lerpFactor );
+            canSkip = error( interpolatedValue, values[i] ) <= tolerance;
+         }
+
+         if ( !canSkip )
+         {
+            // the key preceding the span end can't be skipped
+            anchorIdx = endIdx - 1;
+            reducedTime.push_back( m_time[anchorIdx] );
+            reducedKeys.push_back( m_keys[anchorIdx] );
+         }
       }
 
-
-      lastIdx = nextIdx;
+      reducedTime.push_back( m_time[count - 1] );
+      reducedKeys.push_back( m_keys[count - 1] );
    }
 
-   return true;
+   m_time.clear();
+   m_time.copyFrom( reducedTime );
+   m_keys.clear();
+   m_keys.copyFrom( reducedKeys );
 }
 
 ///////////////////////////////////////////////////////////////////////////////
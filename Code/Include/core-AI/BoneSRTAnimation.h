@@ -6,6 +6,7 @@
 #include "core-AI/AnimationTimeline.h"
 #include "core/Vector.h"
 #include "core/Quaternion.h"
+#include "core/QuantizedQuaternion.h"
 #include <string>
 #include <vector>
 
@@ -13,6 +14,7 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 class BoneSRTAnimationPlayer;
+struct Transform;
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -48,11 +50,14 @@ private:
    };
 
 private:
-   std::string                                        m_boneName;
-   float                                              m_duration;
+   std::string                                                       m_boneName;
+   float                                                             m_duration;
 
-   AnimationTimeline< Quaternion, QuatLerp >          m_orientation;
-   AnimationTimeline< Vector, VecLerp >               m_translation;
+   AnimationTimeline< Quaternion, QuatLerp, QuantizedQuaternion >    m_rotation;
+   AnimationTimeline< Vector, VecLerp >                              m_translation;
+
+   // orientation keys stored by the older versions of the resource, converted when the animation gets loaded
+   Array< Quaternion >                                               m_legacyOrientationKeys;
 
 public:
    /**
@@ -78,6 +83,24 @@ public:
     */
    void addTranslationKey( float time, const Vector& translation );
 
+   /**
+    * Removes the keys that can be interpolated from the neighboring keys with an error smaller than
+    * the specified tolerance, and collapses the tracks that don't change at all to a single key.
+    *
+    * Mind that the orientation keys are quantized anyway ( see QuantizedQuaternion::getMaxError ).
+    *
+    * @param orientationTolerance      max rotation error, expressed in radians
+    * @param translationTolerance      max translation error
+    */
+   void compress( float orientationTolerance, float translationTolerance );
+
+   /**
+    * Replaces the keys of this track with the keys of the specified track.
+    *
+    * @param rhs
+    */
+   void copyKeys( const BoneSRTAnimation& rhs );
+
    /**
     * Returns the stream duration expressed in seconds.
     */
@@ -116,7 +139,7 @@ public:
    /**
     * Returns the number of orientation keys.
     */
-   inline unsigned int getOrientationKeysCount() const { return m_orientation.m_keys.size(); }
+   inline unsigned int getOrientationKeysCount() const { return m_rotation.m_keys.size(); }
 
    /**
     * Returns a requested orientation key.
@@ -168,6 +191,16 @@ private:
     */
    bool getOrientation( unsigned int& lastCheckedKeyIdx, float time, Quaternion& outOrientation ) const;
 
+   /**
+    * Returns the translation keys the specified time falls between ( see AnimationTimeline::getKeys ).
+    */
+   bool getTranslationKeys( unsigned int& lastCheckedKeyIdx, float time, Vector& outStartKey, Vector& outEndKey, FastFloat& outLerpFactor ) const;
+
+   /**
+    * Returns the orientation keys the specified time falls between ( see AnimationTimeline::getKeys ).
+    */
+   bool getOrientationKeys( unsigned int& lastCheckedKeyIdx, float time, Quaternion& outStartKey, Quaternion& outEndKey, FastFloat& outLerpFactor ) const;
+
 private:
    void updateDuration();
 };
@@ -213,6 +246,40 @@ public:
     * @return  'true' if a value was found, 'false' otherwise
     */
    bool getOrientation( float time, Quaternion& outOrientation );
+
+   /**
+    * Returns the transform the bone undergoes at the specified time - the orientation
+    * followed by the translation. The components the animation doesn't define are
+    * left as identity.
+    *
+    * @param time
+    * @param outTransform
+    */
+   void getTransform( float time, Transform& outTransform );
+
+   /**
+    * Returns the translation keys the specified time falls between, and the factor the translation
+    * at that time can be interpolated between them with. If the animation doesn't define
+    * the translation, both keys are set to zero.
+    *
+    * @param time
+    * @param outStartKey
+    * @param outEndKey
+    * @param outLerpFactor
+    */
+   void getTranslationKeys( float time, Vector& outStartKey, Vector& outEndKey, FastFloat& outLerpFactor );
+
+   /**
+    * Returns the orientation keys the specified time falls between, and the factor the orientation
+    * at that time can be interpolated between them with. If the animation doesn't define
+    * the orientation, both keys are set to identity.
+    *
+    * @param time
+    * @param outStartKey
+    * @param outEndKey
+    * @param outLerpFactor
+    */
+   void getOrientationKeys( float time, Quaternion& outStartKey, Quaternion& outEndKey, FastFloat& outLerpFactor );
 };
 
 ///////////////////////////////////////////////////////////////////////////////
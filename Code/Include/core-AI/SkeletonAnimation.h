@@ -24,6 +24,9 @@ private:
    float                                  m_animationLength;
    std::vector< BoneSRTAnimation* >       m_boneAnimations;
 
+   // tracks that are no longer a part of the animation, but may still be played by the existing players
+   std::vector< BoneSRTAnimation* >       m_retiredBoneAnimations;
+
 public:
    /**
     * Constructor.
@@ -61,7 +64,15 @@ public:
    void addTranslationKey( const std::string& boneName, float frameTime, const Vector& translation );
 
    /**
-    * Resets the animation contents.
+    * Compresses the animation keys of all bones ( see BoneSRTAnimation::compress ).
+    *
+    * @param orientationTolerance      max rotation error, expressed in radians
+    * @param translationTolerance      max translation error
+    */
+   void compress( float orientationTolerance, float translationTolerance );
+
+   /**
+    * Resets the animation contents. The players initialized with the animation become invalid.
     */
    void clear();
 
@@ -92,6 +103,15 @@ public:
     * @param outNames
     */
    void collectBonesNames( std::vector< std::string>& outNames ) const;
+
+   // -------------------------------------------------------------------------
+   // Resource implementation
+   // -------------------------------------------------------------------------
+   inline bool canMergeContents() const { return true; }
+   void mergeContents( Resource& rhs );
+   inline bool canReplaceContents() const { return true; }
+   void replaceContents( Resource& rhs );
+   uint getMemoryUsage() const;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
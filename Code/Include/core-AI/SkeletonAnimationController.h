@@ -5,13 +5,15 @@
 #include "core-MVC\Entity.h"
 #include "core\Node.h"
 #include "core\Matrix.h"
+#include "core\Transform.h"
+#include "core-AI\SkeletonPoseSampler.h"
 #include <vector>
+#include <string>
 
 
 ///////////////////////////////////////////////////////////////////////////////
 
 class SkeletonAnimation;
-class BoneSRTAnimationPlayer;
 class SpatialEntity;
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -21,12 +23,35 @@ class SpatialEntity;
  *
  * The hierarchy of nodes it will animate is supplied by the parent
  * entity it gets attached to.
+ *
+ * The animation source can be overlaid with animation layers. Each layer blends its pose
+ * over the pose of the layers below it, with its own weight, and only for the bones its mask selects.
+ * The layers with zero weight aren't sampled at all, and neither are the ones covered
+ * by a layer that overrides the entire pose.
+ * The layers are a runtime setup - only the animation source gets serialized.
  */
 class SkeletonAnimationController : public Entity
 {
    DECLARE_ALLOCATOR( SkeletonAnimationController, AM_DEFAULT );
    DECLARE_CLASS()
 
+private:
+   struct AnimationLayer
+   {
+      DECLARE_ALLOCATOR( AnimationLayer, AM_ALIGNED_16 );
+
+      SkeletonAnimation*                     m_source;
+      float                                  m_weight;
+      std::vector< std::string >             m_boneMask;       // names of the blended bones - all bones are blended if it's empty
+
+      float                                  m_trackTime;
+      SkeletonPoseSampler                    m_pose;
+      Array< FastFloat >                     m_boneWeights;    // 1 for the bones the layer blends, 0 for the rest
+      bool                                   m_coversAllBones;
+
+      AnimationLayer( SkeletonAnimation* source, float weight, const std::vector< std::string >& boneMask );
+   };
+
 private:
    // static data
    SkeletonAnimation*                        m_source;
@@ -34,8 +59,19 @@ private:
    // runtime data
    SpatialEntity*                            m_parent;
    std::vector< Node* >                      m_skeleton;
-   std::vector< BoneSRTAnimationPlayer* >    m_bonePlayers;
    Array< Matrix >                           m_referenceMtcs;
+   Array< Transform >                        m_referencePose;
+   Array< bool >                             m_scaledReferenceBones;   // a Transform can't express a scale, so these bones are animated using the reference matrices
+   Array< bool >                             m_animatedBones;
+
+   SkeletonPoseSampler                       m_pose;
+   std::vector< AnimationLayer* >            m_layers;
+
+   // the blended pose, padded to a multiple of four bones just like the sampled poses
+   Array< Quaternion >                       m_rotations;
+   Array< Vector >                           m_translations;
+   Array< FastFloat >                        m_blendFactors;
+
    float                                     m_trackTime;
    bool                                      m_pause;
  
@@ -75,6 +111,51 @@ public:
     */
    void setAnimationSource( SkeletonAnimation& source );
 
+   // ----------------------------------------------------------------------
+   // Animation layers
+   // ----------------------------------------------------------------------
+   /**
+    * Adds an animation layer, which will be blended over all the layers added before it.
+    *
+    * @param source           animation the layer plays
+    * @param weight           blend weight, from the <0, 1> range
+    * @return                 index of the new layer
+    */
+   unsigned int addLayer( SkeletonAnimation& source, float weight = 1.0f );
+
+   /**
+    * Removes all animation layers.
+    */
+   void clearLayers();
+
+   /**
+    * Returns the number of animation layers.
+    */
+   inline unsigned int getLayersCount() const { return m_layers.size(); }
+
+   /**
+    * Sets the weight the layer gets blended with.
+    *
+    * @param layerIdx
+    * @param weight           blend weight, from the <0, 1> range - 0 disables the layer
+    */
+   void setLayerWeight( unsigned int layerIdx, float weight );
+
+   /**
+    * Returns the weight the layer gets blended with.
+    *
+    * @param layerIdx
+    */
+   inline float getLayerWeight( unsigned int layerIdx ) const { return m_layers[layerIdx]->m_weight; }
+
+   /**
+    * Restricts the layer to the specified bones.
+    *
+    * @param layerIdx
+    * @param boneNames        names of the bones the layer should blend - all of them if the list is empty
+    */
+   void setLayerBoneMask( unsigned int layerIdx, const std::vector< std::string >& boneNames );
+
 protected:
    // ----------------------------------------------------------------------
    // Object implementation
@@ -91,6 +172,30 @@ protected:
 
 private:
    void onDataChanged();
+
+   /**
+    * Samples the animation source and the contributing layers, and blends their poses into m_rotations and m_translations.
+    */
+   void samplePose();
+
+   /**
+    * Blends the pose sampled by the layer over the pose blended so far.
+    *
+    * @param layer
+    */
+   void blendLayer( const AnimationLayer& layer );
+
+   /**
+    * Maps the layer onto the skeleton.
+    *
+    * @param layer
+    */
+   void initializeLayer( AnimationLayer& layer );
+
+   /**
+    * Finds out which bones are animated by the source or any of the layers.
+    */
+   void mapAnimatedBones();
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,93 @@
+/// @file   core-AI/SkeletonPoseSampler.h
+/// @brief  samples the pose of a skeleton from an animation
+#pragma once
+
+#include "core\MemoryRouter.h"
+#include "core\Array.h"
+#include "core\Quaternion.h"
+#include "core\Vector.h"
+#include "core\FastFloat.h"
+#include <vector>
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+class SkeletonAnimation;
+class BoneSRTAnimationPlayer;
+class Node;
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Samples the pose of a skeleton from an animation.
+ *
+ * The pose is sampled into separate arrays of components, so that the bones can be interpolated
+ * four at a time. The arrays are padded to a multiple of four entries, and the bones the animation
+ * doesn't define stay in the identity pose.
+ */
+class SkeletonPoseSampler
+{
+   DECLARE_ALLOCATOR( SkeletonPoseSampler, AM_ALIGNED_16 );
+
+private:
+   std::vector< BoneSRTAnimationPlayer* >    m_bonePlayers;
+
+   Array< Quaternion >                       m_startRotations;
+   Array< Quaternion >                       m_endRotations;
+   Array< FastFloat >                        m_rotationFactors;
+   Array< Quaternion >                       m_rotations;
+   Array< Vector >                           m_startTranslations;
+   Array< Vector >                           m_endTranslations;
+   Array< FastFloat >                        m_translationFactors;
+   Array< Vector >                           m_translations;
+
+public:
+   SkeletonPoseSampler();
+   ~SkeletonPoseSampler();
+
+   /**
+    * Prepares the sampler to sample the specified animation.
+    *
+    * @param animation
+    * @param skeleton         bones of the animated skeleton
+    */
+   void initialize( const SkeletonAnimation& animation, const std::vector< Node* >& skeleton );
+
+   /**
+    * Prepares the sampler for sampling a skeleton with the specified number of bones, none of which is animated.
+    *
+    * @param bonesCount
+    */
+   void reset( unsigned int bonesCount );
+
+   /**
+    * Samples the animation keys of all bones and interpolates them.
+    *
+    * @param time
+    */
+   void samplePose( float time );
+
+   /**
+    * Tells if the animation defines the motion of the specified bone.
+    *
+    * @param boneIdx
+    */
+   inline bool isBoneAnimated( unsigned int boneIdx ) const { return boneIdx < m_bonePlayers.size() && m_bonePlayers[boneIdx] != NULL; }
+
+   /**
+    * Returns the sampled rotations of the bones ( padded to a multiple of four entries ).
+    */
+   inline Array< Quaternion >& getRotations() { return m_rotations; }
+   inline const Array< Quaternion >& getRotations() const { return m_rotations; }
+
+   /**
+    * Returns the sampled translations of the bones ( padded to a multiple of four entries ).
+    */
+   inline Array< Vector >& getTranslations() { return m_translations; }
+   inline const Array< Vector >& getTranslations() const { return m_translations; }
+
+private:
+   void deletePlayers();
+};
+
+///////////////////////////////////////////////////////////////////////////////
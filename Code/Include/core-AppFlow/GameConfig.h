@@ -6,6 +6,11 @@
 #include "core/FilePath.h"
 
 
+///////////////////////////////////////////////////////////////////////////////
+
+// name of the archive the deployed game resources are packed into
+#define GAME_RESOURCES_ARCHIVE      "game.pak"
+
 ///////////////////////////////////////////////////////////////////////////////
 
 /**
@@ -145,6 +145,14 @@ public:
     */
    unsigned int getViewsCount() const;
 
+   // -------------------------------------------------------------------------
+   // Resource implementation
+   // -------------------------------------------------------------------------
+   inline bool canMergeContents() const { return true; }
+   void mergeContents( Resource& rhs );
+   inline bool canReplaceContents() const { return true; }
+   void replaceContents( Resource& rhs );
+
    // -------------------------------------------------------------------------
    // Serializable implementation
    // -------------------------------------------------------------------------
@@ -36,7 +36,14 @@ public:
     *
     * @param script
     */
-   inline void setScript( const std::string& script ) { m_script = script; }
+   inline void setScript( const std::string& script ) { m_script = script; markDirty(); }
+
+   // -------------------------------------------------------------------------
+   // Resource implementation
+   // -------------------------------------------------------------------------
+   inline bool canReplaceContents() const { return true; }
+   void replaceContents( Resource& rhs );
+   uint getMemoryUsage() const;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -41,6 +41,8 @@ public:
    // Resource implementation
    // -------------------------------------------------------------------------
    void onResourceLoaded( ResourcesManager& mgr );
+   inline bool canReplaceContents() const { return true; }
+   void replaceContents( Resource& rhs );
 
 protected:
    // -------------------------------------------------------------------------
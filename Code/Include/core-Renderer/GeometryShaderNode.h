@@ -66,6 +66,11 @@ public:
    void onPropertyChanged( ReflectionProperty& property );
 
 protected:
+   // -----------------------------------------------------------------
+   // GraphBuilderNode implementation
+   // -----------------------------------------------------------------
+   void onSocketsChanged() { markDirty(); }
+
    /**
     * Called in order to initialize node implementation's specific runtime data layout.
     *
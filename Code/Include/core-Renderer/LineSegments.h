@@ -95,6 +95,11 @@ public:
    const BoundingVolume& getBoundingVolume();
    void render( Renderer& renderer );
 
+   // -------------------------------------------------------------------------
+   // Resource implementation
+   // -------------------------------------------------------------------------
+   uint getMemoryUsage() const;
+
 private:
    /**
     * Recalculates the bounding volume.
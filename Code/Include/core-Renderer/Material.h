@@ -42,6 +42,9 @@ public:
    // Resource implementation
    // -------------------------------------------------------------------------
    void onResourceLoaded( ResourcesManager& mgr );
+   inline bool canReplaceContents() const { return true; }
+   void replaceContents( Resource& rhs );
+   uint getMemoryUsage() const;
 
 protected:
    // -------------------------------------------------------------------------
@@ -102,7 +102,7 @@ public:
    /**
     * Returns an instance of surface properties of this material instance ( non-const version )
     */
-   inline SurfaceProperties& accessSurfaceProperties() { notify( MIO_MAT_CHANGED ); return m_surfaceProperties; }
+   inline SurfaceProperties& accessSurfaceProperties() { markDirty(); notify( MIO_MAT_CHANGED ); return m_surfaceProperties; }
 
    /**
     * Returns an instance of surface properties of this material instance.
@@ -122,7 +122,7 @@ public:
     * @param textureUsage
     * @param texture
     */
-   inline void setTexture( MaterialTextures textureUsage, Texture* texture ) { m_texture[textureUsage] = texture; notify( MIO_MAT_CHANGED ); }
+   inline void setTexture( MaterialTextures textureUsage, Texture* texture ) { m_texture[textureUsage] = texture; markDirty(); notify( MIO_MAT_CHANGED ); }
 
    /**
     * Returns the runtime data buffer.
@@ -182,7 +182,7 @@ public:
     *
     * @param stageIdx
     */
-   inline TextureStageParams& changeTextureStage( unsigned int stageIdx ) { setDirty(); return m_textureStages[stageIdx]; }
+   inline TextureStageParams& changeTextureStage( unsigned int stageIdx ) { setDirty(); markDirty(); return m_textureStages[stageIdx]; }
 
    /**
     * Returns the name of a texture stage.
@@ -199,7 +199,7 @@ public:
    /**
     * Returns the drawing params (non-const version) so they can be changed.
     */
-   inline PixelShaderParams& changeParams() { setDirty(); return m_params; }
+   inline PixelShaderParams& changeParams() { setDirty(); markDirty(); return m_params; }
 
    /**
     * Returns the name of the shader entry function
@@ -230,6 +230,9 @@ public:
    // Resource implementation
    // -------------------------------------------------------------------------
    void onResourceLoaded( ResourcesManager& mgr );
+   inline bool canReplaceContents() const { return true; }
+   void replaceContents( Resource& rhs );
+   uint getMemoryUsage() const;
 
 private:
    void parseTextureStages();
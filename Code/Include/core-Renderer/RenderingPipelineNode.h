@@ -81,6 +81,10 @@ public:
    void onPropertyChanged( ReflectionProperty& property );
 
 protected:
+   // -------------------------------------------------------------------------
+   // GraphBuilderNode implementation
+   // -------------------------------------------------------------------------
+   void onSocketsChanged() { markDirty(); }
 
    /**
     * Called when the rendering mechanism creates a data layout for the runtime data.
@@ -91,10 +91,22 @@ public:
     */
    const Matrix& getInvBindPoseMtx( const std::string& boneName ) const;
 
+   /**
+    * Returns the inverted bind pose matrices of all bones, indexed the same way the bones are.
+    */
+   inline const Array< Matrix >& getInvBindPoseMatrices() const { return m_invBoneMatrices; }
+
    /**
     * Returns the weights assigned to a mesh vertices.
     */
    inline const std::vector< VertexWeight >& getVertexWeights() const { return m_weights; }
+
+   // -------------------------------------------------------------------------
+   // Resource implementation
+   // -------------------------------------------------------------------------
+   inline bool canReplaceContents() const { return true; }
+   void replaceContents( Resource& rhs );
+   uint getMemoryUsage() const;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
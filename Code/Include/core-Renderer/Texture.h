@@ -33,6 +33,9 @@ private:
    unsigned int      m_width;
    unsigned int      m_height;
 
+   // size of the image the texture was last created from
+   mutable uint      m_imageSize;
+
 public:
    /**
     * Constructor.
@@ -45,7 +48,7 @@ public:
     *
     * @param texPath
     */
-   inline void setImagePath( const FilePath& texPath ) { setDirty(); m_texFileName = texPath; }
+   inline void setImagePath( const FilePath& texPath ) { setDirty(); markDirty(); m_texFileName = texPath; }
 
    /**
     * Returns the name of the image file.
@@ -57,7 +60,7 @@ public:
     *
     * @param usage
     */
-   inline void setUsage( TextureUsage usage ) { setDirty(); m_usage = usage; }
+   inline void setUsage( TextureUsage usage ) { setDirty(); markDirty(); m_usage = usage; }
 
    /**
     * Returns texture usage.
@@ -84,6 +87,11 @@ public:
     * Returns the height of the texture.
     */
    inline unsigned int getHeight() const { return m_height; }
+
+   // -------------------------------------------------------------------------
+   // Resource implementation
+   // -------------------------------------------------------------------------
+   uint getMemoryUsage() const;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -89,6 +89,13 @@ public:
     */
    void setFaces( const Face* arrFaces, uint facesCount );
 
+   // -------------------------------------------------------------------------
+   // Resource implementation
+   // -------------------------------------------------------------------------
+   inline bool canReplaceContents() const { return true; }
+   void replaceContents( Resource& rhs );
+   uint getMemoryUsage() const;
+
    // -------------------------------------------------------------------------
    // GeometryResource implementation
    // -------------------------------------------------------------------------
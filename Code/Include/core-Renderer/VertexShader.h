@@ -114,6 +114,13 @@ public:
    // -------------------------------------------------------------------------
    void onObjectLoaded();
 
+   // -------------------------------------------------------------------------
+   // Resource implementation
+   // -------------------------------------------------------------------------
+   inline bool canReplaceContents() const { return true; }
+   void replaceContents( Resource& rhs );
+   uint getMemoryUsage() const;
+
 private:
    void parseTechniques();
    void parseConstants();
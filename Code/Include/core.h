@@ -31,8 +31,11 @@
 // Filesystem
 // ----------------------------------------------------------------------------
 #include "core\File.h"
+#include "core\MappedFile.h"
 #include "core\Filesystem.h"
 #include "core\FilesystemSection.h"
+#include "core\FilesystemArchive.h"
+#include "core\FilesystemIndex.h"
 #include "core\StreamBuffer.h"
 #include "core\FilePath.h"
 #include "core\FilesystemUtils.h"
@@ -94,6 +97,7 @@
 #include "core\UniqueObject.h"
 #include "core\StringUtils.h"
 #include "core\Singleton.h"
+#include "core\Thread.h"
 #include "core\IDString.h"
 
 // ----------------------------------------------------------------------------
@@ -126,9 +130,12 @@
 // -->Serialization
 // ----------------------------------------------------------------------------
 #include "core/ReflectionSaver.h"
+#include "core/ReflectionSaveCache.h"
+#include "core/ReflectionStringTable.h"
 #include "core/ReflectionLoader.h"
 #include "core/ReflectionObjectsTracker.h"
 #include "core/ReflectionSerializationUtil.h"
+#include "core/ReflectionArchiveCooker.h"
 
 // ----------------------------------------------------------------------------
 // Resources
@@ -138,7 +145,10 @@
 #include "core\ResourceManagerComponent.h"
 #include "core\ResourceStorage.h"
 #include "core\ResourceHandle.h"
+#include "core\ResourceLoadingHandle.h"
+#include "core\ResourcesLoadingThread.h"
 #include "core\ResourceImporter.h"
+#include "core\ResourcesPrefetcher.h"
 // ----------------------------------------------------------------------------
 // -->DependenciesMapper
 // ----------------------------------------------------------------------------
@@ -172,7 +182,12 @@
 #include "core/InArrayStream.h"
 #include "core/OutArrayStream.h"
 #include "core/InFileStream.h"
+#include "core/InMappedFileStream.h"
+#include "core/InMemoryStream.h"
 #include "core/OutFileStream.h"
+#include "core/InCompressedStream.h"
+#include "core/OutCompressedStream.h"
+#include "core/LZCompressor.h"
 
 // ----------------------------------------------------------------------------
 // Timer
@@ -185,6 +200,7 @@
 // ----------------------------------------------------------------------------
 #include "core\Component.h"
 #include "core\ComponentsManager.h"
+#include "core\TypeIndex.h"
 // ----------------------------------------------------------------------------
 // -->SingletonsManager
 // ----------------------------------------------------------------------------
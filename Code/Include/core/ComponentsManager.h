@@ -4,12 +4,43 @@
 #define _COMPONENTS_MANAGER_H
 
 #include "core\Component.h"
+#include "core\TypeIndex.h"
 #include <vector>
 
 
 ///////////////////////////////////////////////////////////////////////////////
 
-class SingletonsManager;
+/**
+ * A handle to a service registered with a ComponentsManager.
+ *
+ * It remains valid throughout the lifetime of the manager that issued it,
+ * and always points to the currently registered instance of the service,
+ * so it can be cached instead of querying the manager each time.
+ */
+template< typename T >
+class ServiceHandle
+{
+private:
+   void* const*                           m_service;
+
+public:
+   /**
+    * Constructor.
+    *
+    * @param service    address of the manager's service slot
+    */
+   ServiceHandle( void* const* service = NULL ) : m_service( service ) {}
+
+   /**
+    * Tells whether the service is currently registered.
+    */
+   inline bool isSet() const { return m_service != NULL && *m_service != NULL; }
+
+   /**
+    * Returns the registered service instance, or NULL if there's none.
+    */
+   inline T* get() const { return m_service ? reinterpret_cast< T* >( *m_service ) : NULL; }
+};
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -24,6 +55,11 @@ class SingletonsManager;
  * On the other hand we have components - each component type can have many 
  * instances registered with the same manager. Each component has a name,
  * so components can be queried using that name or by their type.
+ *
+ * Both the services and the queries for components of a particular type
+ * are indexed by the TypeIndex of the queried type, so they take constant time
+ * ( the first query for components of a given type sets up a cache that's 
+ * then kept up to date as the components are added and removed ).
  */
 template < typename Derived >
 class ComponentsManager
@@ -33,9 +69,58 @@ class ComponentsManager
 public:
    typedef std::vector< Component< Derived >* >   ComponentsArr;
 
+private:
+   /**
+    * Components of a specific type, kept up to date as the components
+    * are added to and removed from the manager.
+    */
+   class TypedComponents
+   {
+   public:
+      virtual ~TypedComponents() {}
+
+      virtual void onComponentAdded( Component< Derived >* component ) = 0;
+
+      virtual void onComponentRemoved( Component< Derived >* component ) = 0;
+
+      virtual void clear() = 0;
+   };
+
+   template< typename T >
+   class TTypedComponents : public TypedComponents
+   {
+      DECLARE_ALLOCATOR( TTypedComponents, AM_DEFAULT );
+
+   public:
+      std::vector< T* >                   m_components;
+
+   public:
+      void onComponentAdded( Component< Derived >* component );
+      void onComponentRemoved( Component< Derived >* component );
+      void clear() { m_components.clear(); }
+   };
+
+   /**
+    * Everything the manager knows about a particular type.
+    */
+   struct TypeSlot
+   {
+      DECLARE_ALLOCATOR( TypeSlot, AM_DEFAULT );
+
+      void*                               m_service;
+      TypedComponents*                    m_components;
+
+      TypeSlot() : m_service( NULL ), m_components( NULL ) {}
+      ~TypeSlot() { delete m_components; }
+   };
+
 private:
    ComponentsArr                          m_comps;
-   SingletonsManager*                     m_services;
+
+   // slots are indexed with the TypeIndex of the type they describe, and
+   // they're never released before the manager is, so that the addresses of their
+   // members can be handed out as handles
+   mutable std::vector< TypeSlot* >       m_typeSlots;
 
 public:
    virtual ~ComponentsManager();
@@ -99,6 +184,17 @@ public:
    template< typename T >
    void findComponents( std::vector< T* >& outComponents ) const;
 
+   /**
+    * Returns all registered components with the specified type.
+    *
+    * The returned collection remains valid throughout the lifetime of the manager
+    * and is kept up to date, so the reference can be cached by the caller.
+    *
+    * @param T                type of the component
+    */
+   template< typename T >
+   const std::vector< T* >& getComponents() const;
+
    // -------------------------------------------------------------------------
    // Services management
    // -------------------------------------------------------------------------
@@ -145,6 +241,16 @@ public:
    template < typename T >
    T& requestService();
 
+   /**
+    * Returns a handle to the service of the specified type. The handle
+    * can be cached - it will always point to the currently registered instance
+    * of the service.
+    *
+    * @param T          type of the service
+    */
+   template < typename T >
+   ServiceHandle< T > getServiceHandle();
+
 protected:
    /**
     * Constructor.
@@ -171,6 +277,18 @@ protected:
 
 private:
    void notifyAboutService( void* service );
+
+   /**
+    * Returns a slot assigned to the specified type, creating one if necessary.
+    */
+   template< typename T >
+   TypeSlot& getTypeSlot() const;
+
+   /**
+    * Returns a slot assigned to the specified type, or NULL if one hasn't been created yet.
+    */
+   template< typename T >
+   TypeSlot* findTypeSlot() const;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -2,7 +2,6 @@
 #error "This file can only be included from ComponentsManager.h"
 #else
 
-#include "core\SingletonsManager.h"
 #include "core\Assert.h"
 #include <stdexcept>
 
@@ -11,7 +10,6 @@
 
 template< typename Derived >
 ComponentsManager< Derived >::ComponentsManager() 
-: m_services( new SingletonsManager( ))
 {
 }
 
@@ -22,7 +20,12 @@ ComponentsManager< Derived >::~ComponentsManager()
 {
    removeAllComponents();
 
-   delete m_services; m_services = NULL;
+   unsigned int count = m_typeSlots.size();
+   for ( unsigned int i = 0; i < count; ++i )
+   {
+      delete m_typeSlots[i];
+   }
+   m_typeSlots.clear();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -47,6 +50,17 @@ void ComponentsManager< Derived >::addComponent( Component< Derived >* component
    component->onServiceRegistered( derivedMgr );
    
    m_comps.push_back( component );
+
+   unsigned int count = m_typeSlots.size();
+   for ( unsigned int i = 0; i < count; ++i )
+   {
+      TypeSlot* slot = m_typeSlots[i];
+      if ( slot && slot->m_components )
+      {
+         slot->m_components->onComponentAdded( component );
+      }
+   }
+
    onComponentAdded( *component );
 }
 
@@ -61,6 +75,16 @@ void ComponentsManager< Derived >::removeComponent( Component< Derived >& compon
       {
          onComponentRemoved( component );
          m_comps.erase( it );
+
+         unsigned int count = m_typeSlots.size();
+         for ( unsigned int i = 0; i < count; ++i )
+         {
+            TypeSlot* slot = m_typeSlots[i];
+            if ( slot && slot->m_components )
+            {
+               slot->m_components->onComponentRemoved( &component );
+            }
+         }
          break;
       }
    }
@@ -74,6 +98,16 @@ void ComponentsManager< Derived >::removeAllComponents()
    ComponentsArr compsToRemove = m_comps;
    m_comps.clear();
 
+   unsigned int slotsCount = m_typeSlots.size();
+   for ( unsigned int i = 0; i < slotsCount; ++i )
+   {
+      TypeSlot* slot = m_typeSlots[i];
+      if ( slot && slot->m_components )
+      {
+         slot->m_components->clear();
+      }
+   }
+
    int count = (int)compsToRemove.size();
    for ( int i = count - 1; i >= 0; --i )
    {
@@ -112,15 +146,30 @@ template< typename Derived >
 template< typename T >
 void ComponentsManager< Derived >::findComponents( std::vector< T* >& outComponents ) const
 {
-   unsigned int count = m_comps.size();
-   for ( unsigned int i = 0; i < count; ++i )
+   const std::vector< T* >& comps = getComponents< T >();
+   outComponents.insert( outComponents.end(), comps.begin(), comps.end() );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+template< typename Derived >
+template< typename T >
+const std::vector< T* >& ComponentsManager< Derived >::getComponents() const
+{
+   TypeSlot& slot = getTypeSlot< T >();
+   if ( slot.m_components == NULL )
    {
-      T* comp = dynamic_cast< T* >( m_comps[ i ] );
-      if ( comp != NULL )
+      TTypedComponents< T >* typedComps = new TTypedComponents< T >();
+      slot.m_components = typedComps;
+
+      unsigned int count = m_comps.size();
+      for ( unsigned int i = 0; i < count; ++i )
       {
-         outComponents.push_back( comp );
+         typedComps->onComponentAdded( m_comps[i] );
       }
    }
+
+   return static_cast< TTypedComponents< T >* >( slot.m_components )->m_components;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -129,15 +178,10 @@ template< typename Derived >
 template< typename T >
 void ComponentsManager< Derived >::registerService( Component< Derived >& host, T& service )
 {
-   m_services->removeShared< T >();
    host.removeService( &service );
 
-   bool result = m_services->setShared< T >( service );
-   if ( result == false )
-   {
-      ASSERT_MSG( false, "Service is already registered" );
-      return;
-   }
+   TypeSlot& slot = getTypeSlot< T >();
+   slot.m_service = &service;
    host.addService( &service );
 
    notifyAboutService( &service );
@@ -149,16 +193,17 @@ template< typename Derived >
 template< typename T >
 void ComponentsManager< Derived >::removeService( Component< Derived >& host )
 {
-   if ( !m_services->hasShared< T >() )
+   TypeSlot* slot = findTypeSlot< T >();
+   if ( slot == NULL || slot->m_service == NULL )
    {
       return;
    }
 
-   T& service = m_services->shared< T >();
-   m_services->removeShared< T >();
+   void* service = slot->m_service;
+   slot->m_service = NULL;
 
-   notifyAboutService( &service );
-   host.removeService( &service );
+   notifyAboutService( service );
+   host.removeService( service );
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -167,7 +212,8 @@ template< typename Derived >
 template< typename T >
 bool ComponentsManager< Derived >::hasService() const
 {
-   return m_services->hasShared< T >();
+   TypeSlot* slot = findTypeSlot< T >();
+   return slot != NULL && slot->m_service != NULL;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -176,8 +222,11 @@ template< typename Derived >
 template < typename T >
 bool ComponentsManager< Derived >::needsUpdate( T& service ) const
 {
-   return ( &service != NULL && m_services->hasShared< T >() == false )
-      || ( m_services->hasShared< T >() && &m_services->shared< T >() != &service );
+   TypeSlot* slot = findTypeSlot< T >();
+   void* registeredService = slot ? slot->m_service : NULL;
+
+   return ( &service != NULL && registeredService == NULL )
+      || ( registeredService != NULL && registeredService != &service );
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -186,7 +235,20 @@ template< typename Derived >
 template< typename T >
 T& ComponentsManager< Derived >::requestService()
 {
-   return m_services->shared< T >();
+   TypeSlot* slot = findTypeSlot< T >();
+   ASSERT_MSG( slot != NULL && slot->m_service != NULL, "Unknown class type" );
+
+   return *reinterpret_cast< T* >( slot->m_service );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+template< typename Derived >
+template< typename T >
+ServiceHandle< T > ComponentsManager< Derived >::getServiceHandle()
+{
+   TypeSlot& slot = getTypeSlot< T >();
+   return ServiceHandle< T >( &slot.m_service );
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -217,4 +279,70 @@ void ComponentsManager< Derived >::notifyAboutService( void* service )
 
 ///////////////////////////////////////////////////////////////////////////////
 
+template< typename Derived >
+template< typename T >
+typename ComponentsManager< Derived >::TypeSlot& ComponentsManager< Derived >::getTypeSlot() const
+{
+   unsigned int idx = TypeIndex< T >::get();
+   if ( idx >= m_typeSlots.size() )
+   {
+      m_typeSlots.resize( idx + 1, NULL );
+   }
+
+   TypeSlot*& slot = m_typeSlots[idx];
+   if ( slot == NULL )
+   {
+      slot = new TypeSlot();
+   }
+
+   return *slot;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+template< typename Derived >
+template< typename T >
+typename ComponentsManager< Derived >::TypeSlot* ComponentsManager< Derived >::findTypeSlot() const
+{
+   unsigned int idx = TypeIndex< T >::get();
+   return idx < m_typeSlots.size() ? m_typeSlots[idx] : NULL;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+template< typename Derived >
+template< typename T >
+void ComponentsManager< Derived >::TTypedComponents< T >::onComponentAdded( Component< Derived >* component )
+{
+   T* comp = dynamic_cast< T* >( component );
+   if ( comp != NULL )
+   {
+      m_components.push_back( comp );
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+template< typename Derived >
+template< typename T >
+void ComponentsManager< Derived >::TTypedComponents< T >::onComponentRemoved( Component< Derived >* component )
+{
+   T* comp = dynamic_cast< T* >( component );
+   if ( comp == NULL )
+   {
+      return;
+   }
+
+   for ( typename std::vector< T* >::iterator it = m_components.begin(); it != m_components.end(); ++it )
+   {
+      if ( *it == comp )
+      {
+         m_components.erase( it );
+         break;
+      }
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 #endif // _COMPONENTS_MANAGER_H
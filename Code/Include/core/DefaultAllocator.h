@@ -10,11 +10,13 @@
 
 /**
  * Default memory allocator.
+ *
+ * It's shared by all threads, so the memory usage statistics are updated atomically.
  */
 class DefaultAllocator : public MemoryAllocator
 {
 private:
-   ulong       m_allocatedMemorySize;
+   volatile long        m_allocatedMemorySize;
 
 public:
    DefaultAllocator();
@@ -24,7 +26,7 @@ public:
    // -------------------------------------------------------------------------
    void* alloc( size_t size );
    void dealloc( void* ptr );
-   ulong getMemoryUsed() const { return m_allocatedMemorySize; }
+   ulong getMemoryUsed() const { return (ulong)m_allocatedMemorySize; }
 };
 
 ///////////////////////////////////////////////////////////////////////////////
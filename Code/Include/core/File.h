@@ -18,6 +18,9 @@ class FilePath;
 
 /**
  * Representation of a file.
+ *
+ * Files stored in an archive are read-only, and they're read straight from the archive's memory - 
+ * without the text mode newline translation.
  */
 class File
 {
@@ -29,13 +32,18 @@ private:
    FilePath                   m_name;
    std::ios_base::open_mode   m_openMode;
 
+   // contents of an archived file
+   const byte*                m_archivedData;
+   std::size_t                m_archivedDataSize;
+   std::size_t                m_archivedDataPos;
+
 public:
    ~File();
 
    /**
     * Checks if the file was successfully opened.
     */
-   inline bool isOpened() const { return m_file != NULL; }
+   inline bool isOpened() const { return m_file != NULL || m_archivedData != NULL; }
 
    /**
     * Returns the name of the file.
@@ -137,6 +145,15 @@ protected:
     */
    File( const Filesystem& hostFS, const FilePath& name, const std::ios_base::open_mode openMode = std::ios_base::in );
 
+   /**
+    * Constructor that opens a file stored in an archive for reading.
+    *
+    * @param hostFS     host file system
+    * @param name       file name
+    * @param data       contents of the file
+    * @param size       size of the file
+    */
+   File( const Filesystem& hostFS, const FilePath& name, const byte* data, std::size_t size );
 };
 
 ///////////////////////////////////////////////////////////////////////////////
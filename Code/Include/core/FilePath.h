@@ -5,6 +5,7 @@
 #include <string>
 #include <vector>
 #include "core\MemoryRouter.h"
+#include "core\types.h"
 
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -18,6 +19,9 @@ class InStream;
 /**
  * This class represents a path to a file in our file system ( relative
  * to the filesystem root ).
+ *
+ * The path carries a hash of its normalized form, calculated whenever the path changes,
+ * which makes it suitable for a hash table key and speeds up the comparisons.
  */
 class FilePath
 {
@@ -25,6 +29,7 @@ class FilePath
 
 private:
    std::string       m_relativePath;
+   uint              m_hash;
 
 public:
    /**
@@ -69,10 +74,15 @@ public:
     */
    inline const std::string& getRelativePath() const { return m_relativePath; }
 
+   /**
+    * Returns the hash of the path.
+    */
+   inline uint getHash() const { return m_hash; }
+
    /**
     * Assignment operator.
     */
-   inline void operator=( const FilePath& rhs ) { m_relativePath = rhs.m_relativePath; }
+   inline void operator=( const FilePath& rhs ) { m_relativePath = rhs.m_relativePath; m_hash = rhs.m_hash; }
 
    /**
     * Conversion operator.
@@ -84,14 +94,14 @@ public:
     *
     * @param rhs
     */
-   inline bool operator==( const FilePath& rhs ) const { return m_relativePath == rhs.m_relativePath; }
+   inline bool operator==( const FilePath& rhs ) const { return m_hash == rhs.m_hash && m_relativePath == rhs.m_relativePath; }
 
    /**
     * Inequality operator.
     *
     * @param rhs
     */
-   bool operator!=( const FilePath& rhs ) const { return m_relativePath != rhs.m_relativePath; }
+   bool operator!=( const FilePath& rhs ) const { return m_hash != rhs.m_hash || m_relativePath != rhs.m_relativePath; }
 
    /**
     * Comparison operator.
@@ -200,6 +210,21 @@ public:
     */
    void getElements( std::vector< std::string >& outPathElements ) const;
 
+private:
+   /**
+    * Recalculates the hash of the path - needs to be called each time the path changes.
+    */
+   void updateHash();
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A hash function that allows to use FilePath as a key of an unordered_map.
+ */
+struct FilePathHash
+{
+   inline std::size_t operator()( const FilePath& path ) const { return path.getHash(); }
 };
 
 ///////////////////////////////////////////////////////////////////////////////
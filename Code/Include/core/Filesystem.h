@@ -13,6 +13,9 @@
 
 class File;
 class FilePath;
+class MappedFile;
+class FilesystemArchive;
+class FilesystemIndex;
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -81,6 +84,12 @@ public:
 /**
  * A manager of the file system that can be used to access 
  * external files.
+ *
+ * Archives can be mounted in the filesystem ( see 'mount' ) - the files they contain
+ * can then be read as if they were regular files located under the filesystem root.
+ *
+ * The contents of the scanned directories are kept in an index ( see FilesystemIndex ),
+ * so that the subsequent scans don't have to enumerate the directories that didn't change.
  */
 class Filesystem
 {
@@ -89,11 +98,14 @@ class Filesystem
 private:
    typedef std::map< std::string, std::string > Shortcuts;
    typedef std::vector< FilesystemListener* >   Listeners;
+   typedef std::vector< FilesystemArchive* >    Archives;
 
 private:
    std::string          m_rootDir;
    Shortcuts            m_shortcuts;
    Listeners            m_listeners;
+   Archives             m_archives;
+   FilesystemIndex*     m_index;
 
 public:
    /**
@@ -102,6 +114,7 @@ public:
     * @param rootDir    the initial root directory
     */
    Filesystem( const std::string& rootDir = "" );
+   ~Filesystem();
 
    /**
     * This manager maps the file system to a specific directory's contents.
@@ -143,6 +156,14 @@ public:
     */
    File* open( const FilePath& fileName, const std::ios_base::openmode mode = std::ios_base::in ) const;
 
+   /**
+    * Maps the contents of the specified file into memory for reading.
+    *
+    * @param fileName   name of the file we want to map
+    * @return           mapped file, or NULL if the file couldn't be mapped ( it doesn't exist, or it's empty )
+    */
+   MappedFile* map( const FilePath& fileName ) const;
+
    /**
     * Creates a new directory.
     *
@@ -159,6 +180,29 @@ public:
     */
    bool remove( const FilePath& path ) const;
 
+   // -------------------------------------------------------------------------
+   // Archives
+   // -------------------------------------------------------------------------
+   /**
+    * Mounts an archive located in this filesystem. From now on the files it contains will
+    * be read from it. Archives mounted later take precedence over the ones mounted before them,
+    * and all of them take precedence over the regular files.
+    *
+    * @param archivePath      path to the archive file
+    * @return                 'true' if the archive was mounted, 'false' if it's not a valid archive
+    */
+   bool mount( const FilePath& archivePath );
+
+   /**
+    * Unmounts all mounted archives.
+    */
+   void unmountArchives();
+
+   /**
+    * Returns the index of the directories contents used by the scans.
+    */
+   inline const FilesystemIndex& getIndex() const { return *m_index; }
+
    // -------------------------------------------------------------------------
    // Listeners management
    // -------------------------------------------------------------------------
@@ -224,6 +268,9 @@ public:
     * The method scans the file system, starting from the specified root
     * directory, and informs via the FilesystemScanner interface about its finding.
     *
+    * The directories are enumerated only if they changed since the last scan - otherwise
+    * their contents are taken from the index.
+    *
     * @param rootDir          directory from which the scanning should begin
     * @param scanner
     * @param recursive        use recursive search through the directories tree
@@ -0,0 +1,137 @@
+/// @file   core/FilesystemArchive.h
+/// @brief  a read-only archive that packs many files into a single one
+#pragma once
+
+#include <string>
+#include <vector>
+#include "core\MemoryRouter.h"
+#include "core\types.h"
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+class Filesystem;
+class FilePath;
+class FilesystemScanner;
+class MappedFile;
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * An archive ( a pack file ) that stores many files in a single one, so that they can
+ * be accessed without the overhead of opening each one of them separately.
+ *
+ * The archive is mapped into memory as a whole, and the files are served straight from the mapping.
+ * Its table of contents is sorted by the hashes of the paths, so a file is found using a binary search.
+ *
+ * Once mounted in a Filesystem ( see Filesystem::mount ), the files it contains become visible
+ * through that filesystem ( and all FilesystemSections defined on it ) as if they were regular files.
+ *
+ * Archive layout:
+ *    - Header
+ *    - Entry[ m_entriesCount ] - sorted by the path hash, and by the path itself in case of collisions
+ *    - paths of the files ( null terminated strings )
+ *    - contents of the files ( each aligned to ARCHIVE_DATA_ALIGNMENT bytes ), in the order of their paths
+ */
+class FilesystemArchive
+{
+   DECLARE_ALLOCATOR( FilesystemArchive, AM_DEFAULT );
+
+private:
+   struct Header
+   {
+      uint           m_magicNo;
+      uint           m_version;
+      uint           m_entriesCount;
+      uint           m_pathsOffset;
+   };
+
+   struct Entry
+   {
+      uint           m_pathHash;
+      uint           m_pathOffset;        // offset of the path, relative to the beginning of the paths section
+      uint           m_dataOffset;        // offset of the file contents, relative to the beginning of the archive
+      uint           m_dataSize;
+   };
+
+private:
+   MappedFile*       m_archiveFile;
+   const Header*     m_header;
+   const Entry*      m_entries;
+   const char*       m_paths;
+
+public:
+   /**
+    * Constructor.
+    *
+    * @param filesystem       filesystem the archive file is located in
+    * @param archivePath      path to the archive file
+    */
+   FilesystemArchive( const Filesystem& filesystem, const FilePath& archivePath );
+   ~FilesystemArchive();
+
+   /**
+    * Tells whether the archive was successfully opened.
+    */
+   inline bool isValid() const { return m_header != NULL; }
+
+   /**
+    * Returns the number of files in the archive.
+    */
+   inline uint getFilesCount() const { return m_header ? m_header->m_entriesCount : 0; }
+
+   /**
+    * Tells if the archive contains the specified file.
+    *
+    * @param path
+    */
+   bool doesExist( const FilePath& path ) const;
+
+   /**
+    * Tells if the archive contains any files located in the specified directory.
+    *
+    * @param path
+    */
+   bool isDir( const FilePath& path ) const;
+
+   /**
+    * Looks for the specified file in the archive and returns its contents.
+    *
+    * @param path
+    * @param outSize          size of the file
+    * @return                 pointer to the contents of the file, or NULL if the archive doesn't contain it
+    */
+   const byte* find( const FilePath& path, std::size_t& outSize ) const;
+
+   /**
+    * Informs the scanner about the files and directories stored in the archive
+    * beneath the specified directory.
+    *
+    * @param rootDir
+    * @param scanner
+    * @param recursive
+    */
+   void scan( const FilePath& rootDir, FilesystemScanner& scanner, bool recursive ) const;
+
+   /**
+    * Packs the specified files into an archive.
+    *
+    * @param sourceFilesystem    filesystem the files are located in
+    * @param files               paths of the packed files
+    * @param targetFilesystem    filesystem the archive should be created in
+    * @param archivePath         path of the created archive
+    * @return                    'true' if the archive was created, 'false' otherwise
+    */
+   static bool build( const Filesystem& sourceFilesystem, const std::vector< FilePath >& files, const Filesystem& targetFilesystem, const FilePath& archivePath );
+
+private:
+   /**
+    * Looks for an entry describing the specified file.
+    *
+    * @param path
+    * @return     the entry, or NULL if the archive doesn't contain such file
+    */
+   const Entry* findEntry( const FilePath& path ) const;
+};
+
+///////////////////////////////////////////////////////////////////////////////
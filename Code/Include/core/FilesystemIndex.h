@@ -0,0 +1,104 @@
+/// @file   core/FilesystemIndex.h
+/// @brief  an in-memory index of the filesystem directories contents
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "core\MemoryRouter.h"
+#include "core\Filesystem.h"
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+class FilePath;
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * An index of the directories contents the filesystem uses to answer the scans from memory.
+ *
+ * A directory is enumerated only the first time it's scanned - after that it's enumerated again
+ * only if its last write time changes ( which happens when an entry is added to it or removed from it ),
+ * or if the filesystem reports a change in it.
+ */
+class FilesystemIndex : public FilesystemListener
+{
+   DECLARE_ALLOCATOR( FilesystemIndex, AM_DEFAULT );
+
+public:
+   struct Entry
+   {
+      std::string    m_name;
+      bool           m_isDir;
+
+      Entry( const std::string& name, bool isDir ) : m_name( name ), m_isDir( isDir ) {}
+   };
+
+   struct Directory
+   {
+      DECLARE_ALLOCATOR( Directory, AM_DEFAULT );
+
+      unsigned __int64        m_lastWriteTime;
+      bool                    m_isUpToDate;
+      std::vector< Entry >    m_entries;
+
+      Directory() : m_lastWriteTime( 0 ), m_isUpToDate( false ) {}
+   };
+
+private:
+   typedef std::unordered_map< std::string, Directory* >  Directories;
+
+private:
+   const Filesystem&          m_filesystem;
+   Directories                m_directories;
+
+   uint                       m_enumeratedDirsCount;
+
+public:
+   /**
+    * Constructor.
+    *
+    * @param filesystem       indexed filesystem
+    */
+   FilesystemIndex( const Filesystem& filesystem );
+   ~FilesystemIndex();
+
+   /**
+    * Returns the contents of the specified directory, enumerating it only if the indexed
+    * contents are out of date.
+    *
+    * @param absoluteDirPath  absolute path to the directory ( ending with a slash )
+    * @return                 directory contents, or NULL if the directory doesn't exist
+    */
+   const Directory* getDirectory( const std::string& absoluteDirPath );
+
+   /**
+    * Removes all indexed directories.
+    */
+   void clear();
+
+   /**
+    * Returns the number of directories that had to be enumerated since the index was created - a statistic
+    * that tells how effective the index is.
+    */
+   inline uint getEnumeratedDirsCount() const { return m_enumeratedDirsCount; }
+
+   // -------------------------------------------------------------------------
+   // FilesystemListener implementation
+   // -------------------------------------------------------------------------
+   void onFileEdited( const FilePath& path );
+   void onFileRemoved( const FilePath& path );
+   void onDirAdded( const FilePath& dir );
+   void onDirRemoved( const FilePath& dir );
+
+private:
+   /**
+    * Marks the directory the specified file or directory is located in as out of date.
+    *
+    * @param path
+    */
+   void invalidateParentDir( const FilePath& path );
+};
+
+///////////////////////////////////////////////////////////////////////////////
@@ -218,6 +218,11 @@ public:
     */
    void notifyOutputsChanged();
 
+protected:
+   /**
+    * Called when the node's sockets get defined or removed.
+    */
+   virtual void onSocketsChanged() {}
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -106,6 +106,7 @@ void GraphBuilderNode< Impl >::defineInput( TInputSocket* input )
    if ( existingInput == NULL )
    {
       m_inputs.push_back( input );
+      onSocketsChanged();
       notify( GBNO_INPUTS_CHANGED );
    }
    else
@@ -148,6 +149,7 @@ void GraphBuilderNode< Impl >::defineInputs( const std::vector< TInputSocket* >&
 
    if ( inputsAdded > 0 )
    {
+      onSocketsChanged();
       notify( GBNO_INPUTS_CHANGED );
    }
 }
@@ -171,6 +173,7 @@ void GraphBuilderNode< Impl >::removeAllInputs()
    }
    m_inputs.clear();
 
+   onSocketsChanged();
    notify( GBNO_INPUTS_CHANGED );
 }
 
@@ -203,6 +206,7 @@ void GraphBuilderNode< Impl >::removeSelectedInputs( const std::vector< std::str
       }
    }
 
+   onSocketsChanged();
    notify( GBNO_INPUTS_CHANGED );
 }
 
@@ -216,6 +220,7 @@ void GraphBuilderNode< Impl >::redefineInputs( const std::vector< TInputSocket*
    // notify about the changes, if any were made
    if ( numInputsChanged > 0 )
    {
+      onSocketsChanged();
       notify( GBNO_INPUTS_CHANGED );
    }
 }
@@ -231,6 +236,7 @@ void GraphBuilderNode< Impl >::defineOutput( TOutputSocket* output )
    if ( existingOutput == NULL )
    {
       m_outputs.push_back( output );
+      onSocketsChanged();
       notify( GBNO_OUTPUTS_CHANGED );
    }
    else
@@ -276,6 +282,7 @@ void GraphBuilderNode< Impl >::defineOutputs( const std::vector< TOutputSocket*
    {
       // notify the listeners only if we have something to notify of - meaning that any
       // of the outputs were actually added to the node 
+      onSocketsChanged();
       notify( GBNO_OUTPUTS_CHANGED );
    }
 }
@@ -299,6 +306,7 @@ void GraphBuilderNode< Impl >::removeAllOutputs()
    }
    m_outputs.clear();
 
+   onSocketsChanged();
    notify( GBNO_OUTPUTS_CHANGED );
 }
 
@@ -331,6 +339,7 @@ void GraphBuilderNode< Impl >::removeSelectedOutputs( const std::vector< std::st
       }
    }
 
+   onSocketsChanged();
    notify( GBNO_OUTPUTS_CHANGED );
 }
 
@@ -344,6 +353,7 @@ void GraphBuilderNode< Impl >::redefineOutputs( const std::vector< TOutputSocket
    // notify about the changes, if any were made
    if ( numOutputsChanged > 0 )
    {
+      onSocketsChanged();
       notify( GBNO_OUTPUTS_CHANGED );
    }
 }
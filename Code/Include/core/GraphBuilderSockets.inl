@@ -28,6 +28,7 @@ void GBNodeOutput< TNode >::connect( TNode& node )
    if ( it == m_connectedNodes.end() )
    {
       m_connectedNodes.push_back( &node );
+      markDirty();
    }
 }
 
@@ -40,6 +41,7 @@ void GBNodeOutput< TNode >::disconnect( TNode& node )
    if ( it != m_connectedNodes.end() )
    {
       m_connectedNodes.erase( it );
+      markDirty();
    }
 }
 
@@ -74,6 +76,7 @@ bool GBNodeInput< TNode >::connect( GBNodeOutput< TNode >& output )
    else
    {
       m_connectedOutput = &output;
+      markDirty();
       return true;
    }
 }
@@ -83,7 +86,11 @@ bool GBNodeInput< TNode >::connect( GBNodeOutput< TNode >& output )
 template< typename TNode >
 void GBNodeInput< TNode >::disconnect()
 {
-   m_connectedOutput = NULL;
+   if ( m_connectedOutput != NULL )
+   {
+      m_connectedOutput = NULL;
+      markDirty();
+   }
 }
 
 ///////////////////////////////////////////////////////////////////////////////
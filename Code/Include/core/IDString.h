@@ -6,6 +6,7 @@
 #include "core\MemoryRouter.h"
 #include "core\types.h"
 #include "core\Array.h"
+#include "core\Thread.h"
 
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -75,13 +76,25 @@ public:
 
 /**
  * A singleton repository of all string referenced by IDString instances.
+ *
+ * The pool can be accessed from multiple threads. Only the registration of the strings
+ * is synchronized - the registered strings are stored in pages that never move,
+ * so they can be read ( IDString::c_str ) without locking.
  */
 class IDStringsPool
 {
 private:
+   enum
+   {
+      STRINGS_PER_PAGE  = 1024,
+      MAX_PAGES         = 1024,
+   };
+
    static IDStringsPool*      s_theInstance;
 
-   Array< char* >             m_strings;
+   char**                     m_pages[MAX_PAGES];
+   volatile long              m_stringsCount;
+   CriticalSection            m_registrationLock;
 
 public:
    /**
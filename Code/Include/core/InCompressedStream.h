@@ -0,0 +1,57 @@
+/// @file   core\InCompressedStream.h
+/// @brief  stream that decompresses the data written by an OutCompressedStream
+#pragma once
+
+#include "core/InStream.h"
+#include "core/Array.h"
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * This stream reads the data written by an OutCompressedStream from another stream
+ * and decompresses it, one block at a time.
+ */
+class InCompressedStream : public InStream
+{
+   DECLARE_ALLOCATOR( InCompressedStream, AM_DEFAULT );
+
+private:
+   InStream&         m_stream;
+
+   Array< byte >     m_block;
+   uint              m_blockDataSize;
+   uint              m_readPos;
+   Array< byte >     m_compressedBlock;
+
+   bool              m_isFinished;
+
+public:
+   /**
+    * Constructor.
+    *
+    * @param stream     stream with the compressed data
+    */
+   InCompressedStream( InStream& stream );
+
+   /**
+    * Skips the remaining compressed data, leaving the underlying stream
+    * right past its end.
+    */
+   void finish();
+
+   // ----------------------------------------------------------------------
+   // InStream implementation
+   // ----------------------------------------------------------------------
+   void load( void* val, unsigned int dataSize );
+
+private:
+   /**
+    * Reads and decompresses the next block of data.
+    *
+    * @return     'false' if there's no more data
+    */
+   bool readBlock();
+};
+
+///////////////////////////////////////////////////////////////////////////////
@@ -13,23 +13,44 @@ class File;
 ///////////////////////////////////////////////////////////////////////////////
 /**
  * This stream will persist data in a simple binary file archive.
+ *
+ * The data is read from the file in large chunks and served from an internal
+ * buffer, so that deserializing lots of small primitive fields doesn't 
+ * translate to a file read per field.
  */
 class InFileStream: public InStream
 {
    DECLARE_ALLOCATOR( InFileStream, AM_DEFAULT );
 
+public:
+   // default size of the internal read buffer
+   static const uint DEFAULT_BUFFER_SIZE = 64 * 1024;
+
 private:
-   File* m_archive;
+   File*       m_archive;
+
+   byte*       m_buffer;
+   uint        m_bufferSize;
+   uint        m_readPos;
+   uint        m_dataEnd;
+
+   uint        m_fileReadsCount;
 
 public:
    /**
     * Constructor.
     *
     * @param archive    binary file archive
+    * @param bufferSize size of the internal read buffer. Specify 0 to read straight from the file.
     */
-   InFileStream( File* archive );
+   InFileStream( File* archive, uint bufferSize = DEFAULT_BUFFER_SIZE );
    ~InFileStream();
 
+   /**
+    * Returns the number of reads the stream has issued against the underlying file.
+    */
+   inline uint getFileReadsCount() const { return m_fileReadsCount; }
+
 protected:
    // ----------------------------------------------------------------------
    // InStream implementation
@@ -0,0 +1,53 @@
+/// @file   core\InMappedFileStream.h
+/// @brief  stream that reads data straight from a memory mapped file
+#pragma once
+
+#include "core/InStream.h"
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+class MappedFile;
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * This stream reads the data straight from a file mapped into memory,
+ * without copying the file contents to an intermediate buffer first.
+ */
+class InMappedFileStream : public InStream
+{
+   DECLARE_ALLOCATOR( InMappedFileStream, AM_DEFAULT );
+
+private:
+   MappedFile*       m_file;
+   uint              m_readPos;
+
+public:
+   /**
+    * Constructor.
+    *
+    * @param file       mapped file the stream will take the ownership of
+    */
+   InMappedFileStream( MappedFile* file );
+   ~InMappedFileStream();
+
+   /**
+    * Returns a pointer to the data that will be read next. Gives a direct access
+    * to the mapped data, so that the large chunks of it don't need to be copied.
+    */
+   const byte* getCurrentData() const;
+
+   /**
+    * Returns the number of bytes that are left to read.
+    */
+   uint getRemainingSize() const;
+
+   // ----------------------------------------------------------------------
+   // InStream implementation
+   // ----------------------------------------------------------------------
+   void load( void* val, unsigned int dataSize );
+   void skip( uint sizeInBytes );
+};
+
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,53 @@
+/// @file   core\InMemoryStream.h
+/// @brief  an input stream that reads data from a raw memory block it doesn't own
+#pragma once
+
+#include "core/InStream.h"
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * An input stream that reads data from a raw memory block.
+ *
+ * Unlike InArrayStream, it doesn't require the data to be stored in an Array,
+ * so it can be used to read from a part of a larger block of memory
+ * ( a mapped file or an archive loaded in place, for instance ).
+ * The stream doesn't take the ownership of the memory.
+ */
+class InMemoryStream : public InStream
+{
+   DECLARE_ALLOCATOR( InMemoryStream, AM_DEFAULT );
+
+private:
+   const byte*       m_data;
+   uint              m_size;
+   uint              m_readPos;
+
+public:
+   /**
+    * Constructor.
+    *
+    * @param data
+    * @param size       size of the data block ( in bytes )
+    */
+   InMemoryStream( const byte* data, uint size );
+
+   /**
+    * Returns a pointer to the data that will be read next.
+    */
+   inline const byte* getCurrentData() const { return m_data + m_readPos; }
+
+   /**
+    * Returns the number of bytes that remain to be read.
+    */
+   inline uint getRemainingSize() const { return m_size - m_readPos; }
+
+   // ----------------------------------------------------------------------
+   // InStream implementation
+   // ----------------------------------------------------------------------
+   void load( void* val, unsigned int dataSize );
+   void skip( uint sizeInBytes );
+};
+
+///////////////////////////////////////////////////////////////////////////////
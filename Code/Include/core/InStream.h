@@ -9,6 +9,11 @@
 #include "core\types.h"
 
 
+///////////////////////////////////////////////////////////////////////////////
+
+class IDString;
+class ReflectionStringTable;
+
 ///////////////////////////////////////////////////////////////////////////////
 
 /**
@@ -18,7 +23,11 @@ class InStream
 {
    DECLARE_ALLOCATOR( InStream, AM_DEFAULT );
 
+private:
+   const ReflectionStringTable*     m_stringTable;
+
 public:
+   InStream() : m_stringTable( NULL ) {}
    virtual ~InStream() {}
 
    /**
@@ -44,12 +53,36 @@ public:
     */
    InStream& operator>>( std::string& val );
 
+   /**
+    * Loads an IDString from the stream.
+    *
+    * @param val     loaded string id
+    */
+   InStream& operator>>( IDString& val );
+
+   /**
+    * Attaches a table the strings read from the stream should be looked up in.
+    * Once it's attached, the stream expects to find indices of the strings
+    * in the table, rather than the strings themselves.
+    *
+    * @param stringTable      table to use, or NULL to read the strings directly
+    */
+   inline void setStringTable( const ReflectionStringTable* stringTable ) { m_stringTable = stringTable; }
+
+   /**
+    * Returns the attached string table ( if any ).
+    */
+   inline const ReflectionStringTable* getStringTable() const { return m_stringTable; }
+
    /**
     * Skips a certain part of the stream.
     *
+    * The default implementation reads the skipped data into a temporary buffer -
+    * implementations that can skip it more efficiently should override it.
+    *
     * @param sizeInBytes
     */
-   void skip( uint sizeInBytes );
+   virtual void skip( uint sizeInBytes );
 
    /**
     * Loading implementation.
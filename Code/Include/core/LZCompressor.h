@@ -0,0 +1,56 @@
+/// @file   core/LZCompressor.h
+/// @brief  a fast LZ-class compression algorithm
+#pragma once
+
+#include "core\types.h"
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A fast, byte oriented LZ77-class compressor.
+ *
+ * The data is encoded as a sequence of tokens. Each token starts with a byte
+ * that holds the number of literals that follow it ( upper 4 bits ) and the length
+ * of the match that follows the literals ( lower 4 bits ). Both values can be extended
+ * with additional bytes if they don't fit in 4 bits. A match is described by a 16 bit offset
+ * back into the already decoded data, so the compressed data can't reference
+ * more than 64KB of the preceding data.
+ *
+ * The compressor looks for the matches using a single hash table lookup per position,
+ * which trades the compression ratio for speed. The decompressor is a simple copy loop.
+ */
+class LZCompressor
+{
+public:
+   /**
+    * Returns the size of a buffer that's guaranteed to fit the compressed data of the specified size.
+    *
+    * @param dataSize
+    */
+   static uint getMaxCompressedSize( uint dataSize );
+
+   /**
+    * Compresses the data.
+    *
+    * @param data
+    * @param dataSize
+    * @param outCompressedData      buffer for the compressed data - it should be able to contain
+    *                               at least getMaxCompressedSize( dataSize ) bytes
+    * @return                       size of the compressed data
+    */
+   static uint compress( const byte* data, uint dataSize, byte* outCompressedData );
+
+   /**
+    * Decompresses the data.
+    *
+    * @param compressedData
+    * @param compressedDataSize
+    * @param outData                buffer for the decompressed data
+    * @param dataSize               expected size of the decompressed data
+    * @return                       'true' if the data was decompressed successfully, 'false' if it was corrupt
+    */
+   static bool decompress( const byte* compressedData, uint compressedDataSize, byte* outData, uint dataSize );
+};
+
+///////////////////////////////////////////////////////////////////////////////
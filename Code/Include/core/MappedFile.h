@@ -0,0 +1,81 @@
+/// @file   core\MappedFile.h
+/// @brief  a read-only file mapped into memory
+#pragma once
+
+#include "core/MemoryRouter.h"
+#include "core/FilePath.h"
+#include "core/types.h"
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+class Filesystem;
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A read-only view of a file's contents mapped into the address space
+ * of the process.
+ *
+ * The data can be accessed directly, without reading it into an intermediate
+ * buffer first - the operating system will page it in as it's being accessed.
+ *
+ * Files stored in an archive are served from the mapping of the archive.
+ */
+class MappedFile
+{
+   DECLARE_ALLOCATOR( MappedFile, AM_DEFAULT );
+
+private:
+   FilePath                   m_name;
+   // the handles are kept opaque, so that the header doesn't need to include windows.h
+   void*                      m_file;
+   void*                      m_mapping;
+   const byte*                m_data;
+   std::size_t                m_size;
+
+public:
+   ~MappedFile();
+
+   /**
+    * Checks if the file was successfully mapped.
+    */
+   inline bool isMapped() const { return m_data != NULL; }
+
+   /**
+    * Returns the name of the file.
+    */
+   inline const FilePath& getName() const { return m_name; }
+
+   /**
+    * Returns the mapped contents of the file.
+    */
+   inline const byte* getData() const { return m_data; }
+
+   /**
+    * Returns the size of the file (in bytes).
+    */
+   inline std::size_t size() const { return m_size; }
+
+protected:
+   friend class Filesystem;
+
+   /**
+    * Constructor.
+    *
+    * @param hostFS     host file system
+    * @param name       file name
+    */
+   MappedFile( const Filesystem& hostFS, const FilePath& name );
+
+   /**
+    * Constructor that creates a view of a file stored in an already mapped archive.
+    *
+    * @param name       file name
+    * @param data       contents of the file
+    * @param size       size of the file
+    */
+   MappedFile( const FilePath& name, const byte* data, std::size_t size );
+};
+
+///////////////////////////////////////////////////////////////////////////////
@@ -33,6 +33,7 @@
 #include "core\MatrixUtils.h"
 #include "core\Plane.h"
 #include "core\Quaternion.h"
+#include "core\QuantizedQuaternion.h"
 #include "core\Transform.h"
 #include "core\Algorithms.h"
 #include "core\MathDefs.h"
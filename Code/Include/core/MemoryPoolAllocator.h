@@ -10,6 +10,9 @@
 
 /**
  * This allocator allocates data in a designated memory pool.
+ *
+ * Unlike the DefaultAllocator, it's not synchronized - a pool allocator should
+ * be used by the thread that owns the pool only.
  */
 class MemoryPoolAllocator : public MemoryAllocator
 {
@@ -25,6 +25,8 @@ class CallstackTracer;
 
 /**
  * Routes memory allocation/deallocation requests to a proper allocator.
+ *
+ * The router can be used from multiple threads.
  */
 class MemoryRouter
 {
@@ -37,6 +39,10 @@ private:
 #ifdef _TRACK_MEMORY_ALLOCATIONS
    CallstackTracer*              m_tracer;
    CallstackTree*                m_callstacksTree;
+
+   // a CRITICAL_SECTION that guards the tracer and the callstacks tree. It's not a CriticalSection instance,
+   // because that one is allocated through the router
+   void*                         m_trackingLock;
 #endif
 
 public:
@@ -0,0 +1,67 @@
+/// @file   core\OutCompressedStream.h
+/// @brief  stream that compresses the data before passing it to another stream
+#pragma once
+
+#include "core/OutStream.h"
+#include "core/Array.h"
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * This stream compresses the data it's fed with and writes it to another stream.
+ *
+ * The data is gathered in blocks, each of which is compressed independently using
+ * the LZCompressor. Every block is preceded with its uncompressed and stored size - the blocks
+ * that don't compress well are stored as they are. The compressed data is terminated
+ * with an empty block, so that it can be followed by other data in the same stream.
+ *
+ * Use InCompressedStream to read the data back.
+ */
+class OutCompressedStream : public OutStream
+{
+   DECLARE_ALLOCATOR( OutCompressedStream, AM_DEFAULT );
+
+public:
+   // default size of a block of the uncompressed data
+   static const uint DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+private:
+   OutStream&        m_stream;
+
+   Array< byte >     m_block;
+   uint              m_blockSize;
+   uint              m_writePos;
+   Array< byte >     m_compressedBlock;
+
+   bool              m_isFinished;
+
+public:
+   /**
+    * Constructor.
+    *
+    * @param stream     stream the compressed data should be written to
+    * @param blockSize  size of a block of the uncompressed data
+    */
+   OutCompressedStream( OutStream& stream, uint blockSize = DEFAULT_BLOCK_SIZE );
+   ~OutCompressedStream();
+
+   /**
+    * Compresses the buffered data and writes it to the underlying stream.
+    */
+   void flush();
+
+   /**
+    * Writes the remaining data to the underlying stream and terminates the compressed data.
+    * Nothing can be written to the stream afterwards. Called automatically when the stream is destroyed.
+    */
+   void finish();
+
+protected:
+   // ----------------------------------------------------------------------
+   // OutStream implementation
+   // ----------------------------------------------------------------------
+   void save( const void* val, unsigned int dataSize );
+};
+
+///////////////////////////////////////////////////////////////////////////////
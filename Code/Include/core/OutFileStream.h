@@ -13,23 +13,41 @@ class File;
 ///////////////////////////////////////////////////////////////////////////////
 /**
  * This stream will persist data in a simple binary file archive.
+ *
+ * The data is gathered in an internal buffer and written to the file
+ * in large chunks - when the buffer fills up, when the stream is flushed
+ * and when it's destroyed.
  */
 class OutFileStream: public OutStream
 {
    DECLARE_ALLOCATOR( OutFileStream, AM_DEFAULT );
 
+public:
+   // default size of the internal write buffer
+   static const uint DEFAULT_BUFFER_SIZE = 64 * 1024;
+
 private:
-   File* m_archive;
+   File*       m_archive;
+
+   byte*       m_buffer;
+   uint        m_bufferSize;
+   uint        m_writePos;
 
 public:
    /**
     * Constructor.
     *
     * @param archive    binary file archive
+    * @param bufferSize size of the internal write buffer. Specify 0 to write straight to the file.
     */
-   OutFileStream( File* archive );
+   OutFileStream( File* archive, uint bufferSize = DEFAULT_BUFFER_SIZE );
    ~OutFileStream();
 
+   /**
+    * Writes the buffered data to the file.
+    */
+   void flush();
+
 protected:
    // ----------------------------------------------------------------------
    // OutStream implementation
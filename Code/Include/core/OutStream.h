@@ -7,6 +7,11 @@
 #include "core\MemoryRouter.h"
 
 
+///////////////////////////////////////////////////////////////////////////////
+
+class IDString;
+class ReflectionStringTable;
+
 ///////////////////////////////////////////////////////////////////////////////
 
 /**
@@ -16,7 +21,11 @@ class OutStream
 {
    DECLARE_ALLOCATOR( OutStream, AM_DEFAULT );
 
+private:
+   ReflectionStringTable*           m_stringTable;
+
 public:
+   OutStream() : m_stringTable( NULL ) {}
    virtual ~OutStream() {}
 
    /**
@@ -42,6 +51,27 @@ public:
     */
    OutStream& operator<<( const std::string& val );
 
+   /**
+    * Saves an IDString to the stream.
+    *
+    * @param val     saved string id
+    */
+   OutStream& operator<<( const IDString& val );
+
+   /**
+    * Attaches a table the strings written to the stream should be added to.
+    * Once it's attached, the stream writes the indices the strings were assigned
+    * in the table, rather than the strings themselves.
+    *
+    * @param stringTable      table to use, or NULL to write the strings directly
+    */
+   inline void setStringTable( ReflectionStringTable* stringTable ) { m_stringTable = stringTable; }
+
+   /**
+    * Returns the attached string table ( if any ).
+    */
+   inline ReflectionStringTable* getStringTable() const { return m_stringTable; }
+
    /**
     * Saving implementation.
     *
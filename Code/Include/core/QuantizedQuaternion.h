@@ -0,0 +1,74 @@
+/// @file   core/QuantizedQuaternion.h
+/// @brief  a compact storage format for unit quaternions
+#ifndef _QUANTIZED_QUATERNION_H
+#define _QUANTIZED_QUATERNION_H
+
+#include "core\MemoryRouter.h"
+#include "core\Quaternion.h"
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A unit quaternion stored in a quarter of the space a regular Quaternion takes.
+ *
+ * Each component is quantized to a 16-bit fixed point value from the <-1, 1> range,
+ * which introduces a rotation error of approximately 1e-4 radians - small enough
+ * for storing animation keys.
+ *
+ * The structure converts to and from a Quaternion implicitly, so it can be used
+ * as the storage type of an AnimationTimeline.
+ */
+struct QuantizedQuaternion
+{
+   DECLARE_ALLOCATOR( QuantizedQuaternion, AM_DEFAULT );
+
+   short          m_x;
+   short          m_y;
+   short          m_z;
+   short          m_w;
+
+   /**
+    * Default constructor - creates an identity quaternion.
+    */
+   inline QuantizedQuaternion();
+
+   /**
+    * Conversion constructor.
+    *
+    * @param quat       a unit quaternion
+    */
+   inline QuantizedQuaternion( const Quaternion& quat );
+
+   /**
+    * Quantizes the specified unit quaternion.
+    *
+    * @param quat
+    */
+   inline void set( const Quaternion& quat );
+
+   /**
+    * Restores a unit quaternion from the quantized values.
+    *
+    * @param outQuat
+    */
+   inline void get( Quaternion& outQuat ) const;
+
+   /**
+    * Conversion operator.
+    */
+   inline operator Quaternion() const;
+
+   /**
+    * Returns the maximum angle ( in radians ) a quaternion may be rotated by as a result of the quantization.
+    */
+   static inline float getMaxError();
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#include "core\QuantizedQuaternion.inl"
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // _QUANTIZED_QUATERNION_H
@@ -0,0 +1,73 @@
+#ifndef _QUANTIZED_QUATERNION_H
+#error "This file can only be included from QuantizedQuaternion.h"
+#else
+
+#include <math.h>
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+#define QUANTIZED_QUAT_SCALE        32767.0f
+
+///////////////////////////////////////////////////////////////////////////////
+
+QuantizedQuaternion::QuantizedQuaternion()
+   : m_x( 0 )
+   , m_y( 0 )
+   , m_z( 0 )
+   , m_w( (short)QUANTIZED_QUAT_SCALE )
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+QuantizedQuaternion::QuantizedQuaternion( const Quaternion& quat )
+{
+   set( quat );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void QuantizedQuaternion::set( const Quaternion& quat )
+{
+   Quaternion normalizedQuat = quat;
+   normalizedQuat.normalize();
+
+   m_x = (short)floor( normalizedQuat[0] * QUANTIZED_QUAT_SCALE + 0.5f );
+   m_y = (short)floor( normalizedQuat[1] * QUANTIZED_QUAT_SCALE + 0.5f );
+   m_z = (short)floor( normalizedQuat[2] * QUANTIZED_QUAT_SCALE + 0.5f );
+   m_w = (short)floor( normalizedQuat[3] * QUANTIZED_QUAT_SCALE + 0.5f );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+void QuantizedQuaternion::get( Quaternion& outQuat ) const
+{
+   const float invScale = 1.0f / QUANTIZED_QUAT_SCALE;
+   outQuat.set( m_x * invScale, m_y * invScale, m_z * invScale, m_w * invScale );
+
+   // the quantization breaks the unit length a bit
+   outQuat.normalize();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+QuantizedQuaternion::operator Quaternion() const
+{
+   Quaternion quat;
+   get( quat );
+   return quat;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+float QuantizedQuaternion::getMaxError()
+{
+   // each component may be off by half a quantization step, which rotates the quaternion by at most
+   // 2 * asin( |error| ), where |error| <= sqrt( 4 * ( 0.5 / SCALE )^2 ) = 1 / SCALE
+   return 2.0f * asin( 1.0f / QUANTIZED_QUAT_SCALE );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // _QUANTIZED_QUATERNION_H
@@ -164,6 +164,17 @@ struct Quaternion
     */
    inline void setSlerp( const Quaternion& a, const Quaternion& b, const FastFloat& t );
 
+   /**
+    * Spherically interpolates four pairs of quaternions at once. The quaternions are
+    * transposed, so that a single SIMD operation processes the same component of all four of them.
+    *
+    * @param a             array of four start quaternions
+    * @param b             array of four end quaternions
+    * @param t             array of four interpolation distances
+    * @param outQuats      array the four interpolated quaternions will be stored in
+    */
+   static inline void slerp4( const Quaternion* a, const Quaternion* b, const FastFloat* t, Quaternion* outQuats );
+
    /**
     * Normalizes the quaternion.
     */
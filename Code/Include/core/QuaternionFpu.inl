@@ -253,6 +253,16 @@ void Quaternion::setSlerp( const Quaternion& a, const Quaternion& b, const FastF
 
 ///////////////////////////////////////////////////////////////////////////////
 
+void Quaternion::slerp4( const Quaternion* a, const Quaternion* b, const FastFloat* t, Quaternion* outQuats )
+{
+   for ( int i = 0; i < 4; ++i )
+   {
+      outQuats[i].setSlerp( a[i], b[i], t[i] );
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void Quaternion::getAxis( Vector& outAxis ) const
 {
    float sq = (float)sqrt( 1.0f - m_quad.v[3]*m_quad.v[3] );
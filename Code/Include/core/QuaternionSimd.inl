@@ -249,6 +249,92 @@ void Quaternion::setSlerp( const Quaternion& a, const Quaternion& b, const FastF
 
 ///////////////////////////////////////////////////////////////////////////////
 
+void Quaternion::slerp4( const Quaternion* a, const Quaternion* b, const FastFloat* t, Quaternion* outQuats )
+{
+   const __m128 delta = SimdUtils::fromFloat( 1.0f - 1e-3f );
+
+   // transpose the quaternions - each register will hold the same component of all four of them
+   const __m128 aRows[4] = { a[0].m_quad, a[1].m_quad, a[2].m_quad, a[3].m_quad };
+   const __m128 bRows[4] = { b[0].m_quad, b[1].m_quad, b[2].m_quad, b[3].m_quad };
+   __m128 aComps[4], bComps[4];
+   SimdUtils::transpose( aRows, aComps );
+   SimdUtils::transpose( bRows, bComps );
+   const __m128 tQuad = PACK_SIMD( t[0].m_val, t[1].m_val, t[2].m_val, t[3].m_val );
+
+   // Calculate the angles between them.
+   __m128 cosTheta = _mm_mul_ps( aComps[0], bComps[0] );
+   SimdUtils::addMul( &cosTheta, &aComps[1], &bComps[1], &cosTheta );
+   SimdUtils::addMul( &cosTheta, &aComps[2], &bComps[2], &cosTheta );
+   SimdUtils::addMul( &cosTheta, &aComps[3], &bComps[3], &cosTheta );
+
+   __m128 cosThetaLessZero;
+   SimdUtils::lessZeroMask( &cosTheta, &cosThetaLessZero );
+   SimdUtils::flipSign( &cosTheta, &cosThetaLessZero, &cosTheta );
+
+   // the quaternions that are close to each other are interpolated linearly
+   __m128 t0 = _mm_sub_ps( Float_1.m_val, tQuad );
+   __m128 t1 = tQuad;
+
+   __m128 slerpMask;
+   SimdUtils::lessMask( &cosTheta, &delta, &slerpMask );
+   const int slerpLanes = _mm_movemask_ps( slerpMask );
+   if ( slerpLanes != 0 )
+   {
+      // use sqrtInv(1+c^2) instead of 1.0/sin(theta) 
+      __m128 iSinTheta = _mm_sub_ps( Float_1.m_val, _mm_mul_ps( cosTheta, cosTheta ) );
+      SimdUtils::sqrtInverse( &iSinTheta, &iSinTheta );
+
+      // there are no SIMD trigonometric functions, so those are evaluated lane by lane
+      __m128 s0 = _mm_setzero_ps();
+      __m128 s1 = _mm_setzero_ps();
+      for ( int i = 0; i < 4; ++i )
+      {
+         if ( ( slerpLanes & ( 1 << i ) ) != 0 )
+         {
+            const float theta = acos( cosTheta.m128_f32[i] );
+            const float tTheta = tQuad.m128_f32[i] * theta;
+            s0.m128_f32[i] = sin( theta - tTheta );
+            s1.m128_f32[i] = sin( tTheta );
+         }
+      }
+      s0 = _mm_mul_ps( s0, iSinTheta );
+      s1 = _mm_mul_ps( s1, iSinTheta );
+
+      t0 = _mm_or_ps( _mm_and_ps( slerpMask, s0 ), _mm_andnot_ps( slerpMask, t0 ) );
+      t1 = _mm_or_ps( _mm_and_ps( slerpMask, s1 ), _mm_andnot_ps( slerpMask, t1 ) );
+   }
+
+   SimdUtils::flipSign( &t1, &cosThetaLessZero, &t1 );
+
+   __m128 slerpComps[4];
+   for ( int i = 0; i < 4; ++i )
+   {
+      slerpComps[i] = _mm_mul_ps( t0, aComps[i] );
+      SimdUtils::addMul( &slerpComps[i], &t1, &bComps[i], &slerpComps[i] );
+   }
+
+   // normalize the results
+   __m128 lengthSq = _mm_mul_ps( slerpComps[0], slerpComps[0] );
+   SimdUtils::addMul( &lengthSq, &slerpComps[1], &slerpComps[1], &lengthSq );
+   SimdUtils::addMul( &lengthSq, &slerpComps[2], &slerpComps[2], &lengthSq );
+   SimdUtils::addMul( &lengthSq, &slerpComps[3], &slerpComps[3], &lengthSq );
+   const __m128 length = _mm_sqrt_ps( lengthSq );
+   for ( int i = 0; i < 4; ++i )
+   {
+      slerpComps[i] = _mm_div_ps( slerpComps[i], length );
+   }
+
+   // and transpose them back
+   __m128 slerpRows[4];
+   SimdUtils::transpose( slerpComps, slerpRows );
+   for ( int i = 0; i < 4; ++i )
+   {
+      outQuats[i].m_quad = slerpRows[i];
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 void Quaternion::getAxis( Vector& outAxis ) const
 {
    __m128 axis = m_quad;
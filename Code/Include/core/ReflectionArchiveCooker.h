@@ -0,0 +1,88 @@
+/// @file   core/ReflectionArchiveCooker.h
+/// @brief  a tool that converts serialized archives to a format that can be loaded in place
+#pragma once
+
+#include "core\types.h"
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+class InStream;
+class OutStream;
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Header of a cooked archive.
+ *
+ * A cooked archive is a single block of memory that starts with this header.
+ * All offsets are expressed in bytes, relative to the beginning of the block,
+ * so once the block is in memory ( read in one go or mapped ), the tables it contains
+ * can be used in place - without parsing them first.
+ */
+struct CookedArchiveHeader
+{
+   // a section with the external dependencies, stored exactly the way ReflectionSaver stores it
+   uint              m_externalDependenciesOffset;
+   uint              m_externalDependenciesSize;
+
+   // a table of CookedArchiveObject entries, one per serialized object
+   uint              m_objectsOffset;
+   uint              m_objectsCount;
+
+   // a table of indices ( into the objects table ) of the main objects stored in the archive
+   uint              m_indicesOffset;
+   uint              m_indicesCount;
+
+   // a string table the serialized data refers to ( see ReflectionStringTable ), stored the way ReflectionStringTable::save stores it.
+   // Its size is 0 if the original archive didn't come with one
+   uint              m_stringTableOffset;
+   uint              m_stringTableSize;
+};
+
+/**
+ * An entry of the objects table of a cooked archive.
+ */
+struct CookedArchiveObject
+{
+   // object's unique id ( not NULL terminated )
+   uint              m_uniqueIdOffset;
+   uint              m_uniqueIdLength;
+
+   // serialized object data, as produced by SerializableReflectionType::save
+   uint              m_dataOffset;
+   uint              m_dataSize;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A tool that converts the archives written by ReflectionSaver to the cooked format.
+ *
+ * A cooked archive contains exactly the same data as the original one, however it's laid
+ * out as a single block of memory indexed with a table of contents. ReflectionLoader
+ * recognizes such archives and brings them into memory with a single read ( or addresses
+ * the mapped file directly ), and uses the tables in place instead of parsing them.
+ *
+ * The objects themselves are still restored field by field by their reflection types - 
+ * they contain virtual tables and STL containers, so their memory can't be simply
+ * mapped. What the format saves are the reads and the parsing of the tables, and the
+ * deserialization of the objects an instances tracker already knows about.
+ *
+ * The format is meant for the shipping builds only - the block is stored using
+ * the native byte order and isn't meant to be edited.
+ */
+class ReflectionArchiveCooker
+{
+public:
+   /**
+    * Cooks an archive.
+    *
+    * @param archive             stream with an archive written by ReflectionSaver
+    * @param outCookedArchive    stream the cooked archive should be written to
+    * @return                    'true' if the archive was cooked, 'false' if the input stream didn't contain a valid archive
+    */
+   static bool cook( InStream& archive, OutStream& outCookedArchive );
+};
+
+///////////////////////////////////////////////////////////////////////////////
@@ -21,6 +21,10 @@ class ReflectionEnum : public ReflectionType
 {
    DECLARE_ALLOCATOR( ReflectionEnum, AM_DEFAULT );
 
+private:
+   // the enumerators are registered only when they're needed for the first time
+   mutable volatile bool                     m_isDefined;
+
 public:
    /**
     * Constructor.
@@ -51,10 +55,26 @@ public:
     */
    virtual int getValue( const std::string& enumeratorName ) const { return -1; }
 
+   /**
+    * Registers the enumerators, unless they've been registered already.
+    */
+   void define() const;
+
+   /**
+    * Tells if the enumerators have already been registered.
+    */
+   inline bool isDefined() const { return m_isDefined; }
+
    // -------------------------------------------------------------------------
    // ReflectionType implementation
    // -------------------------------------------------------------------------
    bool isA( const ReflectionType& referenceType ) const;
+
+protected:
+   /**
+    * Registers the enumerators the enum has.
+    */
+   virtual void registerEnumerators() {}
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -107,7 +127,7 @@ public:
    inline AssocMap &getMap();
 
    /**
-    * Registers the enumerators the enum has.
+    * Registers the enumerators the enum has ( see BEGIN_ENUM ). Called by ReflectionEnum::define.
     */
    void registerEnumerators();
 
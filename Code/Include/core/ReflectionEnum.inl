@@ -26,6 +26,7 @@ TReflectionEnum< EnumType >::TReflectionEnum( const std::string& typeName )
 template< typename EnumType >
 typename TReflectionEnum< EnumType >::AssocMap& TReflectionEnum< EnumType >::getMap()
 {
+   define();
    return m_assocMap;
 }
 
@@ -34,7 +35,7 @@ typename TReflectionEnum< EnumType >::AssocMap& TReflectionEnum< EnumType >::get
 template< typename EnumType >
 void TReflectionEnum< EnumType >::registerEnumerator( const EnumType enumerator, const std::string &eStr )
 {
-   const bool registered = getMap().insert( typename AssocMap::value_type( enumerator, eStr ) ).second;
+   const bool registered = m_assocMap.insert( typename AssocMap::value_type( enumerator, eStr ) ).second;
    ASSERT( registered );
 }
 
@@ -45,6 +46,8 @@ const std::string& TReflectionEnum< EnumType >::from( const EnumType enumerator
 {
    static const std::string emptyStr;
 
+   define();
+
    // Search for the string in our map.
    const typename AssocMap::const_iterator it = m_assocMap.find( enumerator );
 
@@ -64,6 +67,8 @@ const std::string& TReflectionEnum< EnumType >::from( const EnumType enumerator
 template< typename EnumType >
 const bool TReflectionEnum< EnumType >::to( const std::string& str, EnumType& outEnumerator ) const
 {
+   define();
+
    // search for the enumerator in our map
    typename AssocMap::const_iterator it = m_assocMap.begin();
    for ( ; it != m_assocMap.end(); ++it )
@@ -101,6 +106,8 @@ const bool TReflectionEnum< EnumType >::to( const std::string& str, EnumType& ou
 template< typename EnumType >
 int TReflectionEnum< EnumType >::getIndex( int enumeratorValue ) const
 {
+   define();
+
    int idx = 0;
    for ( typename AssocMap::const_iterator it = m_assocMap.begin(); it != m_assocMap.end(); ++it, ++idx )
    {
@@ -119,6 +126,8 @@ int TReflectionEnum< EnumType >::getIndex( int enumeratorValue ) const
 template< typename EnumType >
 void TReflectionEnum< EnumType >::getEnumerators( std::vector< std::string >& outEnumerators ) const
 {
+   define();
+
    for ( AssocMap::const_iterator it = m_assocMap.begin(); it != m_assocMap.end(); ++it )
    {
       outEnumerators.push_back( it->second );
@@ -43,6 +43,8 @@ private:
    // remapping offset for the external dependencies
    uint                                      m_externalDependenciesOffset;
 
+   bool                                      m_wasCompressed;
+
 public:
    /**
     * Constructor.
@@ -55,6 +57,9 @@ public:
    /**
     * Deserializes new data from the stream.
     *
+    * Both the archives written by ReflectionSaver ( compressed or not ) and their cooked versions
+    * ( see ReflectionArchiveCooker ) are recognized.
+    *
     * @param inStream
     * @param outDependenciesToLoad           if specified, it will tell the caller what other files should be loaded
     *                                        to make this one complete
@@ -66,6 +71,15 @@ public:
     */
    void deserialize( InStream& inStream, std::vector< FilePath >* outDependenciesToLoad = NULL, std::vector< FilePath >* outRemappedDependencies = NULL );
 
+   /**
+    * Reads only the paths of the external dependencies of the archive, without deserializing
+    * any of the objects it contains. The paths that aren't on the list yet are appended to it.
+    *
+    * @param inStream
+    * @param outDependencies
+    */
+   void readExternalDependencies( InStream& inStream, std::vector< FilePath >& outDependencies );
+
    /**
     * Retrieves the next loaded object.
     *
@@ -78,6 +92,11 @@ public:
    template< typename T >
    T* getNextObject();
 
+   /**
+    * Tells if any of the archives deserialized so far was compressed.
+    */
+   inline bool wasCompressed() const { return m_wasCompressed; }
+
    // -------------------------------------------------------------------------
    // ReflectionDependenciesCallback implementation
    // -------------------------------------------------------------------------
@@ -86,6 +105,26 @@ public:
 private:
    uint loadExternalDependencies( InStream& stream, std::vector< FilePath >* outDependenciesToLoad, std::vector< FilePath >* outRemappedDependencies );
    bool loadInternalDependencies( InStream& stream, uint firstExternalDependencyIdx );
+
+   /**
+    * Deserializes an archive written by ReflectionArchiveCooker.
+    */
+   void deserializeCooked( InStream& inStream, std::vector< FilePath >* outDependenciesToLoad, std::vector< FilePath >* outRemappedDependencies );
+
+   /**
+    * Moves the objects from the dependencies buffer to the lists of the loaded objects.
+    *
+    * @param serializedObjectsIndices        indices of the main objects in the dependencies buffer
+    * @param serializedObjectsCount
+    */
+   void collectLoadedObjects( const uint* serializedObjectsIndices, uint serializedObjectsCount );
+
+   /**
+    * Restores the dependencies of all objects in the dependencies buffer.
+    *
+    * @param firstExternalDependencyIdx      remapping offset for the external dependencies
+    */
+   void restoreAllDependencies( uint firstExternalDependencyIdx );
    
    /**
     * Restores the dependencies on the objects the specified object references.
@@ -19,6 +19,7 @@
       virtual const SerializableReflectionType& getVirtualRTTI() const { return *s_type; } \
       static  const SerializableReflectionType& getStaticRTTI() { return *s_type; } \
       static void setupReflectionType( SerializableReflectionType& type );    \
+      static void bindReflectionType( SerializableReflectionType& type ) { s_type = &type; } \
    private:
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -34,6 +35,7 @@
       virtual const SerializableReflectionType& getVirtualRTTI() const { return *s_type; } \
       static  const SerializableReflectionType& getStaticRTTI() { return *s_type; } \
       static void setupReflectionType( SerializableReflectionType& type );    \
+      static void bindReflectionType( SerializableReflectionType& type ) { s_type = &type; } \
    public:
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -39,6 +39,9 @@ private:
    // a counter that counts the number of references to this object
    int                                                m_referencesCounter;
 
+   // a stamp that changes every time the object changes
+   uint                                               m_changeStamp;
+
 public:
    virtual ~ReflectionObject();
 
@@ -105,6 +108,21 @@ public:
     */
    void notifyPropertyChange( const std::string& propertyName );
 
+   /**
+    * Marks the object as changed, so that its data will be serialized anew
+    * by the savers that use a ReflectionSaveCache.
+    *
+    * The object is marked automatically when its properties change - call this method
+    * only if you modify the serialized members directly.
+    */
+   void markDirty();
+
+   /**
+    * Returns a stamp that changes every time the object is marked as changed.
+    * The stamps are unique among all objects.
+    */
+   inline uint getChangeStamp() const { return m_changeStamp; }
+
    /**
     * Called once an object and all of its dependencies is fully loaded.
     *
@@ -0,0 +1,106 @@
+/// @file   core/ReflectionSaveCache.h
+/// @brief  a cache of serialized objects data that allows to save archives incrementally
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include "core\MemoryRouter.h"
+#include "core\types.h"
+#include "core\Array.h"
+#include "core\ReflectionStringTable.h"
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+class ReflectionObject;
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A cache of serialized objects data.
+ *
+ * When passed to a ReflectionSaver, the saver will reuse the data of the objects
+ * that haven't changed since they were last saved, and will only serialize
+ * the ones that did. An object is considered changed if its change stamp
+ * ( see ReflectionObject::markDirty ) differs from the one it had when it was cached,
+ * or if any of the objects it references ended up at a different position in the archive.
+ *
+ * CAUTION: an object is only marked as changed when its properties are edited
+ * through the reflection properties or when ReflectionObject::notifyPropertyChange is called.
+ * Code that modifies the serialized members directly needs to call ReflectionObject::markDirty.
+ *
+ * The cache describes a single archive - once the saver flushes it,
+ * the entries of the objects that were no longer a part of it are removed.
+ *
+ * The cached data refers to the strings it contains by their indices in the string table
+ * the cache maintains, so the table is shared by all archives saved with the cache,
+ * and it only grows until the cache is cleared.
+ */
+class ReflectionSaveCache
+{
+   DECLARE_ALLOCATOR( ReflectionSaveCache, AM_DEFAULT );
+
+public:
+   struct Entry
+   {
+      DECLARE_ALLOCATOR( Entry, AM_DEFAULT );
+
+      uint                                      m_changeStamp;
+      Array< byte >                             m_data;
+
+      // objects the serialized data references, along with the dependency indices they were serialized with
+      std::vector< const ReflectionObject* >    m_dependencies;
+      std::vector< uint >                       m_dependencyIndices;
+
+      bool                                      m_wasUsed;
+
+      Entry() : m_changeStamp( 0 ), m_wasUsed( false ) {}
+   };
+
+private:
+   typedef std::unordered_map< const ReflectionObject*, Entry* > EntriesMap;
+   EntriesMap                                   m_entries;
+
+   ReflectionStringTable                        m_stringTable;
+
+public:
+   ~ReflectionSaveCache();
+
+   /**
+    * Looks for the cached data of the specified object.
+    *
+    * @param object
+    * @return        cached entry or NULL, if the object wasn't cached yet
+    */
+   Entry* find( const ReflectionObject* object );
+
+   /**
+    * Returns an entry the data of the specified object can be stored in.
+    * The entry is created if it doesn't exist.
+    *
+    * @param object
+    */
+   Entry& store( const ReflectionObject* object );
+
+   /**
+    * Removes the entries that weren't accessed since the last time this method was called.
+    */
+   void removeUnused();
+
+   /**
+    * Removes all entries.
+    */
+   void clear();
+
+   /**
+    * Returns the number of cached objects.
+    */
+   inline uint size() const { return m_entries.size(); }
+
+   /**
+    * Returns the string table the cached data refers to.
+    */
+   inline ReflectionStringTable& getStringTable() { return m_stringTable; }
+};
+
+///////////////////////////////////////////////////////////////////////////////
@@ -4,11 +4,13 @@
 #define _REFLECTION_SAVER_H
 
 #include <vector>
+#include <unordered_map>
 #include "core\MemoryRouter.h"
 #include "core\types.h"
 #include "core\Array.h"
 #include "core\FilePath.h"
 #include "core\ReflectionDependenciesCallback.h"
+#include "core\ReflectionSaveCache.h"
 
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -16,6 +18,7 @@
 class ReflectionObject;
 class OutStream;
 class Resource;
+class ReflectionSaveCache;
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -30,16 +33,24 @@ class Resource;
  * 
  * A single serialized archive can contain multiple files and, when loaded by the resource
  * manager, can add mappings to multiple new file system files.
+ *
+ * Every archive is preceded by a string table ( see ReflectionStringTable ) - the strings,
+ * FilePaths and IDStrings the serialized objects contain are stored in it only once,
+ * and the archive refers to them by their indices.
  */
 class ReflectionSaver : public ReflectionDependencyMapperCallback
 {
    DECLARE_ALLOCATOR( ReflectionSaver, AM_DEFAULT );
 
+private:
+   typedef std::unordered_map< const ReflectionObject*, uint > DependencyIndicesMap;
+
 private:
    OutStream&                                m_outStream;
 
    // saved dependencies
    std::vector< const ReflectionObject* >    m_dependencies;
+   DependencyIndicesMap                      m_dependencyIndices;
 
    // indices in the m_dependencies array of the objects that were passed
    // as an argument of the 'save' method
@@ -47,17 +58,29 @@ private:
 
    // external dependencies that should be saved along with the saved objects
    std::vector< const Resource* >            m_externalDependencies;
+   DependencyIndicesMap                      m_externalDependencyIndices;
 
    // a temporary array that contains objects added as the dependencies, but the dependencies of which have not yet been mapped
    std::vector< const ReflectionObject* >    m_objectsToMap;
 
+   // incremental saving
+   ReflectionSaveCache*                      m_cache;
+
+   bool                                      m_compress;
+
+   // dependencies queried while an object was being serialized, along with the indices they were assigned
+   mutable std::vector< const ReflectionObject* >  m_queriedDependencies;
+   mutable std::vector< uint >               m_queriedDependencyIndices;
+
 public:
    /**
     * Constructor.
     *
     * @param outStream         where should the saver save the serialized objects
+    * @param cache             ( optional ) if specified, the saver will reuse the cached data of the objects
+    *                          that haven't changed since they were last saved
     */
-   ReflectionSaver( OutStream& outStream );
+   ReflectionSaver( OutStream& outStream, ReflectionSaveCache* cache = NULL );
    ~ReflectionSaver();
 
    /**
@@ -84,6 +107,14 @@ public:
     */
    void flush();
 
+   /**
+    * Tells whether the flushed archives should be compressed. ReflectionLoader
+    * recognizes and decompresses such archives automatically.
+    *
+    * @param compress
+    */
+   inline void setCompressed( bool compress ) { m_compress = compress; }
+
    /**
     * Collects all mapped external dependencies.
     *
@@ -109,6 +140,23 @@ private:
    void addInternalDependency( const ReflectionObject* dependency );
    void saveExternalDependencies( OutStream& outStream );
    void saveInternalDependencies( OutStream& outStream );
+   void writeArchive( OutStream& outStream );
+
+   /**
+    * Checks if the cached data of an object can be reused - that is if the object hasn't changed since it was cached
+    * and all the objects it references are still mapped to the same dependency indices.
+    */
+   bool isCacheEntryValid( const ReflectionObject* object, const ReflectionSaveCache::Entry& entry ) const;
+
+   /**
+    * Looks for the dependency index of the specified object, comparing the pointers only.
+    *
+    * @param dependency
+    * @param external   should the object be looked for among the external or the internal dependencies
+    * @param outIdx     dependency index, encoded the way the archive stores it
+    * @return  'false' if the object isn't mapped
+    */
+   bool findDependencyIndex( const ReflectionObject* dependency, bool external, uint& outIdx ) const;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
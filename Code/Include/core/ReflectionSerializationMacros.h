@@ -6,6 +6,9 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #define TAMY_ARCHIVE_MAGIC_NO          0xABCD
+#define TAMY_COOKED_ARCHIVE_MAGIC_NO   0xABCE
+#define TAMY_COMPRESSED_ARCHIVE_MAGIC_NO  0xABCF
+#define TAMY_STRING_TABLE_MAGIC_NO     0xABD0
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -3,14 +3,44 @@
 #pragma once
 
 #include <vector>
+#include "core\MemoryRouter.h"
+#include "core\types.h"
+#include "core\FilePath.h"
 
 
 ///////////////////////////////////////////////////////////////////////////////
 
-class FilePath;
 class ReflectionObject;
 class Resource;
 class IProgressObserver;
+class Filesystem;
+class ResourcesManager;
+class InStream;
+class ResourcesPrefetcher;
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Resources that were deserialized, but haven't been registered with the resources manager yet.
+ */
+struct DeserializedResources
+{
+   DECLARE_ALLOCATOR( DeserializedResources, AM_DEFAULT );
+
+   // paths of the loaded resource and of all the resources it references
+   std::vector< FilePath >             m_paths;
+
+   // external dependencies of the loaded objects ( see ReflectionLoader::deserialize )
+   std::vector< FilePath >             m_remappedDependencies;
+
+   // resources, in the order of their paths ( NULL if a resource couldn't be loaded ), 
+   // along with the number of objects deserialized with each of them
+   std::vector< Resource* >            m_resources;
+   std::vector< uint >                 m_objectsCount;
+
+   // all deserialized objects, grouped by the resources they were loaded with
+   std::vector< ReflectionObject* >    m_allLoadedObjects;
+};
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -111,6 +141,59 @@ public:
     */
    static void loadResources( const FilePath& loadPath, std::vector< Resource* >& outResources, IProgressObserver* progressObserver = NULL );
 
+   /**
+    * The first stage of loading a resource - deserializes the resource and all the resources it references,
+    * without registering them with the resources manager.
+    *
+    * If no resources manager is specified, the resources that are already loaded are deserialized as well,
+    * and the missing ones are left for 'finishLoadingResources' to look up.
+    *
+    * Has to be called from the main thread - the constructors of the deserialized objects may access
+    * the engine's singletons. The files can be read up front on a different thread though ( see ResourcesPrefetcher ).
+    *
+    * @param filesystem
+    * @param loadPath
+    * @param outResources
+    * @param resourcesManager       ( optional ) manager the already loaded resources should be looked up in
+    * @param progressObserver       ( optional )
+    * @param prefetcher             ( optional ) prefetcher that already read the files of the loaded resources
+    */
+   static void deserializeResources( const Filesystem& filesystem, const FilePath& loadPath, DeserializedResources& outResources, ResourcesManager* resourcesManager = NULL, IProgressObserver* progressObserver = NULL, ResourcesPrefetcher* prefetcher = NULL );
+
+   /**
+    * The second stage of loading a resource - registers the deserialized resources with the active
+    * ResourcesManager instance, links their dependencies and notifies them that they were loaded.
+    * Has to be called from the main thread.
+    *
+    * If any of the resources turns out to have been loaded in the meantime, the managed instance
+    * is used and the deserialized copy is discarded.
+    *
+    * If the loading fails, the deserialized resources are deleted.
+    *
+    * @param resources
+    * @param outResources
+    */
+   static void finishLoadingResources( DeserializedResources& resources, std::vector< Resource* >& outResources );
+
+   /**
+    * Deletes deserialized resources that won't be registered with the resources manager.
+    *
+    * @param resources
+    */
+   static void discardResources( DeserializedResources& resources );
+
+   /**
+    * Loads a copy of a managed resource from its file. The copy isn't registered with the resources manager - 
+    * it's meant to replace the contents of the managed instance ( see Resource::replaceContents ).
+    *
+    * The resources the copy references are linked to their managed instances ( the ones that aren't loaded yet get loaded ),
+    * so the references to the resource itself lead to the managed instance as well.
+    *
+    * @param resource
+    * @return  the copy the caller takes the ownership of, or NULL if the resource couldn't be loaded
+    */
+   static Resource* loadResourceCopy( const Resource& resource );
+
    // -------------------------------------------------------------------------
    // Tools
    // -------------------------------------------------------------------------
@@ -123,6 +206,16 @@ public:
     * @param outDependenciesPaths
     */
    static void collectExternalDependencies( const ReflectionObject* objectToMap, std::vector< FilePath >& outDependenciesPaths ); 
+
+   /**
+    * Opens a stream that reads the file a resource is stored in. Binary files are read straight from 
+    * a memory mapping, while the remaining ones go through a regular file stream.
+    *
+    * @param filesystem
+    * @param path
+    * @return     a stream the caller takes the ownership of, or NULL if the file couldn't be opened
+    */
+   static InStream* openResourceStream( const Filesystem& filesystem, const FilePath& path );
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,108 @@
+/// @file   core/ReflectionStringTable.h
+/// @brief  a table of strings shared by all objects stored in a serialized archive
+#pragma once
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include "core\MemoryRouter.h"
+#include "core\types.h"
+#include "core\Array.h"
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+class InStream;
+class OutStream;
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A table of strings shared by all objects stored in a serialized archive.
+ *
+ * When attached to a stream ( see OutStream::setStringTable and InStream::setStringTable ),
+ * the strings, FilePaths and IDStrings written to the stream are replaced with
+ * their indices in the table, so that every string is stored in the archive only once.
+ *
+ * On the loading side, the strings are interned in the IDStringsPool lazily - once per table,
+ * and only when they're read as IDStrings.
+ */
+class ReflectionStringTable
+{
+   DECLARE_ALLOCATOR( ReflectionStringTable, AM_DEFAULT );
+
+private:
+   typedef std::unordered_map< std::string, uint > IndicesMap;
+   IndicesMap                             m_indices;
+
+   std::vector< std::string >             m_strings;
+
+   // ids the strings were assigned in the IDStringsPool ( -1 if the string wasn't interned yet )
+   mutable Array< uint >                  m_stringIds;
+
+   // set when someone asked for a string the table doesn't contain
+   mutable bool                           m_hasInvalidReferences;
+
+public:
+   /**
+    * Constructor.
+    */
+   ReflectionStringTable();
+
+   /**
+    * Adds a string to the table, unless it's already there.
+    *
+    * @param str
+    * @return     index of the string in the table
+    */
+   uint add( const std::string& str );
+
+   /**
+    * Returns the string stored under the specified index.
+    * An index from outside of the table ( a corrupted archive ) resolves to an empty string
+    * and marks the table as referenced incorrectly ( see hasInvalidReferences ).
+    *
+    * @param idx
+    */
+   const std::string& getString( uint idx ) const;
+
+   /**
+    * Returns the IDStringsPool id of the string stored under the specified index.
+    * The string is registered with the pool the first time it's queried for.
+    * An index from outside of the table resolves to the id of an empty string.
+    *
+    * @param idx
+    */
+   uint getStringId( uint idx ) const;
+
+   /**
+    * Returns the number of strings in the table.
+    */
+   inline uint size() const { return m_strings.size(); }
+
+   /**
+    * Tells whether the table was queried for a string it doesn't contain since it was loaded.
+    */
+   inline bool hasInvalidReferences() const { return m_hasInvalidReferences; }
+
+   /**
+    * Removes all strings from the table.
+    */
+   void clear();
+
+   /**
+    * Saves the table to a stream.
+    *
+    * @param stream
+    */
+   void save( OutStream& stream ) const;
+
+   /**
+    * Loads the table from a stream, replacing its current contents.
+    *
+    * @param stream
+    */
+   void load( InStream& stream );
+};
+
+///////////////////////////////////////////////////////////////////////////////
@@ -6,6 +6,7 @@
 #include <vector>
 #include <string>
 #include <map>
+#include <unordered_map>
 #include <list>
 #include "core\MemoryRouter.h"
 #include "core\types.h"
@@ -33,21 +34,16 @@ class SerializationFlag
 private:
    static SerializationFlag s_theInstance;
 
-   // <threading.todo> Thread safety is not yet implemented, since the engine is running on a single thread.
-   // As soon as we implement multithreading, make this class has a flag for each running thread ( since
-   // loading will be implemented on threads )
-   bool    m_serializationInProgress;
-
 public:
    static inline SerializationFlag& getInstance() { return s_theInstance; }
 
    /**
-    * Checks if the serialization is in progress.
+    * Checks if the serialization is in progress on the calling thread.
     */
    bool isSerializationInProgress();
 
    /**
-    * Flags whether the serialization is in progress.
+    * Flags whether the serialization is in progress on the calling thread.
     *
     * @param inProgress
     */
@@ -137,6 +133,10 @@ class SerializableReflectionType : public ReflectionType
 {
    DECLARE_ALLOCATOR( SerializableReflectionType, AM_DEFAULT );
 
+public:
+   // a function that defines the type's base types and members ( see BEGIN_OBJECT )
+   typedef void (*TypeDefinition)( SerializableReflectionType& );
+
 public:
    std::string                                        m_patchedName;
    unsigned int                                       m_patchedId;
@@ -144,14 +144,36 @@ public:
    SerializableTypeInstantiator*                      m_instantiator;
    std::vector< ReflectionTypeComponent* >            m_memberFields;
 
-   typedef std::map< uint, uint >                     NamesMap;
+   typedef std::unordered_map< uint, uint >           NamesMap;
    NamesMap                                           m_patchedMemberNames;
 
+   // member fields indexed by their ids
+   typedef std::unordered_map< uint, ReflectionTypeComponent* >  MembersMap;
+   MembersMap                                         m_membersMap;
+
    std::vector< uint >                                m_baseTypesIds;
 
-   // runtime data
+   // runtime data ( created when the type gets defined )
    MemoryPool*                                        m_searchMemPool;
 
+   // a dense index assigned to the type by the types registry
+   uint                                               m_hierarchyIdx;
+
+private:
+   // the type definition is run only when the base types or the members are needed for the first time
+   TypeDefinition                                     m_definition;
+   mutable volatile bool                              m_isDefined;
+
+   // flattened types hierarchy - a bit is set for the hierarchy index of
+   // every type this type derives from ( including the type itself ).
+   // It's rebuilt whenever the registry contents change.
+   mutable std::vector< uint >                        m_ancestorsMask;
+   mutable volatile uint                              m_ancestryVersion;
+
+   // member fields of this type and all of its parent types, indexed by their ids.
+   // Rebuilt together with the ancestors mask.
+   mutable MembersMap                                 m_hierarchyMembersMap;
+
 public:
    /**
     * Constructor.
@@ -181,6 +203,27 @@ public:
    // Type definition
    // ----------------------------------------------------------------------
 
+   /**
+    * Sets up a function that defines the base types and the members of this type.
+    * The function won't be run until they're needed ( see define ).
+    *
+    * @param definition
+    */
+   void setupDefinition( TypeDefinition definition );
+
+   /**
+    * Runs the type definition, unless it's been run already.
+    *
+    * All methods that access the base types or the members call it, so it needs
+    * to be called explicitly only before the public member lists are accessed directly.
+    */
+   void define() const;
+
+   /**
+    * Tells if the type definition has already been run.
+    */
+   inline bool isDefined() const { return m_isDefined; }
+
    /**
     * Defines a base type of this type ( in order to set up an inheritance hierarchy ).
     *
@@ -211,6 +254,14 @@ public:
     */
    ReflectionTypeComponent* findMemberField( const std::string& memberName ) const;
 
+   /**
+    * Looks for a member with the specified member id in this type and in its parent types.
+    *
+    * @param      memberId
+    * @return     pointer to the member definition, or NULL if such a member is not defined
+    */
+   ReflectionTypeComponent* findHierarchyMemberField( uint memberId ) const;
+
    /**
     * Creates the properties for this type and the specified object.
     *
@@ -280,12 +331,30 @@ public:
    static T* load( InStream& stream );
 
 
+   // ----------------------------------------------------------------------
+   // Comparison
+   // ----------------------------------------------------------------------
+
+   /**
+    * Checks if this type can be downcast onto the specified reference type.
+    * The check takes constant time.
+    *
+    * @param referenceType
+    */
+   inline bool isA( const SerializableReflectionType& referenceType ) const;
+
    // ----------------------------------------------------------------------
    // ReflectionType implementation
    // ----------------------------------------------------------------------
    bool isA( const ReflectionType& referenceType ) const;
 
 private:
+   /**
+    * Flattens the inheritance hierarchy of this type into the ancestors mask
+    * and the hierarchy members map.
+    */
+   void rebuildAncestry() const;
+
    template< typename T >
    void saveMemberFields( const T* object, const ReflectionSaver& dependenciesMapper, OutStream& stream ) const;
 
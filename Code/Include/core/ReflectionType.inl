@@ -44,6 +44,36 @@ T* SerializableReflectionType::instantiate() const
 
 ///////////////////////////////////////////////////////////////////////////////
 
+bool SerializableReflectionType::isA( const SerializableReflectionType& referenceType ) const
+{
+   if ( m_id == referenceType.m_id )
+   {
+      return true;
+   }
+
+   if ( m_ancestryVersion != ReflectionTypesRegistry::getInstance().m_hierarchyVersion )
+   {
+      rebuildAncestry();
+   }
+
+   uint refIdx = referenceType.m_hierarchyIdx;
+   if ( refIdx == (uint)-1 )
+   {
+      // the reference type isn't registered itself - use the registered type with the same id
+      const SerializableReflectionType* registeredType = ReflectionTypesRegistry::getInstance().findSerializable( referenceType.m_id );
+      if ( registeredType == NULL )
+      {
+         return false;
+      }
+      refIdx = registeredType->m_hierarchyIdx;
+   }
+
+   uint wordIdx = refIdx >> 5;
+   return wordIdx < m_ancestorsMask.size() && ( m_ancestorsMask[wordIdx] & ( 1u << ( refIdx & 31 ) ) ) != 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 bool SerializableReflectionType::isAbstract() const
 {
    return m_instantiator == NULL;
@@ -85,6 +115,7 @@ void SerializableReflectionType::save( const T& object, const ReflectionSaver& d
       // info so that if this class gets removed from the inheritance
       // hierarchy, we can still deserialize the object properly
       OutArrayStream tempDataStream( tempSerializationDataBuf );
+      tempDataStream.setStringTable( stream.getStringTable() );
 
       nextType->saveMemberFields( &object, dependenciesMapper, tempDataStream );
 
@@ -176,6 +207,7 @@ void SerializableReflectionType::saveMemberFields( const T* object, const Reflec
 
    Array< byte > tempSerializationDataBuf;
    OutArrayStream tempDataStream( tempSerializationDataBuf );
+   tempDataStream.setStringTable( stream.getStringTable() );
 
    for ( uint i = 0; i < membersCount; ++i )
    {
@@ -3,7 +3,7 @@
 #ifndef _REFLECTION_TYPES_REGISTRY_H
 #define _REFLECTION_TYPES_REGISTRY_H
 
-#include <map>
+#include <unordered_map>
 #include <vector>
 #include <core\types.h>
 
@@ -13,8 +13,38 @@
 class ReflectionType;
 class SerializableReflectionType;
 struct SerializableTypeInstantiator;
-class MemoryPool;
-class MemoryPoolAllocator;
+class CriticalSection;
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A registration of reflection types, created by the type registration macros
+ * ( see TypeRegistrationMacros.h ).
+ *
+ * The registrations are linked in the order they were created, so that they can be
+ * replayed once the registry's been cleared.
+ */
+struct TypesRegistration
+{
+private:
+   static TypesRegistration*                                s_first;
+   static TypesRegistration*                                s_last;
+   TypesRegistration*                                       m_next;
+
+public:
+   TypesRegistration();
+   virtual ~TypesRegistration() {}
+
+   /**
+    * Adds the types to the registry.
+    */
+   virtual void registerTypes() = 0;
+
+   /**
+    * Runs all registrations, in the order they were created.
+    */
+   static void registerAll();
+};
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -24,21 +54,23 @@ class MemoryPoolAllocator;
 class ReflectionTypesRegistry
 {
 public:
-   MemoryPoolAllocator*                                     m_sharedMemoryPoolAllocator;
+   // Changes every time the set of registered serializable types changes, so that 
+   // the types can tell when their flattened hierarchies need to be rebuilt.
+   uint                                                     m_hierarchyVersion;
 
-   // This memory pool can be accessed using the exposed public allocator - m_sharedMemoryPoolAllocator.
-   // It's main purpose is to provide a common, dedicated area in memory for all type-related
-   // functionality in order to avoid constant memory reallocations
-   MemoryPool*                                              m_sharedMemoryPool;
+   // guards the lazily run type definitions and the rebuilds of the flattened types hierarchies
+   // ( see SerializableReflectionType::define and SerializableReflectionType::rebuildAncestry )
+   CriticalSection*                                         m_definitionsLock;
 
 private:
-   typedef std::map< int, ReflectionType* >                 BaseTypesMap;
-   typedef std::map< int, SerializableReflectionType* >     SerializableTypesMap;
+   typedef std::unordered_map< uint, ReflectionType* >                 BaseTypesMap;
+   typedef std::unordered_map< uint, SerializableReflectionType* >     SerializableTypesMap;
 
    BaseTypesMap                                             m_externalTypesMap;
    SerializableTypesMap                                     m_serializableTypesMap;
    std::vector< ReflectionType* >                           m_allTypes;
    ReflectionType*                                          m_genericEnumType;
+   uint                                                     m_nextHierarchyIdx;
 
 private:
    static ReflectionTypesRegistry*                          s_theInstance;
@@ -125,6 +157,14 @@ public:
    void getMatchingSerializableTypes( std::vector< const SerializableReflectionType* >& outTypes, bool includeAbstractTypes ) const;
    void getMatchingSerializableTypes( uint id, std::vector< const SerializableReflectionType* >& outTypes, bool includeAbstractTypes ) const;
 
+   /**
+    * Runs the definitions of all registered types and enums.
+    *
+    * The definitions are normally run the first time a type is used ( see SerializableReflectionType::define ),
+    * which keeps the startup fast. This method defines them all up front instead.
+    */
+   void defineAllTypes();
+
    /**
     * Flushes all registered types.
     */
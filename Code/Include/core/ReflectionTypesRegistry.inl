@@ -39,13 +39,19 @@ bool ReflectionTypesRegistry::addSerializableType( const std::string& typeName,
       // create an instantiator for the type, but only for non-abstract types
       type->setupInstantiator( instantiator );
 
-      // setup the type properties
-      T::setupReflectionType( *type );
+      // the type properties will be set up the first time they're needed - here we only
+      // let the class know about its type
+      T::bindReflectionType( *type );
+      type->setupDefinition( &T::setupReflectionType );
 
       // add the type to the types map
       m_serializableTypesMap.insert( std::make_pair( type->m_id, type ) );
       m_allTypes.push_back( type );
 
+      // assign the type a slot in the flattened hierarchies and invalidate the existing ones
+      type->m_hierarchyIdx = m_nextHierarchyIdx++;
+      ++m_hierarchyVersion;
+
       // now check if the type is a 'patch type' and if so, add another mapping to it
       if ( type->m_patchedId < (unsigned int)-1 )
       {
@@ -106,9 +112,6 @@ bool ReflectionTypesRegistry::addEnumType( const std::string& typeName )
    }
    else
    {
-      // setup the type
-      type->registerEnumerators();
-
       // add the type to the types map
       m_externalTypesMap.insert( std::make_pair( type->m_id, type ) );
       m_allTypes.push_back( type );
@@ -14,6 +14,7 @@
 
 class ResourcesManager;
 class ReflectionType;
+class ReflectionSaveCache;
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -34,6 +35,7 @@ public:
    };
 
    friend class ResourcesManager;
+   friend class ReflectionSerializationUtil;
 
 private:
    FilePath                         m_filePath;
@@ -42,6 +44,17 @@ private:
    std::vector< ResourceObject* >   m_managedObjects;
    std::vector< int >               m_freeIds;
 
+   ReflectionSaveCache*             m_saveCache;
+   bool                             m_isCompressed;
+
+   // change stamp of the contents as they were when the resource was last loaded or saved
+   uint                             m_savedChangeStamp;
+
+   // memory budget related data, maintained by the resources manager
+   uint                             m_lastAccessStamp;
+   uint                             m_usersCount;     // how many times the resource was acquired and not released yet
+   bool                             m_isReleased;     // set once the last of its users releases it
+
 public:
    /**
     * Constructor.
@@ -69,11 +82,85 @@ public:
     */
    void saveResource();
 
+   /**
+    * Enables incremental saving of the resource - once it's saved, only the objects
+    * that changed since then will be serialized anew the next time it's saved.
+    *
+    * CAUTION: see ReflectionSaveCache for the requirements the saved objects need to meet.
+    *
+    * @param enable
+    */
+   void setIncrementalSaving( bool enable );
+
+   /**
+    * Returns the cache of the serialized data used for incremental saving, or NULL
+    * if incremental saving is disabled.
+    */
+   inline ReflectionSaveCache* getSaveCache() const { return m_saveCache; }
+
+   /**
+    * Tells whether the resource file should be compressed when the resource is saved.
+    * Resources loaded from compressed files have it set automatically.
+    *
+    * @param compressed
+    */
+   inline void setCompressed( bool compressed ) { m_isCompressed = compressed; }
+
+   /**
+    * Tells whether the resource file is compressed.
+    */
+   inline bool isCompressed() const { return m_isCompressed; }
+
+   /**
+    * Tells whether the resource or any of its managed objects changed since the resource was last loaded or saved
+    * ( see ReflectionObject::markDirty ). A resource that was never saved is considered changed.
+    */
+   bool isDirty() const;
+
    /**
     * Tells whether the resource is managed by a resources manager.
     */
    inline bool isManaged() const { return m_host != NULL; }
 
+   /**
+    * Returns an estimate of the amount of memory ( in bytes ) the resource occupies.
+    *
+    * The resources manager uses it to keep the loaded resources within its memory budget.
+    * The default implementation accounts only for the resource and its managed objects instances -
+    * resources that hold large buffers should override it and account for them as well.
+    */
+   virtual uint getMemoryUsage() const;
+
+   /**
+    * Tells whether the resource can merge the contents of other resources of its type into itself
+    * ( see 'mergeContents' ). Only such resources can have their imports cached ( see ResourcesManager::import ).
+    */
+   virtual bool canMergeContents() const { return false; }
+
+   /**
+    * Merges the contents of another resource of the same type into this one. The merged resource
+    * is about to be discarded, so its contents may be moved rather than copied.
+    *
+    * @param rhs
+    */
+   virtual void mergeContents( Resource& rhs ) {}
+
+   /**
+    * Tells whether the resource can replace its contents with the contents of another resource of its type
+    * ( see 'replaceContents' ). Only such resources can be reloaded when their files get edited 
+    * ( see ResourcesManager::processEditedFiles ).
+    */
+   virtual bool canReplaceContents() const { return false; }
+
+   /**
+    * Replaces the contents of this resource with the contents of another resource of the same type.
+    * The resource is reloaded in place that way, so the pointers to it remain valid.
+    * The other resource is about to be discarded, so its contents may be moved rather than copied.
+    *
+    * @param rhs
+    */
+   virtual void replaceContents( Resource& rhs ) {}
+
    /**
     * Returns an extension of this resource instance.
     */
@@ -148,6 +235,16 @@ protected:
     */
    void resetResourcesManager();
 
+   /**
+    * Memorizes that the current contents of the resource are the ones stored in its file.
+    */
+   void markClean();
+
+   /**
+    * Returns the most recent change stamp of the resource and its managed objects.
+    */
+   uint getContentsChangeStamp() const;
+
    // -------------------------------------------------------------------------
    // Notifications
    // -------------------------------------------------------------------------
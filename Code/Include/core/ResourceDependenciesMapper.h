@@ -5,8 +5,14 @@
 #include "core/ReflectionDependenciesCallback.h"
 #include "core/FilePath.h"
 #include <vector>
+#include <unordered_set>
 
 
+///////////////////////////////////////////////////////////////////////////////
+
+class Filesystem;
+class ResourcesManager;
+
 ///////////////////////////////////////////////////////////////////////////////
 
 /**
@@ -19,6 +25,8 @@ private:
 
    // runtime data
    std::vector< const ReflectionObject* >    m_objectsToCheck;
+   std::unordered_set< FilePath, FilePathHash > m_mappedPaths;
+   std::vector< FilePath >                   m_fileDependencies;
 
 public:
    /**
@@ -36,6 +44,20 @@ public:
     */
    void mapDependencies( const ReflectionObject* objectToProcess );
 
+   /**
+    * Finds all resources the resource stored in the specified file depends on, be it directly or
+    * through other resources. Only the dependency tables of the files are read - none of the objects
+    * gets deserialized, so the whole set is known before the resource starts loading.
+    *
+    * The path of the resource itself is put on the list first. The paths that are already
+    * on the list are considered mapped.
+    *
+    * @param filesystem
+    * @param resourcePath
+    * @param loadedResources  ( optional ) the resources this manager contains won't be mapped any further
+    */
+   void mapFileDependencies( const Filesystem& filesystem, const FilePath& resourcePath, ResourcesManager* loadedResources = NULL );
+
    // -------------------------------------------------------------------------
    // ReflectionDependenciesCallback implementation
    // -------------------------------------------------------------------------
@@ -83,6 +83,11 @@ protected:
    std::string          m_resourcePath;
    int                  m_objectId;
 
+private:
+   // the resource the handle points to is cached until the resources in the manager change
+   mutable Resource*    m_resource;
+   mutable uint         m_resourcesGeneration;
+
 public:
    /**
     * Constructor.
@@ -95,6 +100,15 @@ public:
    virtual ~ResourceHandle() {}
 
    void onObjectPreSave();
+
+protected:
+   /**
+    * Returns the resource the handle points to, or NULL if the resources manager doesn't have it.
+    *
+    * The resource is looked up only the first time it's needed and after a resource gets removed
+    * from the manager - otherwise the cached pointer is returned.
+    */
+   Resource* getResource() const;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
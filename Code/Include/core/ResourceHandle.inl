@@ -31,7 +31,7 @@ TResourceHandle< T >::TResourceHandle( const std::string& resourcePath, int obje
 template< typename T >
 T& TResourceHandle< T >::get()
 {
-   Resource* resource = ResourcesManager::getInstance().findResource( m_resourcePath );
+   Resource* resource = getResource();
    if ( resource == NULL )
    {
       char msg[512];
@@ -56,7 +56,7 @@ T& TResourceHandle< T >::get()
 template< typename T >
 const T& TResourceHandle< T >::get() const
 {
-   Resource* resource = ResourcesManager::getInstance().findResource( m_resourcePath );
+   Resource* resource = getResource();
    if ( resource == NULL )
    {
       char msg[512];
@@ -39,6 +39,27 @@ public:
     */
    virtual bool canImport( const ReflectionType& resourceType ) const = 0;
 
+   /**
+    * Returns the version of the importer. Bump it up whenever the importer starts producing different
+    * results from the same file, so that the results cached by the previous version don't get reused.
+    */
+   virtual uint getVersion() const { return 1; }
+
+   /**
+    * The first stage of the import - reads and parses the imported file, without
+    * creating any resources yet.
+    *
+    * Batch imports ( see ResourcesManager::importBatch ) run it on worker threads, so it can't access
+    * the resources manager ( apart from its filesystem ) nor the progress observer. The importers that don't
+    * override it do all of their work in the 'import' method.
+    */
+   virtual void parse() {}
+
+   /**
+    * Returns the path of the imported file.
+    */
+   inline const FilePath& getImportedFilePath() const { return m_loadedFileName; }
+
 protected:
    /**
     * Constructor.
@@ -69,7 +90,7 @@ public:
    virtual ~TResourceImporter() {}
 
    /**
-    * Imports the resource.
+    * Imports the resource. The manager calls it after the file was parsed ( see ResourceImporter::parse ).
     *
     * @param resource         resource the contents of which we want to import
     */
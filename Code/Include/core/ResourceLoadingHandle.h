@@ -0,0 +1,147 @@
+/// @file   core/ResourceLoadingHandle.h
+/// @brief  a handle to a resource that's being loaded in the background
+#ifndef _RESOURCE_LOADING_HANDLE_H
+#define _RESOURCE_LOADING_HANDLE_H
+
+#include <vector>
+#include "core\MemoryRouter.h"
+#include "core\FilePath.h"
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+class Resource;
+class ResourceLoadingHandle;
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Gets notified when a resource loaded in the background becomes available.
+ */
+class ResourceLoadingListener
+{
+public:
+   virtual ~ResourceLoadingListener() {}
+
+   /**
+    * Called when the loading finishes - whether it succeeded or not.
+    *
+    * @param handle
+    */
+   virtual void onResourceLoaded( ResourceLoadingHandle& handle ) = 0;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+enum ResourceLoadingState
+{
+   RLS_PENDING,
+   RLS_LOADED,
+   RLS_FAILED
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A handle to a resource that's being loaded in the background ( see ResourcesManager::loadAsync ).
+ *
+ * The handle can either be polled, or a listener can be attached to it. Either way,
+ * it's the main thread the handle gets completed on ( in ResourcesManager::processLoadedResources ),
+ * so the resource can be used right away.
+ *
+ * The handle is reference counted - release it using 'removeReference' once it's no longer needed.
+ */
+class ResourceLoadingHandle
+{
+   DECLARE_ALLOCATOR( ResourceLoadingHandle, AM_DEFAULT );
+
+private:
+   FilePath                                  m_path;
+   ResourceLoadingState                      m_state;
+   Resource*                                 m_resource;
+   std::vector< ResourceLoadingListener* >   m_listeners;
+   int                                       m_referencesCounter;
+
+   friend class ResourcesManager;
+
+public:
+   /**
+    * Constructor.
+    *
+    * @param path       path of the loaded resource
+    */
+   ResourceLoadingHandle( const FilePath& path );
+
+   /**
+    * Returns the path of the loaded resource.
+    */
+   inline const FilePath& getPath() const { return m_path; }
+
+   /**
+    * Returns the loading state.
+    */
+   inline ResourceLoadingState getState() const { return m_state; }
+
+   /**
+    * Tells if the resource is still being loaded.
+    */
+   inline bool isPending() const { return m_state == RLS_PENDING; }
+
+   /**
+    * Returns the loaded resource, or NULL if the resource isn't available ( yet ).
+    * The handle holds a reference to the resource, so it won't be evicted while the handle is alive.
+    */
+   inline Resource* getResource() const { return m_resource; }
+
+   /**
+    * Returns the loaded resource, or NULL if the resource isn't available ( yet ) or is of a different type.
+    */
+   template< typename T >
+   T* get() const;
+
+   /**
+    * Attaches a listener that will be notified when the loading finishes.
+    * If it already has, the listener is notified immediately.
+    *
+    * @param listener
+    */
+   void attach( ResourceLoadingListener& listener );
+
+   /**
+    * Detaches a listener.
+    *
+    * @param listener
+    */
+   void detach( ResourceLoadingListener& listener );
+
+   // -------------------------------------------------------------------------
+   // References counting
+   // -------------------------------------------------------------------------
+   /**
+    * Adds a reference to the handle.
+    */
+   void addReference();
+
+   /**
+    * Removes a reference to the handle. The handle is deleted once it's no longer referenced.
+    */
+   void removeReference();
+
+private:
+   ~ResourceLoadingHandle();
+
+   /**
+    * Completes the loading.
+    *
+    * @param resource      loaded resource, or NULL if the loading failed
+    */
+   void complete( Resource* resource );
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#include "core/ResourceLoadingHandle.inl"
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // _RESOURCE_LOADING_HANDLE_H
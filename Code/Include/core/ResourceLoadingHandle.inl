@@ -0,0 +1,18 @@
+#ifndef _RESOURCE_LOADING_HANDLE_H
+#error "This file can only be included from ResourceLoadingHandle.h"
+#else
+
+#include "core/Resource.h"
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+template< typename T >
+T* ResourceLoadingHandle::get() const
+{
+   return m_resource ? DynamicCast< T >( m_resource ) : NULL;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // _RESOURCE_LOADING_HANDLE_H
@@ -0,0 +1,95 @@
+/// @file   core/ResourcesLoadingThread.h
+/// @brief  a thread that loads resources in the background
+#pragma once
+
+#include <list>
+#include "core\MemoryRouter.h"
+#include "core\Thread.h"
+#include "core\FilePath.h"
+#include "core\ResourcesPrefetcher.h"
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+class Filesystem;
+class ResourceLoadingHandle;
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A thread that reads the files of the resources in the background.
+ *
+ * The thread only maps the dependencies of the requested resource and reads their files ( see ResourcesPrefetcher ).
+ * The objects are deserialized once the completed requests are collected on the main thread - their constructors
+ * are free to access the engine's singletons, which aren't guarded against the concurrent access.
+ *
+ * The requests are processed in the order they were added.
+ */
+class ResourcesLoadingThread : public Thread
+{
+   DECLARE_ALLOCATOR( ResourcesLoadingThread, AM_DEFAULT );
+
+public:
+   struct Request
+   {
+      DECLARE_ALLOCATOR( Request, AM_DEFAULT );
+
+      FilePath                   m_path;
+      ResourcesPrefetcher        m_prefetcher;
+
+      // handle the request was issued for - the thread doesn't touch it
+      ResourceLoadingHandle*     m_handle;
+
+      Request( const Filesystem& filesystem, const FilePath& path, ResourceLoadingHandle* handle ) : m_path( path ), m_prefetcher( filesystem ), m_handle( handle ) {}
+   };
+
+private:
+   CriticalSection               m_lock;
+   ThreadEvent                   m_requestAdded;
+   ThreadEvent                   m_requestCompleted;
+   std::list< Request* >         m_pendingRequests;
+   std::list< Request* >         m_completedRequests;
+   bool                          m_exit;
+
+public:
+   /**
+    * Constructor. Starts the thread.
+    */
+   ResourcesLoadingThread();
+
+   /**
+    * Destructor. Stops the thread - the requests that weren't collected are discarded,
+    * and the handles they were issued for are left untouched.
+    */
+   ~ResourcesLoadingThread();
+
+   /**
+    * Adds a new loading request. The thread takes over its ownership.
+    *
+    * @param request
+    */
+   void addRequest( Request* request );
+
+   /**
+    * Returns the next completed request. The caller takes over its ownership.
+    *
+    * @return     completed request, or NULL if there are none at the moment
+    */
+   Request* popCompletedRequest();
+
+   /**
+    * Blocks until a request gets completed ( returns immediately if any completed requests are waiting to be collected ).
+    */
+   void waitForCompletedRequest();
+
+protected:
+   // -------------------------------------------------------------------------
+   // Thread implementation
+   // -------------------------------------------------------------------------
+   void run();
+
+private:
+   void deleteRequests( std::list< Request* >& requests );
+};
+
+///////////////////////////////////////////////////////////////////////////////
@@ -4,6 +4,8 @@
 #define _RESOURCES_MANAGER_H
 
 #include <map>
+#include <unordered_map>
+#include <unordered_set>
 #include <string>
 #include "core\ComponentsManager.h"
 #include "core\Filesystem.h"
@@ -22,6 +24,54 @@ class IProgressObserver;
 class FilesystemScanner;
 class FilePath;
 class ReflectionSerializationUtil;
+class ResourceLoadingHandle;
+class ResourcesLoadingThread;
+
+///////////////////////////////////////////////////////////////////////////////
+
+// directory the results of the imports are cached in ( see ResourcesManager::import )
+#define IMPORT_CACHE_DIR      "/.importCache/"
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Statistics describing how well the loaded resources are reused.
+ */
+struct ResourcesStatistics
+{
+   uint           m_hits;              // number of requests for resources that were already loaded
+   uint           m_misses;            // number of requests for resources that had to be loaded
+   uint           m_evictions;         // number of resources evicted to stay within the memory budget
+   uint           m_evictedMemory;     // amount of memory ( in bytes ) freed by the evictions
+   uint           m_importCacheHits;   // number of imports that reused the cached results
+   uint           m_importCacheMisses; // number of imports that had to parse the imported file
+   uint           m_reloads;           // number of resources reloaded because their files were edited
+
+   ResourcesStatistics() : m_hits( 0 ), m_misses( 0 ), m_evictions( 0 ), m_evictedMemory( 0 ), m_importCacheHits( 0 ), m_importCacheMisses( 0 ), m_reloads( 0 ) {}
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Gets notified when the resources get reloaded because their files ( or the files of their dependencies )
+ * were edited ( see ResourcesManager::processEditedFiles ).
+ */
+class ResourcesReloadListener
+{
+public:
+   virtual ~ResourcesReloadListener() {}
+
+   /**
+    * Called once for every reloaded resource and every resource that depends on one, after the whole batch 
+    * of resources was reloaded. The resources are reported in the dependency order - the dependencies first,
+    * and then the resources that depend on them.
+    *
+    * The resources are reloaded in place ( see Resource::replaceContents ), so the pointers to them remain valid.
+    *
+    * @param resource
+    */
+   virtual void onResourceReloaded( Resource& resource ) = 0;
+};
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -32,6 +82,17 @@ class ReflectionSerializationUtil;
  *
  * Since there can only be a single instance of a resource manager ( there's no point
  * in having two instances managing resources ), this class is made into a singleton
+ *
+ * Resources can also be loaded in the background ( see 'loadAsync' ) - the files are then read
+ * on a separate thread, and the resources get deserialized and registered with the manager
+ * when the main thread calls 'processLoadedResources'.
+ *
+ * The memory the resources occupy can be limited with a memory budget ( see 'setMemoryBudget' ).
+ * Once it's exceeded, the least recently used resources that were released ( see 'release' ) get evicted.
+ *
+ * The resources the files of which get edited are reloaded in place, and the resources that depend on them
+ * get notified ( see 'processEditedFiles' ). The edits are coalesced, so that a batch of files written one after another 
+ * gets reloaded at once.
  */
 class ResourcesManager : public ComponentsManager< ResourcesManager >, public FilesystemListener
 {
@@ -97,7 +158,7 @@ private:
 
 
 private:
-   typedef std::map< FilePath, Resource* >                     ResourcesMap;
+   typedef std::unordered_map< FilePath, Resource*, FilePathHash >   ResourcesMap;
 
    typedef std::vector< ResourceImporterCreator* >             ImportersArr;
    typedef std::map< std::string, ImportersArr* >              ResourceImportersMap;
@@ -107,10 +168,39 @@ private:
 
    Filesystem*                m_filesystem;
    ResourcesMap               m_resources;
+   uint                       m_resourcesGeneration;
    ResourceImportersMap       m_importers;
    ProgressObserverCreator*   m_progressObserverCreator;
 
+   // background loading
+   ResourcesLoadingThread*                   m_loadingThread;
+   std::vector< ResourceLoadingHandle* >     m_pendingLoads;
+
+   // memory budget
+   uint                       m_memoryBudget;
+   uint                       m_accessCounter;
+   ResourcesStatistics        m_statistics;
+
+   // import cache
+   bool                       m_importCacheEnabled;
+
+   // saving
+   bool                       m_incrementalSaving;
+
+   // batch imports
+   uint                       m_importThreadsCount;
+
+   // hot reload
+   typedef std::unordered_set< FilePath, FilePathHash >  EditedFiles;
+
+   EditedFiles                               m_editedFiles;
+   float                                     m_timeSinceLastEdit;
+   float                                     m_hotReloadDelay;
+   bool                                      m_isSaving;
+   std::vector< ResourcesReloadListener* >   m_reloadListeners;
+
    friend class Resource;
+   friend class ResourceHandle;
 
 public:
    ~ResourcesManager();
@@ -169,6 +259,36 @@ public:
     */
    Resource* create( const FilePath& name, bool loadOnly = false );
 
+   /**
+    * Starts loading a resource in the background and returns a handle to it right away.
+    *
+    * The resource gets registered with the manager when the main thread calls 'processLoadedResources',
+    * and that's when the handle gets completed as well. If the resource is already loaded, 
+    * the returned handle is completed from the start.
+    *
+    * Unlike 'create', the method never creates a new resource if its file doesn't exist - the loading fails instead.
+    *
+    * @param name       name of the resource file
+    * @return           a handle the caller should release using 'removeReference' once it no longer needs it
+    */
+   ResourceLoadingHandle* loadAsync( const FilePath& name );
+
+   /**
+    * Deserializes and registers the resources the files of which were read in the background since the last time 
+    * the method was called, and completes their handles. It has to be called from the main thread - once per frame for instance.
+    */
+   void processLoadedResources();
+
+   /**
+    * Blocks until all resources that are being loaded in the background are loaded, and processes them.
+    */
+   void finishLoading();
+
+   /**
+    * Returns the number of resources that are being loaded in the background.
+    */
+   inline uint getPendingLoadsCount() const { return m_pendingLoads.size(); }
+
    /**
     * Removes a resource corresponding to the specified filepath.
     * It will remove both the memory and the filesystem representation of the resource.
@@ -207,6 +327,12 @@ public:
     */
    Resource* findResource( const FilePath& name );
 
+   /**
+    * Returns a number that changes each time a resource is removed from the manager.
+    * Resource pointers cached along with it are valid for as long as it doesn't change.
+    */
+   inline uint getResourcesGeneration() const { return m_resourcesGeneration; }
+
    /**
     * Moves an existing resource to a different path.
     *
@@ -224,6 +350,15 @@ public:
     */
    void save( const FilePath& name );
 
+   /**
+    * Makes the resources saved with 'save' save incrementally from then on ( see Resource::setIncrementalSaving ).
+    * Disabled by default - enable it only if all the code that changes the saved resources marks the changed objects
+    * ( see ReflectionObject::markDirty ).
+    *
+    * @param enable
+    */
+   inline void setIncrementalSaving( bool enable ) { m_incrementalSaving = enable; }
+
    /**
     * The method scans the resource manager memory in search for loaded resources, 
     * starting from the specified root directory, and informs via the FilesystemScanner 
@@ -235,6 +370,107 @@ public:
     */
    void scan( const FilePath& rootDir, FilesystemScanner& scanner, bool recursive = true ) const;
 
+   // -------------------------------------------------------------------------
+   // Memory budget
+   // -------------------------------------------------------------------------
+   /**
+    * Sets the amount of memory ( in bytes ) the resources are allowed to occupy.
+    * The budget is enforced each time 'enforceMemoryBudget' is called.
+    *
+    * @param budget     memory budget, or 0 if the memory shouldn't be limited ( default )
+    */
+   inline void setMemoryBudget( uint budget ) { m_memoryBudget = budget; }
+
+   /**
+    * Returns the current memory budget ( 0 means there's no limit ).
+    */
+   inline uint getMemoryBudget() const { return m_memoryBudget; }
+
+   /**
+    * Returns the amount of memory ( in bytes ) the managed resources occupy.
+    */
+   uint getMemoryUsage() const;
+
+   /**
+    * Tells the manager that the caller no longer uses the resource it got hold of. Only the resources
+    * released by all of their users can be evicted once the memory budget is exceeded. Every 'create' call,
+    * and every completed 'loadAsync' request, should be matched with a call to this method.
+    * Getting hold of the resource again takes it back.
+    *
+    * @param resource
+    */
+   void release( Resource* resource );
+
+   /**
+    * Evicts the least recently used resources until the memory they occupy fits in the budget.
+    *
+    * Only the resources that were released ( see 'release' ), that nobody but the manager holds 
+    * a reference to, that no other managed resource depends on, and that didn't change since they were
+    * loaded or saved ( see Resource::isDirty ) can be evicted.
+    * It should be called at a point where no resources are being worked with - at the beginning of a frame for instance.
+    */
+   void enforceMemoryBudget();
+
+   /**
+    * Returns the statistics of the resource requests and evictions.
+    */
+   inline const ResourcesStatistics& getStatistics() const { return m_statistics; }
+
+   /**
+    * Resets the statistics.
+    */
+   inline void resetStatistics() { m_statistics = ResourcesStatistics(); }
+
+   // -------------------------------------------------------------------------
+   // Hot reload
+   // -------------------------------------------------------------------------
+   /**
+    * Reloads the resources the files of which were edited, and notifies the listeners about them and about 
+    * all the loaded resources that depend on them.
+    *
+    * The edits are coalesced - nothing gets reloaded until no file was edited for the hot reload delay
+    * ( see 'setHotReloadDelay' ). It has to be called from the main thread - once per frame for instance.
+    *
+    * @param timeElapsed      time ( in seconds ) elapsed since the last call
+    */
+   void processEditedFiles( float timeElapsed );
+
+   /**
+    * Reloads the resources affected by the edits made so far right away, without waiting for the hot reload delay to pass.
+    *
+    * The resources are reloaded in place ( see Resource::replaceContents ), so the pointers to them remain valid - 
+    * the resources that can't replace their contents aren't reloaded. The dependencies are reloaded before 
+    * the resources that depend on them. The listeners are notified once the whole batch is reloaded - 
+    * each affected resource once, no matter how many of its dependencies were edited.
+    */
+   void reloadEditedResources();
+
+   /**
+    * Sets the time ( in seconds ) that needs to pass since the last file edit before the affected resources get reloaded.
+    *
+    * @param delay
+    */
+   inline void setHotReloadDelay( float delay ) { m_hotReloadDelay = delay; }
+
+   /**
+    * Returns the number of the edited files the resources of which are waiting to be reloaded.
+    */
+   inline uint getEditedFilesCount() const { return m_editedFiles.size(); }
+
+   /**
+    * Attaches a listener that will be informed about the reloaded resources.
+    *
+    * @param listener
+    */
+   void attachReloadListener( ResourcesReloadListener& listener );
+
+   /**
+    * Detaches a reload listener.
+    *
+    * @param listener
+    */
+   void detachReloadListener( ResourcesReloadListener& listener );
+
    // -------------------------------------------------------------------------
    // Importers management
    // -------------------------------------------------------------------------
@@ -254,6 +490,55 @@ public:
    template< typename ResourceType >
    TResourceImporter< ResourceType >* createImporter( const FilePath& path );
 
+   /**
+    * Imports the contents of the specified file into a resource, using an importer registered
+    * for the file's extension.
+    *
+    * The results of the imports are cached ( in the IMPORT_CACHE_DIR directory ) - they're keyed by the path and
+    * the contents of the imported file, and by the version of the importer. When a file that didn't change 
+    * is imported again, the cached results are merged into the resource instead of parsing the file again.
+    * That only works for the resources that can merge their contents ( see Resource::canMergeContents ) - 
+    * the remaining ones always import the file.
+    *
+    * @param ResourceType
+    * @param path          path of the imported file
+    * @param resource      resource the contents of the file should be imported to
+    * @return              'true' if the file was imported, 'false' if there's no importer that could import it
+    */
+   template< typename ResourceType >
+   bool import( const FilePath& path, ResourceType& resource );
+
+   /**
+    * Imports the contents of the specified files into a resource.
+    *
+    * The files are parsed concurrently on worker threads ( see ResourceImporter::parse ) - 
+    * the files with cached import results aren't parsed at all. The resources are then created
+    * and merged into the target resource on the calling thread, in the order the files were specified in,
+    * so the result is the same as if the files were imported one by one.
+    *
+    * @param ResourceType
+    * @param paths         paths of the imported files
+    * @param resource      resource the contents of the files should be imported to
+    * @return              number of the imported files
+    */
+   template< typename ResourceType >
+   uint importBatch( const std::vector< FilePath >& paths, ResourceType& resource );
+
+   /**
+    * Enables or disables the import cache ( it's enabled by default ).
+    *
+    * @param enable
+    */
+   inline void setImportCacheEnabled( bool enable ) { m_importCacheEnabled = enable; }
+
+   /**
+    * Sets the maximum number of threads the batch imports parse the files on ( by default
+    * it's the number of the processors ).
+    *
+    * @param threadsCount
+    */
+   inline void setImportThreadsCount( uint threadsCount ) { m_importThreadsCount = threadsCount > 0 ? threadsCount : 1; }
+
    // -------------------------------------------------------------------------
    // Instance management
    // -------------------------------------------------------------------------
@@ -320,12 +605,72 @@ private:
     */
    IProgressObserver* createObserver() const;
 
+   /**
+    * Returns the path under which the results of the import performed by the specified importer are cached.
+    *
+    * @param importer
+    * @param resourceExtension      extension of the imported resource
+    */
+   FilePath getCachedImportPath( const ResourceImporter& importer, const char* resourceExtension ) const;
+
+   /**
+    * Loads the cached results of an import.
+    *
+    * @param cachedImportPath
+    * @return                 a resource with the results, or NULL if they weren't cached
+    */
+   Resource* loadCachedImport( const FilePath& cachedImportPath );
+
+   /**
+    * Stores the results of an import in the cache.
+    *
+    * @param importedResource ( the manager takes the ownership of it )
+    * @return                 the cached resource
+    */
+   Resource* storeCachedImport( Resource* importedResource );
+
+   /**
+    * Releases the resource with the cached results of an import, once they were merged into the target resource.
+    *
+    * @param cachedImport
+    */
+   void releaseCachedImport( Resource* cachedImport );
+
+   /**
+    * Runs the first stage of the specified imports ( see ResourceImporter::parse ), spreading
+    * them over the import threads.
+    *
+    * @param importers
+    */
+   void parseImports( const std::vector< ResourceImporter* >& importers );
+
    /**
     * Helper method for loading a resource from the filesystem.
     *
     * @param filePath
     */
    Resource* loadResource( const FilePath& filePath );
+
+   /**
+    * Marks the resource as the most recently used one.
+    *
+    * @param resource
+    */
+   void touch( Resource* resource );
+
+   /**
+    * Registers another user of the resource - the resource can't be evicted until all of its users release it.
+    *
+    * @param resource
+    */
+   void acquire( Resource* resource );
+
+   /**
+    * Removes the resource from the manager, releasing the manager's reference to it.
+    *
+    * @param resource
+    */
+   void evict( Resource* resource );
 };
 
 ///////////////////////////////////////////////////////////////////////////////
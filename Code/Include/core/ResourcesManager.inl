@@ -81,6 +81,86 @@ TResourceImporter< ResourceType >* ResourcesManager::createImporter( const FileP
 
 ///////////////////////////////////////////////////////////////////////////////
 
+template< typename ResourceType >
+bool ResourcesManager::import( const FilePath& path, ResourceType& resource )
+{
+   std::vector< FilePath > paths( 1, path );
+   return importBatch< ResourceType >( paths, resource ) > 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+template< typename ResourceType >
+uint ResourcesManager::importBatch( const std::vector< FilePath >& paths, ResourceType& resource )
+{
+   bool useCache = m_importCacheEnabled && resource.canMergeContents();
+
+   // create the importers, and find out which files need to be parsed
+   std::vector< TResourceImporter< ResourceType >* > importers;
+   std::vector< FilePath > cachedImportPaths;
+   std::vector< ResourceImporter* > parsedImporters;
+
+   uint count = paths.size();
+   for ( uint i = 0; i < count; ++i )
+   {
+      TResourceImporter< ResourceType >* importer = createImporter< ResourceType >( paths[i] );
+      if ( !importer )
+      {
+         continue;
+      }
+
+      FilePath cachedImportPath;
+      if ( useCache )
+      {
+         cachedImportPath = getCachedImportPath( *importer, ResourceType::getExtension() );
+      }
+      if ( !useCache || !m_filesystem->doesExist( cachedImportPath ) )
+      {
+         parsedImporters.push_back( importer );
+      }
+
+      importers.push_back( importer );
+      cachedImportPaths.push_back( cachedImportPath );
+   }
+
+   parseImports( parsedImporters );
+
+   // create the resources on this thread, in the order the files were specified in
+   uint importedCount = importers.size();
+   for ( uint i = 0; i < importedCount; ++i )
+   {
+      TResourceImporter< ResourceType >* importer = importers[i];
+
+      Resource* cachedImport = NULL;
+      if ( useCache )
+      {
+         cachedImport = loadCachedImport( cachedImportPaths[i] );
+         if ( !cachedImport )
+         {
+            // import the file into a separate resource and cache it
+            ResourceType* importedResource = new ResourceType( cachedImportPaths[i] );
+            importer->import( *importedResource );
+            cachedImport = storeCachedImport( importedResource );
+         }
+      }
+      else
+      {
+         importer->import( resource );
+      }
+      delete importer;
+
+      if ( cachedImport )
+      {
+         resource.mergeContents( *cachedImport );
+         releaseCachedImport( cachedImport );
+      }
+   }
+
+   return importedCount;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 template< typename T >
 void ResourcesManager::setProgressObserver()
 {
@@ -0,0 +1,117 @@
+/// @file   core/ResourcesPrefetcher.h
+/// @brief  a tool that reads the files of the resources about to be loaded in one batch
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include "core\MemoryRouter.h"
+#include "core\types.h"
+#include "core\Array.h"
+#include "core\FilePath.h"
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+class Filesystem;
+class ResourcesManager;
+class InStream;
+class MappedFile;
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Loading a resource the regular way means that its dependencies are discovered one by one,
+ * as the files that reference them get deserialized, and each of them is read separately.
+ *
+ * This tool maps the complete set of the resources the loaded one depends on up front, and
+ * brings all of their files into memory in one batch - so that the deserialization doesn't have
+ * to wait for the disk. It's meant to be run on the loading thread ( see ResourcesLoadingThread ).
+ *
+ * Each file is opened once - its dependencies are read from the same data that's later deserialized.
+ * The dependencies are brought in level by level, and the files of each level are ordered by their paths,
+ * so that the files located in the same directory ( or the same archive - see FilesystemArchive ) are read one after another.
+ *
+ * The binary files are kept as memory mappings, so their contents are never copied. Only the text files,
+ * the contents of which need to be translated as they're read, are copied into memory.
+ */
+class ResourcesPrefetcher
+{
+   DECLARE_ALLOCATOR( ResourcesPrefetcher, AM_DEFAULT );
+
+private:
+   struct PrefetchedFile
+   {
+      DECLARE_ALLOCATOR( PrefetchedFile, AM_DEFAULT );
+
+      MappedFile*             m_mappedFile;
+      Array< byte >           m_contents;
+
+      PrefetchedFile() : m_mappedFile( NULL ) {}
+      ~PrefetchedFile();
+
+      const byte* getData() const;
+      uint size() const;
+   };
+
+   typedef std::unordered_map< FilePath, PrefetchedFile*, FilePathHash >    PrefetchedFiles;
+   typedef std::unordered_set< FilePath, FilePathHash >                     MappedPaths;
+
+private:
+   const Filesystem&          m_filesystem;
+
+   std::vector< FilePath >    m_dependencies;
+   PrefetchedFiles            m_prefetchedFiles;
+
+public:
+   /**
+    * Constructor.
+    *
+    * @param filesystem       filesystem the resources are loaded from
+    */
+   ResourcesPrefetcher( const Filesystem& filesystem );
+   ~ResourcesPrefetcher();
+
+   /**
+    * Reads the files of the specified resource and of all the resources it depends on.
+    *
+    * @param resourcePath
+    * @param loadedResources  ( optional ) the resources this manager already contains won't be prefetched
+    */
+   void prefetch( const FilePath& resourcePath, ResourcesManager* loadedResources = NULL );
+
+   /**
+    * Opens a stream that reads the prefetched contents of the specified file.
+    *
+    * @param path
+    * @return     a stream the caller takes the ownership of, or NULL if the file wasn't prefetched
+    */
+   InStream* open( const FilePath& path ) const;
+
+   /**
+    * Releases the prefetched contents of the specified file. Make sure no stream reads it any more.
+    *
+    * @param path
+    */
+   void release( const FilePath& path );
+
+   /**
+    * Releases the contents of all prefetched files.
+    */
+   void clear();
+
+   /**
+    * Returns the paths of the resource and all the resources it depends on, found by the last prefetch.
+    */
+   inline const std::vector< FilePath >& getDependencies() const { return m_dependencies; }
+
+   /**
+    * Returns the number of the files that are currently kept in memory.
+    */
+   inline uint getPrefetchedFilesCount() const { return m_prefetchedFiles.size(); }
+
+private:
+   PrefetchedFile* read( const FilePath& path ) const;
+};
+
+///////////////////////////////////////////////////////////////////////////////
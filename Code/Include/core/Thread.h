@@ -0,0 +1,148 @@
+/// @file   core/Thread.h
+/// @brief  threads and thread synchronization primitives
+#pragma once
+
+#include "core\MemoryRouter.h"
+#include "core\types.h"
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A lock that allows only one thread at a time to access the data it guards.
+ */
+class CriticalSection
+{
+   DECLARE_ALLOCATOR( CriticalSection, AM_DEFAULT );
+
+private:
+   // a CRITICAL_SECTION - kept opaque, so that the header doesn't need to include windows.h
+   void*                      m_section;
+
+public:
+   CriticalSection();
+   ~CriticalSection();
+
+   /**
+    * Acquires the lock, waiting for the thread that holds it to release it if necessary.
+    */
+   void enter();
+
+   /**
+    * Releases the lock.
+    */
+   void leave();
+
+private:
+   // the lock can't be copied
+   CriticalSection( const CriticalSection& );
+   void operator=( const CriticalSection& );
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Acquires a lock for the duration of a scope.
+ */
+class CriticalSectionLock
+{
+   DECLARE_ALLOCATOR( CriticalSectionLock, AM_DEFAULT );
+
+private:
+   CriticalSection&           m_section;
+
+public:
+   CriticalSectionLock( CriticalSection& section ) : m_section( section ) { m_section.enter(); }
+   ~CriticalSectionLock() { m_section.leave(); }
+
+private:
+   void operator=( const CriticalSectionLock& );
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * An event a thread can wait for until another thread signals it.
+ *
+ * The event resets automatically once it releases a waiting thread.
+ */
+class ThreadEvent
+{
+   DECLARE_ALLOCATOR( ThreadEvent, AM_DEFAULT );
+
+private:
+   void*                      m_event;
+
+public:
+   ThreadEvent();
+   ~ThreadEvent();
+
+   /**
+    * Signals the event, releasing a thread that waits for it.
+    */
+   void signal();
+
+   /**
+    * Waits until the event gets signaled.
+    */
+   void wait();
+
+private:
+   // the event can't be copied
+   ThreadEvent( const ThreadEvent& );
+   void operator=( const ThreadEvent& );
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * A thread of execution.
+ *
+ * Derive from the class and implement the 'run' method - it will be executed
+ * on a separate thread once 'start' is called.
+ */
+class Thread
+{
+   DECLARE_ALLOCATOR( Thread, AM_DEFAULT );
+
+private:
+   void*                      m_thread;
+
+public:
+   Thread();
+
+   /**
+    * The thread needs to be joined before it's destroyed.
+    */
+   virtual ~Thread();
+
+   /**
+    * Starts the thread.
+    */
+   void start();
+
+   /**
+    * Waits until the thread finishes running.
+    */
+   void join();
+
+   /**
+    * Tells if the thread was started and hasn't been joined yet.
+    */
+   inline bool isRunning() const { return m_thread != NULL; }
+
+protected:
+   /**
+    * Code executed by the thread.
+    */
+   virtual void run() = 0;
+
+private:
+   static unsigned int __stdcall threadProc( void* thread );
+
+   // the thread can't be copied
+   Thread( const Thread& );
+   void operator=( const Thread& );
+};
+
+///////////////////////////////////////////////////////////////////////////////
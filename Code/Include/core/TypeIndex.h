@@ -0,0 +1,46 @@
+/// @file   core\TypeIndex.h
+/// @brief  dense, run-time assigned indices of C++ types
+#ifndef _TYPE_INDEX_H
+#define _TYPE_INDEX_H
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Hands out consecutive indices to the types queried through TypeIndex.
+ */
+class TypeIndexCounter
+{
+public:
+   /**
+    * Allocates a new, unique index.
+    */
+   static unsigned int allocate();
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Assigns a unique, dense index to every type it's queried with.
+ *
+ * Unlike the ReflectionTypeID, it works with any type ( not only the ones 
+ * registered with the reflection system ), but the indices are assigned
+ * in the order the types are first queried, so they can't be persisted.
+ * They're meant to be used as indices of arrays that map types to data.
+ */
+template< typename T >
+struct TypeIndex
+{
+   /**
+    * Returns the index assigned to the type.
+    */
+   static unsigned int get();
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+#include "core\TypeIndex.inl"
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // _TYPE_INDEX_H
@@ -0,0 +1,17 @@
+#ifndef _TYPE_INDEX_H
+#error "This file can only be included from TypeIndex.h"
+#else
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+template< typename T >
+unsigned int TypeIndex< T >::get()
+{
+   static unsigned int s_index = TypeIndexCounter::allocate();
+   return s_index;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // _TYPE_INDEX_H
@@ -22,9 +22,10 @@
    #define REGISTER_CORE_TYPES()
 #else
    #define REGISTER_TYPE( ClassType )                                         \
-   struct ClassType##RTTIImporter                                             \
+   struct ClassType##RTTIImporter : public TypesRegistration                  \
    {                                                                          \
-      ClassType##RTTIImporter()                                               \
+      ClassType##RTTIImporter() { registerTypes(); }                          \
+      void registerTypes()                                                    \
       {                                                                       \
          ReflectionTypesRegistry& typesRegistry = ReflectionTypesRegistry::getInstance(); \
          typesRegistry.addSerializableType< ClassType >( #ClassType, new TSerializableTypeInstantiator< ClassType >() );  \
@@ -35,9 +36,10 @@
    DEFINE_TYPE_ID( TRefPtr< ClassType > );
 
    #define REGISTER_ABSTRACT_TYPE( ClassType )                                \
-   struct ClassType##RTTIImporter                                             \
+   struct ClassType##RTTIImporter : public TypesRegistration                  \
    {                                                                          \
-      ClassType##RTTIImporter()                                               \
+      ClassType##RTTIImporter() { registerTypes(); }                          \
+      void registerTypes()                                                    \
       {                                                                       \
          ReflectionTypesRegistry& typesRegistry = ReflectionTypesRegistry::getInstance(); \
          typesRegistry.addSerializableType< ClassType >( #ClassType, NULL ); \
@@ -48,9 +50,10 @@
    DEFINE_TYPE_ID( TRefPtr< ClassType > );
 
    #define PATCH_TYPE( PatchedType, NewType )                                 \
-   struct PatchedType##NewType##RTTIImporter                                  \
+   struct PatchedType##NewType##RTTIImporter : public TypesRegistration       \
    {                                                                          \
-      PatchedType##NewType##RTTIImporter()                                    \
+      PatchedType##NewType##RTTIImporter() { registerTypes(); }               \
+      void registerTypes()                                                    \
       {                                                                       \
          ReflectionTypesRegistry& typesRegistry = ReflectionTypesRegistry::getInstance(); \
          typesRegistry.addSerializableType< NewType >( #NewType, new TSerializableTypeInstantiator< ClassType >(), #PatchedType ); \
@@ -61,9 +64,10 @@
    DEFINE_TYPE_ID( TRefPtr< ClassType > );
 
    #define PATCH_ABSTRACT_TYPE( PatchedType, NewType )                        \
-   struct PatchedType##NewType##RTTIImporter                                  \
+   struct PatchedType##NewType##RTTIImporter : public TypesRegistration       \
    {                                                                          \
-      PatchedType##NewType##RTTIImporter()                                    \
+      PatchedType##NewType##RTTIImporter() { registerTypes(); }               \
+      void registerTypes()                                                    \
       {                                                                       \
          ReflectionTypesRegistry& typesRegistry = ReflectionTypesRegistry::getInstance(); \
          typesRegistry.addSerializableType< NewType >( #NewType, NULL, #PatchedType ); \
@@ -74,9 +78,10 @@
    DEFINE_TYPE_ID( TRefPtr< ClassType > );
 
    #define REGISTER_EXTERNAL_TYPE( ClassType )                                \
-   struct ClassType##RTTIImporter                                             \
+   struct ClassType##RTTIImporter : public TypesRegistration                  \
    {                                                                          \
-      ClassType##RTTIImporter()                                               \
+      ClassType##RTTIImporter() { registerTypes(); }                          \
+      void registerTypes()                                                    \
       {                                                                       \
          ReflectionTypesRegistry& typesRegistry = ReflectionTypesRegistry::getInstance(); \
          typesRegistry.addExternalType< ClassType >( #ClassType );            \
@@ -86,9 +91,10 @@
    DEFINE_TYPE_ID( TResourceHandle< ClassType > );
 
    #define REGISTER_ENUM_TYPE( EnumType )                                     \
-   struct EnumType##RTTIImporter                                              \
+   struct EnumType##RTTIImporter : public TypesRegistration                   \
    {                                                                          \
-      EnumType##RTTIImporter()                                                \
+      EnumType##RTTIImporter() { registerTypes(); }                           \
+      void registerTypes()                                                    \
       {                                                                       \
          ReflectionTypesRegistry& typesRegistry = ReflectionTypesRegistry::getInstance(); \
          typesRegistry.addEnumType< EnumType >( #EnumType );                  \
@@ -98,9 +104,10 @@
    DEFINE_TYPE_ID( TResourceHandle< EnumType > );
 
    #define REGISTER_CORE_TYPES()                                              \
-   struct __CoreTypesRTTIImporter                                             \
+   struct __CoreTypesRTTIImporter : public TypesRegistration                  \
    {                                                                          \
-      __CoreTypesRTTIImporter()                                               \
+      __CoreTypesRTTIImporter() { registerTypes(); }                          \
+      void registerTypes()                                                    \
       {                                                                       \
          ReflectionTypesRegistry& typesRegistry = ReflectionTypesRegistry::getInstance(); \
          typesRegistry.addExternalType< int >( "int" );                       \
@@ -10,20 +10,26 @@
 
 class Model;
 class SkeletonAnimation;
+class BVHHierarchy;
 
 ///////////////////////////////////////////////////////////////////////////////
 
 class BVHModelLoader : public TResourceImporter< Model >
 {
+private:
+   BVHHierarchy*        m_hierarchy;
+
 public:
    /**
     * Constructor.
     */
    BVHModelLoader( const FilePath& path, ResourcesManager& rm, IProgressObserver* observer );
+   ~BVHModelLoader();
 
    // -------------------------------------------------------------------------
    // ResourceImporter implementation
    // -------------------------------------------------------------------------
+  void parse();
   void import( Model& scene );
 };
 
@@ -31,15 +37,20 @@ public:
 
 class BVHSkeletonAnimationLoader : public TResourceImporter< SkeletonAnimation >
 {
+private:
+   BVHHierarchy*        m_hierarchy;
+
 public:
    /**
     * Constructor.
     */
    BVHSkeletonAnimationLoader( const FilePath& path, ResourcesManager& rm, IProgressObserver* observer );
+   ~BVHSkeletonAnimationLoader();
 
    // -------------------------------------------------------------------------
    // ResourceImporter implementation
    // -------------------------------------------------------------------------
+  void parse();
   void import( SkeletonAnimation& animation );
 };
 
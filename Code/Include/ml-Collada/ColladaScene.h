@@ -67,6 +67,7 @@ public:
    // -------------------------------------------------------------------------
    // ResourceImporter implementation
    // -------------------------------------------------------------------------
+   void parse();
    void import( Model& scene );
 
    // -------------------------------------------------------------------------
@@ -13,6 +13,7 @@
 
 ///////////////////////////////////////////////////////////////////////////////
 
+class CFileIWF;
 class iwfEntity;
 class iwfMesh;
 class iwfTexture;
@@ -33,6 +34,10 @@ class IProgressObserver;
  */
  class IWFScene : public TResourceImporter< Model >
 {
+private:
+   CFileIWF*            m_sceneFile;
+   HRESULT              m_loadError;
+
 public:
    /** 
     * Constructor.
@@ -43,6 +48,7 @@ public:
    // -------------------------------------------------------------------------
    // ResourceImporter implementation
    // -------------------------------------------------------------------------
+   void parse();
    void import( Model& scene );
 
 private:
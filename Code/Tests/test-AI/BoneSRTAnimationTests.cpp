@@ -1,5 +1,9 @@
 #include "core-TestFramework\TestFramework.h"
 #include "core-AI/BoneSRTAnimation.h"
+#include "core/MathDefs.h"
+#include "core/Algorithms.h"
+#include <vector>
+#include <math.h>
 
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -84,3 +88,207 @@ TEST( BoneSRTAnimation, replacingAnimKeys )
 }
 
 ///////////////////////////////////////////////////////////////////////////////
+
+TEST( BoneSRTAnimation, compressionCollapsesConstantTracks )
+{
+   BoneSRTAnimation anim;
+
+   Quaternion rotation;
+   FastFloat angle; angle.setFromFloat( DEG2RAD( 30.0f ) );
+   rotation.setAxisAngle( Vector( 0, 1, 0 ), angle );
+   for ( unsigned int i = 0; i < 10; ++i )
+   {
+      anim.addOrientationKey( i * 0.1f, rotation );
+      anim.addTranslationKey( i * 0.1f, Vector( 1, 2, 3 ) );
+   }
+
+   anim.compress( 0.001f, 0.001f );
+
+   CPPUNIT_ASSERT_EQUAL( (unsigned int)1, anim.getOrientationKeysCount() );
+   CPPUNIT_ASSERT_EQUAL( (unsigned int)1, anim.getTranslationKeysCount() );
+
+   BoneSRTAnimationPlayer player( anim );
+
+   Vector resultVec;
+   CPPUNIT_ASSERT( player.getTranslation( 0.55f, resultVec ) );
+   COMPARE_VEC( Vector( 1, 2, 3 ), resultVec );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST( BoneSRTAnimation, compressionRemovesInterpolableKeys )
+{
+   BoneSRTAnimation anim;
+
+   // a uniform motion along a straight line needs only its end keys
+   for ( unsigned int i = 0; i <= 10; ++i )
+   {
+      anim.addTranslationKey( i * 0.1f, Vector( i * 0.5f, 0, 0 ) );
+   }
+
+   // and so does a rotation with a constant angular velocity
+   Quaternion rotation;
+   FastFloat angle;
+   for ( unsigned int i = 0; i <= 10; ++i )
+   {
+      angle.setFromFloat( DEG2RAD( i * 9.0f ) );
+      rotation.setAxisAngle( Vector( 0, 0, 1 ), angle );
+      anim.addOrientationKey( i * 0.1f, rotation );
+   }
+
+   anim.compress( 0.001f, 0.001f );
+
+   CPPUNIT_ASSERT_EQUAL( (unsigned int)2, anim.getTranslationKeysCount() );
+   CPPUNIT_ASSERT_EQUAL( (unsigned int)2, anim.getOrientationKeysCount() );
+   CPPUNIT_ASSERT_EQUAL( 1.0f, anim.getDuration() );
+
+   BoneSRTAnimationPlayer player( anim );
+
+   Vector resultVec;
+   CPPUNIT_ASSERT( player.getTranslation( 0.5f, resultVec ) );
+   COMPARE_VEC( Vector( 2.5f, 0, 0 ), resultVec );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST( BoneSRTAnimation, compressionErrorBudget )
+{
+   const unsigned int framesCount = 120;
+   const float frameTime = 1.0f / 60.0f;
+   const float orientationTolerance = DEG2RAD( 0.5f );
+   const float translationTolerance = 0.01f;
+
+   BoneSRTAnimation anim;
+
+   std::vector< Quaternion > rotations;
+   std::vector< Vector > translations;
+   FastFloat angle;
+   for ( unsigned int i = 0; i < framesCount; ++i )
+   {
+      float t = i * frameTime;
+
+      Quaternion rotation;
+      angle.setFromFloat( sin( t * 3.0f ) );
+      rotation.setAxisAngle( Vector( 1, 0, 0 ), angle );
+      rotations.push_back( rotation );
+
+      translations.push_back( Vector( t, cos( t * 5.0f ), 0 ) );
+
+      anim.addOrientationKey( t, rotation );
+      anim.addTranslationKey( t, translations.back() );
+   }
+
+   anim.compress( orientationTolerance, translationTolerance );
+   CPPUNIT_ASSERT( anim.getOrientationKeysCount() < framesCount );
+   CPPUNIT_ASSERT( anim.getTranslationKeysCount() < framesCount );
+
+   // the values sampled at the original keys can't differ from them by more than the specified tolerance
+   // ( plus the orientation quantization error )
+   const float maxOrientationError = orientationTolerance + QuantizedQuaternion::getMaxError() + 1e-4f;
+   const float maxTranslationError = translationTolerance + 1e-4f;
+
+   BoneSRTAnimationPlayer player( anim );
+   Quaternion sampledRotation;
+   Vector sampledTranslation, diff;
+   for ( unsigned int i = 0; i < framesCount; ++i )
+   {
+      float t = i * frameTime;
+
+      CPPUNIT_ASSERT( player.getOrientation( t, sampledRotation ) );
+      const Quaternion& rotation = rotations[i];
+      float dot = sampledRotation[0] * rotation[0] + sampledRotation[1] * rotation[1] + sampledRotation[2] * rotation[2] + sampledRotation[3] * rotation[3];
+      float orientationError = 2.0f * acos( min2( fabs( dot ), 1.0f ) );
+      CPPUNIT_ASSERT( orientationError <= maxOrientationError );
+
+      CPPUNIT_ASSERT( player.getTranslation( t, sampledTranslation ) );
+      diff.setSub( sampledTranslation, translations[i] );
+      CPPUNIT_ASSERT( diff.length().getFloat() <= maxTranslationError );
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST( BoneSRTAnimation, compressionOfLongTracks )
+{
+   // a long recording of a uniform motion - every key but the ends could be interpolated,
+   // but the kept keys can't be more than 64 keys apart
+   const unsigned int framesCount = 10000;
+   const float frameTime = 1.0f / 60.0f;
+
+   BoneSRTAnimation anim;
+   for ( unsigned int i = 0; i < framesCount; ++i )
+   {
+      anim.addTranslationKey( i * frameTime, Vector( i * 0.001f, 0, 0 ) );
+   }
+
+   anim.compress( 0.001f, 0.001f );
+
+   const unsigned int expectedKeysCount = ( framesCount - 2 ) / 64 + 2;
+   CPPUNIT_ASSERT_EQUAL( expectedKeysCount, anim.getTranslationKeysCount() );
+   CPPUNIT_ASSERT_EQUAL( ( framesCount - 1 ) * frameTime, anim.getDuration() );
+
+   BoneSRTAnimationPlayer player( anim );
+   Vector result;
+   for ( unsigned int i = 0; i < framesCount; i += 97 )
+   {
+      CPPUNIT_ASSERT( player.getTranslation( i * frameTime, result ) );
+      COMPARE_VEC( Vector( i * 0.001f, 0, 0 ), result );
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST( BoneSRTAnimation, keysAddedOutOfOrder )
+{
+   BoneSRTAnimation anim;
+   anim.addTranslationKey( 1.0f, Vector( 1, 0, 0 ) );
+   anim.addTranslationKey( 3.0f, Vector( 3, 0, 0 ) );
+   anim.addTranslationKey( 0.0f, Vector( 0, 0, 0 ) );
+   anim.addTranslationKey( 2.0f, Vector( 2, 0, 0 ) );
+
+   CPPUNIT_ASSERT_EQUAL( (unsigned int)4, anim.getTranslationKeysCount() );
+   CPPUNIT_ASSERT_EQUAL( 3.0f, anim.getDuration() );
+
+   Vector value;
+   float time;
+   for ( unsigned int i = 0; i < 4; ++i )
+   {
+      anim.getTranslationKey( i, value, time );
+      CPPUNIT_ASSERT_EQUAL( (float)i, time );
+      COMPARE_VEC( Vector( (float)i, 0, 0 ), value );
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST( BoneSRTAnimation, randomAccessPlayback )
+{
+   BoneSRTAnimation anim;
+   for ( unsigned int i = 0; i <= 100; ++i )
+   {
+      anim.addTranslationKey( i * 0.1f, Vector( (float)i, 0, 0 ) );
+   }
+
+   BoneSRTAnimationPlayer player( anim );
+   Vector result;
+
+   // jumps back and forth in time
+   CPPUNIT_ASSERT( player.getTranslation( 7.25f, result ) );
+   COMPARE_VEC( Vector( 72.5f, 0, 0 ), result );
+
+   CPPUNIT_ASSERT( player.getTranslation( 0.35f, result ) );
+   COMPARE_VEC( Vector( 3.5f, 0, 0 ), result );
+
+   CPPUNIT_ASSERT( player.getTranslation( 9.95f, result ) );
+   COMPARE_VEC( Vector( 99.5f, 0, 0 ), result );
+
+   // reversed playback
+   for ( int i = 99; i >= 0; --i )
+   {
+      float t = i * 0.1f + 0.05f;
+      CPPUNIT_ASSERT( player.getTranslation( t, result ) );
+      COMPARE_VEC( Vector( i + 0.5f, 0, 0 ), result );
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
@@ -4,6 +4,9 @@
 #include "core-AI/SkeletonAnimationController.h"
 #include "core-AI/SkeletonAnimation.h"
 #include "core-AI/BoneSRTAnimation.h"
+#include "core/ResourcesManager.h"
+#include "core/Filesystem.h"
+#include "core/File.h"
 #include <vector>
 
 
@@ -166,3 +169,262 @@ TEST( SkeletonAnimationController, trackTimeControl )
 }
 
 ///////////////////////////////////////////////////////////////////////////////
+
+TEST( SkeletonAnimationController, animationConcatenatedWithReferencePose )
+{
+   // setup reflection types
+   ReflectionTypesRegistry& typesRegistry = ReflectionTypesRegistry::getInstance();
+   typesRegistry.clear();
+   typesRegistry.addSerializableType< SpatialEntity >( "SpatialEntity", new TSerializableTypeInstantiator< SpatialEntity >() ); 
+   typesRegistry.addSerializableType< Entity >( "Entity", new TSerializableTypeInstantiator< Entity >() ); 
+   typesRegistry.addSerializableType< SkeletonAnimation >( "SkeletonAnimation", new TSerializableTypeInstantiator< SkeletonAnimation >() ); 
+   typesRegistry.addSerializableType< BoneSRTAnimation >( "BoneSRTAnimation", new TSerializableTypeInstantiator< BoneSRTAnimation >() ); 
+   typesRegistry.addSerializableType< SkeletonAnimationController >( "SkeletonAnimationController", new TSerializableTypeInstantiator< SkeletonAnimationController >() ); 
+
+   // create a rig with a bone that has a reference pose of its own
+   Matrix referenceMtx;
+   {
+      Quaternion referenceRotation;
+      referenceRotation.setAxisAngle( Vector_OZ, FastFloat::fromFloat( DEG2RAD( 45.0f ) ) );
+
+      Transform referenceTransform( Quad_0010, referenceRotation );
+      referenceTransform.toMatrix( referenceMtx );
+   }
+
+   SpatialEntity* root = new SpatialEntity( "root" );
+   root->setLocalMtx( referenceMtx );
+
+   // animate it with both a rotation and a translation
+   Quaternion animRotation;
+   animRotation.setAxisAngle( Vector_OY, FastFloat::fromFloat( DEG2RAD( 90.0f ) ) );
+
+   SkeletonAnimation animSource;
+   BoneSRTAnimation* rootBoneKeys = new BoneSRTAnimation( "root" );
+   rootBoneKeys->addTranslationKey( 0.f, Quad_1000 );
+   rootBoneKeys->addOrientationKey( 0.f, animRotation );
+   animSource.addKeys( rootBoneKeys );
+
+   SkeletonAnimationController* animController = new SkeletonAnimationController();
+   animController->setAnimationSource( animSource );
+   root->add( animController );
+   animController->update( 0.f );
+
+   // the bone is rotated, then translated, and then transformed by its reference pose
+   Matrix expected, tmpMtx;
+   expected.setRotation( animRotation );
+   tmpMtx.setTranslation( Quad_1000 );
+   expected.mul( tmpMtx );
+   expected.mul( referenceMtx );
+   COMPARE_MTX( expected, root->getLocalMtx() );
+
+   // cleanup
+   delete root;
+   typesRegistry.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST( SkeletonAnimationController, scaledReferencePose )
+{
+   // setup reflection types
+   ReflectionTypesRegistry& typesRegistry = ReflectionTypesRegistry::getInstance();
+   typesRegistry.clear();
+   typesRegistry.addSerializableType< SpatialEntity >( "SpatialEntity", new TSerializableTypeInstantiator< SpatialEntity >() ); 
+   typesRegistry.addSerializableType< Entity >( "Entity", new TSerializableTypeInstantiator< Entity >() ); 
+   typesRegistry.addSerializableType< SkeletonAnimation >( "SkeletonAnimation", new TSerializableTypeInstantiator< SkeletonAnimation >() ); 
+   typesRegistry.addSerializableType< BoneSRTAnimation >( "BoneSRTAnimation", new TSerializableTypeInstantiator< BoneSRTAnimation >() ); 
+   typesRegistry.addSerializableType< SkeletonAnimationController >( "SkeletonAnimationController", new TSerializableTypeInstantiator< SkeletonAnimationController >() ); 
+
+   // create a rig with a bone the reference pose of which is scaled
+   Matrix referenceMtx;
+   {
+      Quaternion referenceRotation;
+      referenceRotation.setAxisAngle( Vector_OZ, FastFloat::fromFloat( DEG2RAD( 45.0f ) ) );
+
+      Transform referenceTransform( Quad_0010, referenceRotation );
+      referenceTransform.toMatrix( referenceMtx );
+      referenceMtx.scaleUniform( FastFloat::fromFloat( 2.0f ) );
+   }
+
+   SpatialEntity* root = new SpatialEntity( "root" );
+   root->setLocalMtx( referenceMtx );
+
+   Quaternion animRotation;
+   animRotation.setAxisAngle( Vector_OY, FastFloat::fromFloat( DEG2RAD( 90.0f ) ) );
+
+   SkeletonAnimation animSource;
+   BoneSRTAnimation* rootBoneKeys = new BoneSRTAnimation( "root" );
+   rootBoneKeys->addTranslationKey( 0.f, Quad_1000 );
+   rootBoneKeys->addOrientationKey( 0.f, animRotation );
+   animSource.addKeys( rootBoneKeys );
+
+   SkeletonAnimationController* animController = new SkeletonAnimationController();
+   animController->setAnimationSource( animSource );
+   root->add( animController );
+   animController->update( 0.f );
+
+   // the scale of the reference pose should be preserved
+   Matrix expected, tmpMtx;
+   expected.setRotation( animRotation );
+   tmpMtx.setTranslation( Quad_1000 );
+   expected.mul( tmpMtx );
+   expected.mul( referenceMtx );
+   COMPARE_MTX( expected, root->getLocalMtx() );
+
+   // cleanup
+   delete root;
+   typesRegistry.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST( SkeletonAnimationController, blendedLayers )
+{
+   // setup reflection types
+   ReflectionTypesRegistry& typesRegistry = ReflectionTypesRegistry::getInstance();
+   typesRegistry.clear();
+   typesRegistry.addSerializableType< SpatialEntity >( "SpatialEntity", new TSerializableTypeInstantiator< SpatialEntity >() ); 
+   typesRegistry.addSerializableType< Entity >( "Entity", new TSerializableTypeInstantiator< Entity >() ); 
+   typesRegistry.addSerializableType< SkeletonAnimation >( "SkeletonAnimation", new TSerializableTypeInstantiator< SkeletonAnimation >() ); 
+   typesRegistry.addSerializableType< BoneSRTAnimation >( "BoneSRTAnimation", new TSerializableTypeInstantiator< BoneSRTAnimation >() ); 
+   typesRegistry.addSerializableType< SkeletonAnimationController >( "SkeletonAnimationController", new TSerializableTypeInstantiator< SkeletonAnimationController >() ); 
+
+   // create the rig
+   SpatialEntity* root = new SpatialEntity( "root" );
+   SpatialEntity* arm = new SpatialEntity( "arm" );
+   root->add( arm );
+
+   // the base animation moves both bones by 1 unit, and the layer - by 3 units
+   SkeletonAnimation baseAnim;
+   baseAnim.addTranslationKey( "root", 0.f, Vector( 1, 0, 0 ) );
+   baseAnim.addTranslationKey( "arm", 0.f, Vector( 1, 0, 0 ) );
+
+   SkeletonAnimation layerAnim;
+   layerAnim.addTranslationKey( "root", 0.f, Vector( 3, 0, 0 ) );
+   layerAnim.addTranslationKey( "arm", 0.f, Vector( 3, 0, 0 ) );
+
+   SkeletonAnimationController* animController = new SkeletonAnimationController();
+   animController->setAnimationSource( baseAnim );
+   root->add( animController );
+
+   unsigned int layerIdx = animController->addLayer( layerAnim, 0.5f );
+   CPPUNIT_ASSERT_EQUAL( (unsigned int)1, animController->getLayersCount() );
+
+   Matrix expected;
+
+   // the layer is blended with a half of its weight
+   animController->update( 0.f );
+   expected.setTranslation( Vector( 2, 0, 0 ) );
+   COMPARE_MTX( expected, root->getLocalMtx() );
+   COMPARE_MTX( expected, arm->getLocalMtx() );
+
+   // a disabled layer doesn't contribute
+   animController->setLayerWeight( layerIdx, 0.0f );
+   animController->update( 0.f );
+   expected.setTranslation( Vector( 1, 0, 0 ) );
+   COMPARE_MTX( expected, root->getLocalMtx() );
+   COMPARE_MTX( expected, arm->getLocalMtx() );
+
+   // a layer with a full weight overrides the animation
+   animController->setLayerWeight( layerIdx, 1.0f );
+   animController->update( 0.f );
+   expected.setTranslation( Vector( 3, 0, 0 ) );
+   COMPARE_MTX( expected, root->getLocalMtx() );
+   COMPARE_MTX( expected, arm->getLocalMtx() );
+
+   // ... but only for the bones its mask selects
+   std::vector< std::string > boneMask;
+   boneMask.push_back( "arm" );
+   animController->setLayerBoneMask( layerIdx, boneMask );
+   animController->update( 0.f );
+   expected.setTranslation( Vector( 1, 0, 0 ) );
+   COMPARE_MTX( expected, root->getLocalMtx() );
+   expected.setTranslation( Vector( 3, 0, 0 ) );
+   COMPARE_MTX( expected, arm->getLocalMtx() );
+
+   // cleanup
+   delete root;
+   typesRegistry.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST( SkeletonAnimation, hotReload )
+{
+   // setup reflection types
+   ReflectionTypesRegistry& typesRegistry = ReflectionTypesRegistry::getInstance();
+   typesRegistry.clear();
+   typesRegistry.addSerializableType< ReflectionObject >( "ReflectionObject", NULL );
+   typesRegistry.addSerializableType< Resource >( "Resource", NULL );
+   typesRegistry.addSerializableType< SkeletonAnimation >( "SkeletonAnimation", new TSerializableTypeInstantiator< SkeletonAnimation >() ); 
+   typesRegistry.addSerializableType< BoneSRTAnimation >( "BoneSRTAnimation", new TSerializableTypeInstantiator< BoneSRTAnimation >() ); 
+
+   ResourcesManager& mgr = ResourcesManager::getInstance();
+   mgr.reset();
+   mgr.setFilesystem( new Filesystem( "..\\Data" ) );
+   Filesystem& fs = mgr.getFilesystem();
+
+   // the animation moves both bones by 1 unit
+   FilePath animPath( "hotReloadedAnim.tan" );
+   SkeletonAnimation* anim = new SkeletonAnimation( animPath );
+   anim->addTranslationKey( "root", 0.f, Vector( 1, 0, 0 ) );
+   anim->addTranslationKey( "arm", 0.f, Vector( 1, 0, 0 ) );
+   mgr.addResource( anim );
+   anim->saveResource();
+   BoneSRTAnimation* rootKeys = anim->getBoneDef( "root" );
+
+   // ... and its new version moves the root by 2 units and a hand by 3, leaving the arm alone
+   FilePath newVersionPath( "hotReloadedAnimNewVersion.tan" );
+   SkeletonAnimation* newVersion = new SkeletonAnimation( newVersionPath );
+   newVersion->addTranslationKey( "root", 0.f, Vector( 2, 0, 0 ) );
+   newVersion->addTranslationKey( "hand", 0.f, Vector( 3, 0, 0 ) );
+   mgr.addResource( newVersion );
+   newVersion->saveResource();
+
+   // play the animation
+   SpatialEntity* root = new SpatialEntity( "root" );
+   SpatialEntity* arm = new SpatialEntity( "arm" );
+   root->add( arm );
+
+   SkeletonAnimationController* animController = new SkeletonAnimationController();
+   animController->setAnimationSource( *anim );
+   root->add( animController );
+
+   Matrix expected;
+   animController->update( 0.f );
+   expected.setTranslation( Vector( 1, 0, 0 ) );
+   COMPARE_MTX( expected, root->getLocalMtx() );
+
+   // overwrite the animation file with the new version
+   {
+      File* file = fs.open( newVersionPath, std::ios_base::in | std::ios_base::binary );
+      Array< byte > contents;
+      contents.resizeWithoutInitializing( file->size() );
+      file->read( (byte*)contents, contents.size() );
+      delete file;
+
+      file = fs.open( animPath, std::ios_base::out | std::ios_base::binary );
+      file->write( (byte*)contents, contents.size() );
+      delete file;
+   }
+   CPPUNIT_ASSERT_EQUAL( (uint)1, mgr.getEditedFilesCount() );
+   mgr.reloadEditedResources();
+
+   // the animation is reloaded in place - along with the tracks of the bones that remain animated
+   CPPUNIT_ASSERT( mgr.findResource( animPath ) == anim );
+   CPPUNIT_ASSERT( anim->getBoneDef( "root" ) == rootKeys );
+   CPPUNIT_ASSERT( anim->getBoneDef( "arm" ) == NULL );
+   CPPUNIT_ASSERT( anim->getBoneDef( "hand" ) != NULL );
+
+   // so the controller that was already playing it picks the changes up
+   animController->update( 0.f );
+   expected.setTranslation( Vector( 2, 0, 0 ) );
+   COMPARE_MTX( expected, root->getLocalMtx() );
+
+   // cleanup
+   delete root;
+   mgr.reset();
+   typesRegistry.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
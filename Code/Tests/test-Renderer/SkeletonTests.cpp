@@ -32,3 +32,22 @@ TEST(Skeleton, changingShapeBindMatrix)
 }
 
 ///////////////////////////////////////////////////////////////////////////////
+
+TEST(Skeleton, invBindPoseMatricesIndexedByBones)
+{
+   Skeleton testSkeleton;
+
+   Matrix firstInvMtx, secondInvMtx;
+   firstInvMtx.setTranslation( Vector( 1, 0, 0 ) );
+   secondInvMtx.setTranslation( Vector( 0, 2, 0 ) );
+   testSkeleton.setTransformation( "first", firstInvMtx );
+   testSkeleton.setTransformation( "second", secondInvMtx );
+
+   const Array< Matrix >& invBindPoseMatrices = testSkeleton.getInvBindPoseMatrices();
+   CPPUNIT_ASSERT_EQUAL( testSkeleton.getBonesCount(), invBindPoseMatrices.size() );
+
+   COMPARE_MTX( testSkeleton.getInvBindPoseMtx( "first" ), invBindPoseMatrices[ testSkeleton.getBoneIndex( "first" ) ] );
+   COMPARE_MTX( testSkeleton.getInvBindPoseMtx( "second" ), invBindPoseMatrices[ testSkeleton.getBoneIndex( "second" ) ] );
+}
+
+///////////////////////////////////////////////////////////////////////////////
@@ -315,3 +315,48 @@ TEST( ComponentsManager, queryingComponentsByType )
 }
 
 ///////////////////////////////////////////////////////////////////////////////
+
+TEST( ComponentsManager, cachedComponentsQueriesStayUpToDate )
+{
+   ComponentsManagerMock compMgr;
+   compMgr.addComponent( new MockComponentWithName("compA") );
+
+   const std::vector< MockComponentWithName* >& namedComps = compMgr.getComponents< MockComponentWithName >();
+   CPPUNIT_ASSERT_EQUAL( (unsigned int)1, namedComps.size() );
+
+   MockComponentWithName* compB = new MockComponentWithName("compB");
+   compMgr.addComponent( compB );
+   compMgr.addComponent( new MockComponentThatProvidesService() );
+   CPPUNIT_ASSERT_EQUAL( (unsigned int)2, namedComps.size() );
+   CPPUNIT_ASSERT( compB == namedComps[1] );
+
+   compMgr.removeComponent( *compB );
+   delete compB;
+   CPPUNIT_ASSERT_EQUAL( (unsigned int)1, namedComps.size() );
+
+   compMgr.removeAllComponents();
+   CPPUNIT_ASSERT_EQUAL( (unsigned int)0, namedComps.size() );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST( ComponentsManager, serviceHandles )
+{
+   ComponentsManagerMock compMgr;
+
+   ServiceHandle< ServiceMock > handle = compMgr.getServiceHandle< ServiceMock >();
+   CPPUNIT_ASSERT_EQUAL( false, handle.isSet() );
+
+   MockComponentThatProvidesService* comp = new MockComponentThatProvidesService();
+   compMgr.addComponent( comp );
+   CPPUNIT_ASSERT_EQUAL( true, handle.isSet() );
+
+   comp->setServiceData( 5 );
+   CPPUNIT_ASSERT_EQUAL( 5, handle.get()->get() );
+
+   comp->removeService( compMgr );
+   CPPUNIT_ASSERT_EQUAL( false, handle.isSet() );
+   CPPUNIT_ASSERT( handle.get() == NULL );
+}
+
+///////////////////////////////////////////////////////////////////////////////
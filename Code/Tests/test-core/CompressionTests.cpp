@@ -0,0 +1,99 @@
+#include "core-TestFramework\TestFramework.h"
+#include "core\LZCompressor.h"
+#include "core\InCompressedStream.h"
+#include "core\OutCompressedStream.h"
+#include "core\InArrayStream.h"
+#include "core\OutArrayStream.h"
+#include "core\Array.h"
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST( LZCompressor, compressingData )
+{
+   // repetitive data compresses well
+   const uint dataSize = 10000;
+   byte data[dataSize];
+   for ( uint i = 0; i < dataSize; ++i )
+   {
+      data[i] = (byte)( i % 13 );
+   }
+
+   Array< byte > compressedData;
+   compressedData.resize( LZCompressor::getMaxCompressedSize( dataSize ) );
+   uint compressedSize = LZCompressor::compress( data, dataSize, (byte*)compressedData );
+   CPPUNIT_ASSERT( compressedSize < dataSize / 10 );
+
+   byte decompressedData[dataSize];
+   CPPUNIT_ASSERT( LZCompressor::decompress( (byte*)compressedData, compressedSize, decompressedData, dataSize ) );
+   CPPUNIT_ASSERT( memcmp( data, decompressedData, dataSize ) == 0 );
+
+   // the decompressor should detect that the data doesn't decompress to the expected size
+   CPPUNIT_ASSERT( !LZCompressor::decompress( (byte*)compressedData, compressedSize, decompressedData, dataSize - 1 ) );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST( LZCompressor, incompressibleData )
+{
+   const uint dataSize = 1000;
+   byte data[dataSize];
+   uint seed = 1;
+   for ( uint i = 0; i < dataSize; ++i )
+   {
+      seed = seed * 1103515245 + 12345;
+      data[i] = (byte)( seed >> 16 );
+   }
+
+   Array< byte > compressedData;
+   compressedData.resize( LZCompressor::getMaxCompressedSize( dataSize ) );
+   uint compressedSize = LZCompressor::compress( data, dataSize, (byte*)compressedData );
+   CPPUNIT_ASSERT( compressedSize <= LZCompressor::getMaxCompressedSize( dataSize ) );
+
+   byte decompressedData[dataSize];
+   CPPUNIT_ASSERT( LZCompressor::decompress( (byte*)compressedData, compressedSize, decompressedData, dataSize ) );
+   CPPUNIT_ASSERT( memcmp( data, decompressedData, dataSize ) == 0 );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST( CompressedStreams, readingAndWriting )
+{
+   Array< byte > memBuf;
+
+   // write the data using small blocks, so that it spans several of them, and follow it
+   // with some uncompressed data
+   {
+      OutArrayStream outStream( memBuf );
+      {
+         OutCompressedStream compressedStream( outStream, 64 );
+         for ( int i = 0; i < 100; ++i )
+         {
+            compressedStream << i % 3;
+         }
+      }
+      outStream << 12345;
+   }
+   CPPUNIT_ASSERT( memBuf.size() < 100 * sizeof( int ) );
+
+   // read it back
+   InArrayStream inStream( memBuf );
+   {
+      InCompressedStream compressedStream( inStream );
+      for ( int i = 0; i < 50; ++i )
+      {
+         int val = -1;
+         compressedStream >> val;
+         CPPUNIT_ASSERT_EQUAL( i % 3, val );
+      }
+
+      // skip the rest of the compressed data
+      compressedStream.finish();
+   }
+
+   int val = -1;
+   inStream >> val;
+   CPPUNIT_ASSERT_EQUAL( 12345, val );
+}
+
+///////////////////////////////////////////////////////////////////////////////
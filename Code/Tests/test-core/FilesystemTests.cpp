@@ -2,6 +2,13 @@
 #include "core\Filesystem.h"
 #include "core\FilesystemUtils.h"
 #include "core\StreamBuffer.h"
+#include "core\MappedFile.h"
+#include "core\File.h"
+#include "core\FilesystemArchive.h"
+#include "core\FilesystemIndex.h"
+#include "core\InMappedFileStream.h"
+#include "core\FilePath.h"
+#include <set>
 
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -52,6 +59,170 @@ TEST(Filesystem, accessingFileLikeAMemoryBuffer)
 
 ///////////////////////////////////////////////////////////////////////////////
 
+TEST(Filesystem, mappingFiles)
+{
+   Filesystem filesystem;
+   filesystem.changeRootDir( "../Data/" );
+
+   CPPUNIT_ASSERT( filesystem.map( FilePath( "ola.txt" ) ) == NULL );
+
+   MappedFile* ala = filesystem.map( FilePath( "ala.txt" ) );
+   CPPUNIT_ASSERT( ala != NULL );
+   CPPUNIT_ASSERT_EQUAL( (std::size_t)5, ala->size() );
+   CPPUNIT_ASSERT_EQUAL( (byte)'1', ala->getData()[0] );
+   CPPUNIT_ASSERT_EQUAL( (byte)'5', ala->getData()[4] );
+
+   // read the data through a stream
+   InMappedFileStream stream( ala );
+   char val = 0;
+   stream >> val;
+   CPPUNIT_ASSERT_EQUAL( '1', val );
+
+   stream.skip( 2 );
+   CPPUNIT_ASSERT_EQUAL( (uint)2, stream.getRemainingSize() );
+   stream >> val;
+   CPPUNIT_ASSERT_EQUAL( '4', val );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST( Filesystem, archives )
+{
+   Filesystem filesystem( "../Data/" );
+
+   // create a few files and pack them into an archive
+   const char* contents[] = { "12345", "abc" };
+   std::vector< FilePath > files;
+   files.push_back( FilePath( "archivedFileA.txt" ) );
+   files.push_back( FilePath( "archivedFileB.txt" ) );
+   for ( uint i = 0; i < 2; ++i )
+   {
+      File* file = filesystem.open( files[i], std::ios_base::out | std::ios_base::binary );
+      file->write( ( byte* )contents[i], strlen( contents[i] ) );
+      delete file;
+   }
+   CPPUNIT_ASSERT( FilesystemArchive::build( filesystem, files, filesystem, FilePath( "testArchive.pak" ) ) );
+
+   // remove the original files - from now on they can only be read from the archive
+   filesystem.remove( files[0] );
+   filesystem.remove( files[1] );
+   CPPUNIT_ASSERT( !filesystem.doesExist( files[0] ) );
+
+   CPPUNIT_ASSERT( filesystem.mount( FilePath( "testArchive.pak" ) ) );
+   CPPUNIT_ASSERT( filesystem.doesExist( files[0] ) );
+   CPPUNIT_ASSERT( filesystem.doesExist( files[1] ) );
+   CPPUNIT_ASSERT( !filesystem.doesExist( FilePath( "archivedFileC.txt" ) ) );
+
+   // map a file
+   MappedFile* mappedFile = filesystem.map( files[1] );
+   CPPUNIT_ASSERT( mappedFile != NULL );
+   CPPUNIT_ASSERT_EQUAL( (std::size_t)3, mappedFile->size() );
+   CPPUNIT_ASSERT( memcmp( contents[1], mappedFile->getData(), 3 ) == 0 );
+   delete mappedFile;
+
+   // read a file
+   File* file = filesystem.open( files[0], std::ios_base::in | std::ios_base::binary );
+   CPPUNIT_ASSERT( file != NULL );
+   CPPUNIT_ASSERT_EQUAL( (std::size_t)5, file->size() );
+
+   char buf[16];
+   memset( buf, 0, sizeof( buf ) );
+   CPPUNIT_ASSERT_EQUAL( (std::size_t)5, file->read( ( byte* )buf, sizeof( buf ) ) );
+   CPPUNIT_ASSERT_EQUAL( std::string( contents[0] ), std::string( buf ) );
+   CPPUNIT_ASSERT( file->eof() );
+
+   file->seek( 2 );
+   CPPUNIT_ASSERT_EQUAL( (std::size_t)2, file->tell() );
+   CPPUNIT_ASSERT_EQUAL( (std::size_t)3, file->read( ( byte* )buf, sizeof( buf ) ) );
+   CPPUNIT_ASSERT_EQUAL( '3', buf[0] );
+   delete file;
+
+   // cleanup
+   filesystem.unmountArchives();
+   CPPUNIT_ASSERT( !filesystem.doesExist( files[0] ) );
+   filesystem.remove( FilePath( "testArchive.pak" ) );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+namespace // anonymous
+{
+   class FilesCollector : public FilesystemScanner
+   {
+   public:
+      std::set< std::string >    m_files;
+
+      void onDirectory( const FilePath& name ) {}
+      void onFile( const FilePath& name ) { m_files.insert( name.getRelativePath() ); }
+   };
+
+   void createFile( const Filesystem& filesystem, const FilePath& path )
+   {
+      File* file = filesystem.open( path, std::ios_base::out );
+      file->write( ( byte* )"1", 1 );
+      delete file;
+   }
+
+} // anonymous
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST( Filesystem, indexedScanning )
+{
+   Filesystem filesystem( "../Data/" );
+   const FilesystemIndex& index = filesystem.getIndex();
+
+   FilePath dir( "indexedScanDir/" );
+   filesystem.mkdir( dir );
+   createFile( filesystem, FilePath( "indexedScanDir/a.txt" ) );
+
+   // the first scan enumerates the directory
+   {
+      FilesCollector collector;
+      filesystem.scan( dir, collector );
+      CPPUNIT_ASSERT_EQUAL( (std::size_t)1, collector.m_files.size() );
+      CPPUNIT_ASSERT( collector.m_files.find( FilePath( "indexedScanDir/a.txt" ).getRelativePath() ) != collector.m_files.end() );
+   }
+   uint enumeratedDirsCount = index.getEnumeratedDirsCount();
+
+   // the next one is answered from the index
+   {
+      FilesCollector collector;
+      filesystem.scan( dir, collector );
+      CPPUNIT_ASSERT_EQUAL( (std::size_t)1, collector.m_files.size() );
+      CPPUNIT_ASSERT_EQUAL( enumeratedDirsCount, index.getEnumeratedDirsCount() );
+   }
+
+   // a file gets added - the directory needs to be enumerated again
+   createFile( filesystem, FilePath( "indexedScanDir/b.txt" ) );
+   {
+      FilesCollector collector;
+      filesystem.scan( dir, collector );
+      CPPUNIT_ASSERT_EQUAL( (std::size_t)2, collector.m_files.size() );
+      CPPUNIT_ASSERT( collector.m_files.find( FilePath( "indexedScanDir/b.txt" ).getRelativePath() ) != collector.m_files.end() );
+      CPPUNIT_ASSERT_EQUAL( enumeratedDirsCount + 1, index.getEnumeratedDirsCount() );
+   }
+
+   // and removed
+   filesystem.remove( FilePath( "indexedScanDir/a.txt" ) );
+   {
+      FilesCollector collector;
+      filesystem.scan( dir, collector );
+      CPPUNIT_ASSERT_EQUAL( (std::size_t)1, collector.m_files.size() );
+      CPPUNIT_ASSERT( collector.m_files.find( FilePath( "indexedScanDir/a.txt" ).getRelativePath() ) == collector.m_files.end() );
+   }
+
+   // cleanup
+   filesystem.remove( dir );
+   {
+      FilesCollector collector;
+      filesystem.scan( dir, collector );
+      CPPUNIT_ASSERT_EQUAL( (std::size_t)0, collector.m_files.size() );
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 TEST(FilesystemUtils, extractingPathParts)
 {
    std::string fileName( "/ola/ula/pies.txt" );
@@ -151,3 +322,32 @@ TEST( FilesystemUtils, normalize )
 }
 
 ///////////////////////////////////////////////////////////////////////////////
+
+TEST( FilePath, hashes )
+{
+   // paths that normalize to the same string share the hash
+   FilePath path( "ala\\ula\\ala.txt" );
+   CPPUNIT_ASSERT_EQUAL( FilePath( "/ala/ula/ala.txt" ).getHash(), path.getHash() );
+   CPPUNIT_ASSERT( FilePath( "/ala/ula/ala.txt" ) == path );
+   CPPUNIT_ASSERT( FilePath( "/ala/ula/ola.txt" ).getHash() != path.getHash() );
+   CPPUNIT_ASSERT( FilePath( "/ala/ula/ola.txt" ) != path );
+
+   // the hashes of the derived paths are kept up to date
+   FilePath changedExtPath;
+   path.changeFileExtension( "dat", changedExtPath );
+   CPPUNIT_ASSERT_EQUAL( FilePath( changedExtPath.getRelativePath() ).getHash(), changedExtPath.getHash() );
+
+   FilePath dirPath;
+   path.extractDir( dirPath );
+   CPPUNIT_ASSERT_EQUAL( FilePath( dirPath.getRelativePath() ).getHash(), dirPath.getHash() );
+
+   FilePath parentDirPath;
+   path.leaveDir( 2, parentDirPath );
+   CPPUNIT_ASSERT_EQUAL( FilePath( parentDirPath.getRelativePath() ).getHash(), parentDirPath.getHash() );
+
+   FilePath assignedPath;
+   assignedPath = path;
+   CPPUNIT_ASSERT_EQUAL( path.getHash(), assignedPath.getHash() );
+}
+
+///////////////////////////////////////////////////////////////////////////////
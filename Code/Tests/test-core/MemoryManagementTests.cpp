@@ -2,6 +2,7 @@
 #include "core/MemoryRouter.h"
 #include "core/MemoryUtils.h"
 #include "core/Array.h"
+#include "core/Thread.h"
 
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -40,6 +41,24 @@ namespace // anonymous
       } m_quad;
    };
 
+   // -------------------------------------------------------------------------
+
+   class AllocatingThread : public Thread
+   {
+      DECLARE_ALLOCATOR( AllocatingThread, AM_DEFAULT );
+
+   protected:
+      void run()
+      {
+         MemoryRouter& router = MemoryRouter::getInstance();
+         for ( uint i = 0; i < 10000; ++i )
+         {
+            void* ptr = router.alloc( 16 + i % 64, AM_DEFAULT, &router.m_defaultAllocator );
+            router.dealloc( ptr, AM_DEFAULT );
+         }
+      }
+   };
+
 } // anonymous
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -173,3 +192,25 @@ TEST( MemoryRouter, ensureDynamicallyAllocatedMembersAlignment )
 }
 
 ///////////////////////////////////////////////////////////////////////////////
+
+TEST( MemoryRouter, allocationsFromMultipleThreads )
+{
+   MemoryRouter& router = MemoryRouter::getInstance();
+   ulong memoryUsedBefore = router.getMemoryUsed();
+
+   // each thread releases everything it allocates, so the memory usage statistics should come out even
+   const uint threadsCount = 4;
+   AllocatingThread threads[threadsCount];
+   for ( uint i = 0; i < threadsCount; ++i )
+   {
+      threads[i].start();
+   }
+   for ( uint i = 0; i < threadsCount; ++i )
+   {
+      threads[i].join();
+   }
+
+   CPPUNIT_ASSERT_EQUAL( memoryUsedBefore, router.getMemoryUsed() );
+}
+
+///////////////////////////////////////////////////////////////////////////////
@@ -186,6 +186,39 @@ TEST( Quaternion, slerp )
 
 ///////////////////////////////////////////////////////////////////////////////
 
+TEST( Quaternion, slerp4 )
+{
+   // four pairs - among them a pair of identical quaternions, and a pair that lies in the opposite hemispheres
+   Quaternion a[4], b[4];
+   a[0].setAxisAngle( Vector( Quad_0100 ), Float_0 );
+   b[0].setAxisAngle( Vector( Quad_0100 ), FastFloat::fromFloat( DEG2RAD( 90.0f ) ) );
+   a[1].setAxisAngle( Vector( Quad_1000 ), FastFloat::fromFloat( DEG2RAD( 30.0f ) ) );
+   b[1].setAxisAngle( Vector( Quad_0010 ), FastFloat::fromFloat( DEG2RAD( 120.0f ) ) );
+   a[2].setAxisAngle( Vector( Quad_0010 ), FastFloat::fromFloat( DEG2RAD( 45.0f ) ) );
+   b[2] = a[2];
+   a[3].setAxisAngle( Vector( Quad_0100 ), FastFloat::fromFloat( DEG2RAD( 170.0f ) ) );
+   b[3].setAxisAngle( Vector( Quad_0100 ), FastFloat::fromFloat( DEG2RAD( -170.0f ) ) );
+
+   FastFloat t[4];
+   t[0] = Float_Inv2;
+   t[1] = FastFloat::fromFloat( 0.25f );
+   t[2] = FastFloat::fromFloat( 0.7f );
+   t[3] = Float_Inv2;
+
+   // the results should match the ones interpolated one by one
+   Quaternion results[4];
+   Quaternion::slerp4( a, b, t, results );
+
+   Quaternion expectedQ;
+   for ( int i = 0; i < 4; ++i )
+   {
+      expectedQ.setSlerp( a[i], b[i], t[i] );
+      COMPARE_QUAT( expectedQ, results[i] );
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 TEST( Quaternion, transform )
 {
    Quaternion q;
@@ -114,8 +114,12 @@ TEST( ReflectionEnum, simpleEnum )
    TReflectionEnum< WeekEnd >* weekendEnum = dynamic_cast< TReflectionEnum< WeekEnd >* >( typesRegistry.find< WeekEnd>() );
    CPPUNIT_ASSERT( NULL != weekendEnum );
 
+   // the enumerators are registered when they're used for the first time
+   CPPUNIT_ASSERT( !weekendEnum->isDefined() );
+
    const std::string &str = weekendEnum->from( Saturday );
    CPPUNIT_ASSERT_EQUAL( std::string( "Saturday" ), str );
+   CPPUNIT_ASSERT( weekendEnum->isDefined() );
 
    WeekEnd w;
    weekendEnum->to( "Sunday", w );
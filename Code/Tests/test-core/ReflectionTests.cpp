@@ -9,6 +9,9 @@
 #include "core\ReflectionObject.h"
 #include "core\ReflectionObjectsTracker.h"
 #include "core\ReflectionPropertiesView.h"
+#include "core\Resource.h"
+#include "core\Timer.h"
+#include "core\Log.h"
 
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -296,6 +299,89 @@ TEST( Reflection, isA )
 
 ///////////////////////////////////////////////////////////////////////////////
 
+TEST( Reflection, isAWithTypesRegisteredOutOfOrder )
+{
+   // register the derived type first - its flattened hierarchy will be queried before its base type is known
+   ReflectionTypesRegistry& typesRegistry = ReflectionTypesRegistry::getInstance();
+   typesRegistry.addSerializableType< DerivedTestClass >( "DerivedTestClass", new TSerializableTypeInstantiator< DerivedTestClass >() );
+
+   DerivedTestClass instA;
+   CPPUNIT_ASSERT( instA.isA< DerivedTestClass >() );
+   CPPUNIT_ASSERT( !instA.isA( SerializableReflectionType( "TestClass" ) ) );
+
+   // now register the base type - the hierarchy should be updated
+   typesRegistry.addSerializableType< TestClass >( "TestClass", new TSerializableTypeInstantiator< TestClass >() );
+   CPPUNIT_ASSERT( instA.isA< TestClass >() );
+   CPPUNIT_ASSERT( DynamicCast< TestClass >( &instA ) != NULL );
+
+   TestClass instB;
+   CPPUNIT_ASSERT( !instB.isA< DerivedTestClass >() );
+   CPPUNIT_ASSERT( DynamicCast< DerivedTestClass >( &instB ) == NULL );
+
+   typesRegistry.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST( Reflection, membersLookup )
+{
+   ReflectionTypesRegistry& typesRegistry = ReflectionTypesRegistry::getInstance();
+   typesRegistry.addSerializableType< TestClass >( "TestClass", new TSerializableTypeInstantiator< TestClass >() );
+   typesRegistry.addSerializableType< DerivedTestClass >( "DerivedTestClass", new TSerializableTypeInstantiator< DerivedTestClass >() );
+   typesRegistry.addSerializableType< PatchedTestClass >( "PatchedTestClass", new TSerializableTypeInstantiator< PatchedTestClass >() );
+
+   const SerializableReflectionType& derivedType = DerivedTestClass::getStaticRTTI();
+   CPPUNIT_ASSERT( derivedType.findMemberField( "m_val3" ) != NULL );
+   CPPUNIT_ASSERT( derivedType.findMemberField( "m_val1" ) == NULL );
+
+   // members of the parent types are accessible through the hierarchy lookup
+   CPPUNIT_ASSERT( derivedType.findHierarchyMemberField( ReflectionTypeComponent::generateId( "m_val3" ) ) != NULL );
+   CPPUNIT_ASSERT( derivedType.findHierarchyMemberField( ReflectionTypeComponent::generateId( "m_val1" ) ) == TestClass::getStaticRTTI().findMemberField( "m_val1" ) );
+   CPPUNIT_ASSERT( derivedType.findHierarchyMemberField( ReflectionTypeComponent::generateId( "m_val4" ) ) == NULL );
+
+   // patched members are mapped onto the new ones
+   const SerializableReflectionType& patchedType = PatchedTestClass::getStaticRTTI();
+   CPPUNIT_ASSERT( patchedType.findMemberField( "m_val2" ) == patchedType.findMemberField( "m_val" ) );
+   CPPUNIT_ASSERT( patchedType.findHierarchyMemberField( ReflectionTypeComponent::generateId( "m_val2" ) ) == patchedType.findMemberField( "m_val" ) );
+
+   typesRegistry.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST( Reflection, lazyTypeDefinition )
+{
+   ReflectionTypesRegistry& typesRegistry = ReflectionTypesRegistry::getInstance();
+   typesRegistry.addSerializableType< TestClass >( "TestClass", new TSerializableTypeInstantiator< TestClass >() );
+   typesRegistry.addSerializableType< DerivedTestClass >( "DerivedTestClass", new TSerializableTypeInstantiator< DerivedTestClass >() );
+   typesRegistry.addSerializableType< PatchedTestClass >( "PatchedTestClass", new TSerializableTypeInstantiator< PatchedTestClass >() );
+
+   // registering the types doesn't define them, but the classes already know their types
+   const SerializableReflectionType& baseType = TestClass::getStaticRTTI();
+   const SerializableReflectionType& derivedType = DerivedTestClass::getStaticRTTI();
+   const SerializableReflectionType& patchedType = PatchedTestClass::getStaticRTTI();
+   CPPUNIT_ASSERT( typesRegistry.findSerializable( "DerivedTestClass" ) == &derivedType );
+   CPPUNIT_ASSERT( !baseType.isDefined() );
+   CPPUNIT_ASSERT( !derivedType.isDefined() );
+   CPPUNIT_ASSERT( !patchedType.isDefined() );
+
+   // querying the hierarchy defines all types in it - and only them
+   CPPUNIT_ASSERT( derivedType.isA( baseType ) );
+   CPPUNIT_ASSERT( baseType.isDefined() );
+   CPPUNIT_ASSERT( derivedType.isDefined() );
+   CPPUNIT_ASSERT( !patchedType.isDefined() );
+   CPPUNIT_ASSERT_EQUAL( (std::size_t)1, derivedType.m_memberFields.size() );
+   CPPUNIT_ASSERT_EQUAL( (std::size_t)2, baseType.m_memberFields.size() );
+
+   // so does looking up a member
+   CPPUNIT_ASSERT( patchedType.findMemberField( "m_val" ) != NULL );
+   CPPUNIT_ASSERT( patchedType.isDefined() );
+
+   typesRegistry.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
 TEST( Reflection, primitiveTypes )
 {
    // setup reflection types
@@ -369,3 +455,44 @@ TEST( Reflection, reflectionObjectClassCanBeReflectedUpon )
 }
 
 ///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _TRACK_MEMORY_ALLOCATIONS
+
+TEST( Reflection, typesRegistrationPerformance )
+{
+   // register the complete set of types the application registers on startup - first
+   // the way it's done now, defining the types on first use, and then defining them up front
+   ReflectionTypesRegistry& typesRegistry = ReflectionTypesRegistry::getInstance();
+   typesRegistry.clear();
+
+   CTimer timer;
+   timer.tick();
+   TypesRegistration::registerAll();
+   timer.tick();
+   float lazyRegistrationDuration = timer.getTimeElapsed();
+
+   SerializableReflectionType* resourceType = typesRegistry.findSerializable( "Resource" );
+   CPPUNIT_ASSERT( resourceType != NULL );
+   CPPUNIT_ASSERT( !resourceType->isDefined() );
+
+   typesRegistry.clear();
+
+   timer.tick();
+   TypesRegistration::registerAll();
+   typesRegistry.defineAllTypes();
+   timer.tick();
+   float eagerRegistrationDuration = timer.getTimeElapsed();
+
+   resourceType = typesRegistry.findSerializable( "Resource" );
+   CPPUNIT_ASSERT( resourceType != NULL );
+   CPPUNIT_ASSERT( resourceType->isDefined() );
+
+   LOG( "Types registration: " << lazyRegistrationDuration << "s when the types are defined on first use, " << eagerRegistrationDuration << "s when they're defined up front\n" );
+
+   // cleanup
+   typesRegistry.clear();
+}
+
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
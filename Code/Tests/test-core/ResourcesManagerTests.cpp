@@ -3,6 +3,11 @@
 #include "core\File.h"
 #include "core\Resource.h"
 #include "core\ResourcesManager.h"
+#include "core\ResourceLoadingHandle.h"
+#include "core\ResourcesPrefetcher.h"
+#include "core\InStream.h"
+#include "core\Timer.h"
+#include "core\Log.h"
 #include <string>
 #include <map>
 #include "core\InArrayStream.h"
@@ -96,11 +101,121 @@ namespace // anonymous
          , m_referencedRes( NULL )
       {}
 
+      bool canReplaceContents() const { return true; }
+
+      void replaceContents( Resource& rhs )
+      {
+         m_referencedRes = static_cast< ResourceWithPointerMock& >( rhs ).m_referencedRes;
+      }
+
    };
    BEGIN_RESOURCE( ResourceWithPointerMock, rwp, AM_BINARY );
       PROPERTY_EDIT( "m_referencedRes", Resource*, m_referencedRes );
    END_OBJECT();
 
+   // -------------------------------------------------------------------------
+
+   class ResourceLoadingListenerMock : public ResourceLoadingListener
+   {
+   public:
+      std::vector< Resource* >      m_loadedResources;
+
+      void onResourceLoaded( ResourceLoadingHandle& handle )
+      {
+         m_loadedResources.push_back( handle.getResource() );
+      }
+   };
+
+   // -------------------------------------------------------------------------
+
+   class MergeableResourceMock : public Resource
+   {
+      DECLARE_RESOURCE()
+
+   public:
+      std::vector< int >      m_values;
+
+   public:
+      MergeableResourceMock( const FilePath& resourceName = FilePath() ) 
+         : Resource( resourceName )
+      {}
+
+      bool canMergeContents() const { return true; }
+
+      void mergeContents( Resource& rhs )
+      {
+         MergeableResourceMock& mergedResource = static_cast< MergeableResourceMock& >( rhs );
+         m_values.insert( m_values.end(), mergedResource.m_values.begin(), mergedResource.m_values.end() );
+      }
+   };
+   BEGIN_RESOURCE( MergeableResourceMock, mrm, AM_BINARY );
+      PROPERTY( std::vector< int >, m_values );
+   END_OBJECT();
+
+   // -------------------------------------------------------------------------
+
+   class MergeableResourceImporterMock : public TResourceImporter< MergeableResourceMock >
+   {
+   public:
+      static int     s_importsCount;
+
+   private:
+      int            m_parsedSize;
+
+   public:
+      MergeableResourceImporterMock( const FilePath& path, ResourcesManager& rm, IProgressObserver* observer ) 
+         : TResourceImporter< MergeableResourceMock >( path, rm, observer ) 
+         , m_parsedSize( -1 )
+      {}
+
+      void parse()
+      {
+         File* file = m_rm.getFilesystem().open( m_loadedFileName );
+         m_parsedSize = (int)file->size();
+         delete file;
+      }
+
+      void import( MergeableResourceMock& resource )
+      {
+         ++s_importsCount;
+
+         if ( m_parsedSize < 0 )
+         {
+            parse();
+         }
+         resource.m_values.push_back( m_parsedSize );
+      }
+   };
+   int MergeableResourceImporterMock::s_importsCount = 0;
+
+   // -------------------------------------------------------------------------
+
+   class ResourcesReloadListenerMock : public ResourcesReloadListener
+   {
+   public:
+      std::vector< Resource* >      m_reloadedResources;
+
+      void onResourceReloaded( Resource& resource )
+      {
+         m_reloadedResources.push_back( &resource );
+      }
+   };
+
+   // -------------------------------------------------------------------------
+
+   void rewriteFile( Filesystem& fs, const FilePath& path )
+   {
+      File* file = fs.open( path, std::ios_base::in | std::ios_base::binary );
+      Array< byte > contents;
+      contents.resizeWithoutInitializing( file->size() );
+      file->read( (byte*)contents, contents.size() );
+      delete file;
+
+      file = fs.open( path, std::ios_base::out | std::ios_base::binary );
+      file->write( (byte*)contents, contents.size() );
+      delete file;
+   }
+
 } // anonymous
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -108,6 +223,7 @@ namespace // anonymous
 DEFINE_TYPE_ID( ResourceMock )
 DEFINE_TYPE_ID( ObjMock )
 DEFINE_TYPE_ID( ResourceWithPointerMock )
+DEFINE_TYPE_ID( MergeableResourceMock )
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -180,6 +296,13 @@ TEST( Resource, resourceHandles )
    CPPUNIT_ASSERT_EQUAL( 0, hObj1.get().getValue() );
    CPPUNIT_ASSERT_EQUAL( 1, hObj2.get().getValue() );
 
+   // the handles cache the resource, but notice when it's replaced by another one
+   mgr.reset();
+   ResourceMock* newResource = new ResourceMock( resourceName );
+   mgr.addResource( newResource );
+   newResource->add( new ObjMock( 7 ) );
+   CPPUNIT_ASSERT_EQUAL( 7, hObj1.get().getValue() );
+
    mgr.reset();
 
    // clear the types registry
@@ -245,3 +368,618 @@ TEST( Resource, allRelatedResourcesAreSerializedTogether )
 }
 
 ///////////////////////////////////////////////////////////////////////////////
+
+TEST( ResourcesManager, asynchronousLoading )
+{
+   // setup reflection types
+   ReflectionTypesRegistry& typesRegistry = ReflectionTypesRegistry::getInstance();
+   typesRegistry.addSerializableType< ReflectionObject >( "ReflectionObject", NULL );
+   typesRegistry.addSerializableType< Resource >( "Resource", NULL );
+   typesRegistry.addSerializableType< ResourceWithPointerMock >( "ResourceWithPointerMock", new TSerializableTypeInstantiator< ResourceWithPointerMock >() );
+
+   // prepare the resources
+   ResourcesManager& mgr = ResourcesManager::getInstance();
+   mgr.reset();
+   mgr.setFilesystem( new Filesystem( "..\\Data" ) );
+
+   FilePath resource1Name( "asyncRes1.rwp" );
+   FilePath resource2Name( "asyncRes2.rwp" );
+   {
+      ResourceWithPointerMock* res1 = new ResourceWithPointerMock( resource1Name );
+      ResourceWithPointerMock* res2 = new ResourceWithPointerMock( resource2Name );
+      mgr.addResource( res1 );
+      mgr.addResource( res2 );
+      res1->m_referencedRes = res2;
+      res2->m_referencedRes = res1;
+      res1->saveResource();
+      mgr.reset();
+   }
+
+   // start loading the resource - the handle is returned right away, and the resource doesn't become
+   // available until the main thread collects it
+   ResourceLoadingListenerMock listener;
+   ResourceLoadingHandle* handle = mgr.loadAsync( resource1Name );
+   handle->attach( listener );
+   CPPUNIT_ASSERT( handle->isPending() );
+   CPPUNIT_ASSERT( handle->getResource() == NULL );
+   CPPUNIT_ASSERT_EQUAL( (uint)1, mgr.getPendingLoadsCount() );
+   CPPUNIT_ASSERT_EQUAL( (uint)0, mgr.getResourcesCount() );
+
+   // requesting the same resource again gives the same handle
+   ResourceLoadingHandle* sameHandle = mgr.loadAsync( resource1Name );
+   CPPUNIT_ASSERT( sameHandle == handle );
+   sameHandle->removeReference();
+
+   // a missing file fails to load
+   ResourceLoadingHandle* missingResHandle = mgr.loadAsync( FilePath( "missingAsyncRes.rwp" ) );
+
+   mgr.finishLoading();
+   CPPUNIT_ASSERT_EQUAL( (uint)0, mgr.getPendingLoadsCount() );
+
+   CPPUNIT_ASSERT_EQUAL( RLS_LOADED, handle->getState() );
+   CPPUNIT_ASSERT_EQUAL( RLS_FAILED, missingResHandle->getState() );
+   CPPUNIT_ASSERT( missingResHandle->getResource() == NULL );
+
+   ResourceWithPointerMock* restoredRes1 = handle->get< ResourceWithPointerMock >();
+   CPPUNIT_ASSERT( restoredRes1 != NULL );
+   CPPUNIT_ASSERT_EQUAL( (uint)1, listener.m_loadedResources.size() );
+   CPPUNIT_ASSERT( listener.m_loadedResources[0] == restoredRes1 );
+
+   // the referenced resource was loaded along with it
+   CPPUNIT_ASSERT_EQUAL( (uint)2, mgr.getResourcesCount() );
+   ResourceWithPointerMock* restoredRes2 = mgr.findResource< ResourceWithPointerMock >( resource2Name );
+   CPPUNIT_ASSERT( restoredRes2 != NULL );
+   CPPUNIT_ASSERT( restoredRes1->m_referencedRes == restoredRes2 );
+   CPPUNIT_ASSERT( restoredRes2->m_referencedRes == restoredRes1 );
+
+   // a resource that's already loaded is available right away
+   ResourceLoadingHandle* loadedResHandle = mgr.loadAsync( resource2Name );
+   CPPUNIT_ASSERT_EQUAL( RLS_LOADED, loadedResHandle->getState() );
+   CPPUNIT_ASSERT( loadedResHandle->getResource() == restoredRes2 );
+
+   // cleanup
+   handle->removeReference();
+   missingResHandle->removeReference();
+   loadedResHandle->removeReference();
+   mgr.reset();
+   typesRegistry.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST( ResourcesManager, memoryBudget )
+{
+   // setup reflection types
+   ReflectionTypesRegistry& typesRegistry = ReflectionTypesRegistry::getInstance();
+   typesRegistry.addSerializableType< ReflectionObject >( "ReflectionObject", NULL );
+   typesRegistry.addSerializableType< Resource >( "Resource", NULL );
+   typesRegistry.addSerializableType< ResourceMock >( "ResourceMock", new TSerializableTypeInstantiator< ResourceMock >() );
+
+   ResourcesManager& mgr = ResourcesManager::getInstance();
+   mgr.reset();
+   mgr.setFilesystem( new Filesystem( "..\\Data" ) );
+   mgr.resetStatistics();
+
+   ResourceMock* res1 = new ResourceMock( FilePath( "budgetRes1.txt" ) );
+   ResourceMock* res2 = new ResourceMock( FilePath( "budgetRes2.txt" ) );
+   ResourceMock* res3 = new ResourceMock( FilePath( "budgetRes3.txt" ) );
+   mgr.addResource( res1 );
+   mgr.addResource( res2 );
+   mgr.addResource( res3 );
+
+   const uint resourceSize = res1->getMemoryUsage();
+   CPPUNIT_ASSERT_EQUAL( 3 * resourceSize, mgr.getMemoryUsage() );
+
+   // there's no budget by default, so nothing gets evicted
+   mgr.enforceMemoryBudget();
+   CPPUNIT_ASSERT_EQUAL( (uint)3, mgr.getResourcesCount() );
+
+   // the resources that weren't saved, or that nobody released, are never evicted
+   mgr.setMemoryBudget( 1 );
+   mgr.release( res1 );
+   mgr.release( res2 );
+   mgr.release( res3 );
+   mgr.enforceMemoryBudget();
+   CPPUNIT_ASSERT_EQUAL( (uint)3, mgr.getResourcesCount() );
+
+   res1->saveResource();
+   res2->saveResource();
+   res3->saveResource();
+   CPPUNIT_ASSERT( mgr.create( FilePath( "budgetRes1.txt" ) ) == res1 );
+   CPPUNIT_ASSERT( mgr.create( FilePath( "budgetRes2.txt" ) ) == res2 );
+   CPPUNIT_ASSERT( mgr.create( FilePath( "budgetRes3.txt" ) ) == res3 );
+   mgr.enforceMemoryBudget();
+   CPPUNIT_ASSERT_EQUAL( (uint)3, mgr.getResourcesCount() );
+
+   // release the resources again, and then use the first one, so that it becomes the most recently used one, 
+   // and hold on to the second one
+   mgr.release( res3 );
+   mgr.release( res2 );
+   mgr.release( res1 );
+   CPPUNIT_ASSERT( mgr.create( FilePath( "budgetRes1.txt" ) ) == res1 );
+   mgr.release( res1 );
+   res2->addReference();
+
+   // make room for two resources only - the least recently used one nobody references goes away
+   mgr.setMemoryBudget( 2 * resourceSize );
+   mgr.enforceMemoryBudget();
+   CPPUNIT_ASSERT_EQUAL( (uint)2, mgr.getResourcesCount() );
+   CPPUNIT_ASSERT( mgr.findResource( FilePath( "budgetRes1.txt" ) ) == res1 );
+   CPPUNIT_ASSERT( mgr.findResource( FilePath( "budgetRes2.txt" ) ) == res2 );
+   CPPUNIT_ASSERT( mgr.findResource( FilePath( "budgetRes3.txt" ) ) == NULL );
+
+   // a changed resource is never evicted - its changes would be lost
+   res1->markDirty();
+   mgr.setMemoryBudget( 1 );
+   mgr.enforceMemoryBudget();
+   CPPUNIT_ASSERT_EQUAL( (uint)2, mgr.getResourcesCount() );
+
+   // once it's saved, it can go - unlike a referenced resource, which is never evicted, even if the budget is exceeded
+   res1->saveResource();
+   mgr.enforceMemoryBudget();
+   CPPUNIT_ASSERT_EQUAL( (uint)1, mgr.getResourcesCount() );
+   CPPUNIT_ASSERT( mgr.findResource( FilePath( "budgetRes2.txt" ) ) == res2 );
+
+   const ResourcesStatistics& stats = mgr.getStatistics();
+   CPPUNIT_ASSERT_EQUAL( (uint)4, stats.m_hits );
+   CPPUNIT_ASSERT_EQUAL( (uint)0, stats.m_misses );
+   CPPUNIT_ASSERT_EQUAL( (uint)2, stats.m_evictions );
+   CPPUNIT_ASSERT_EQUAL( 2 * resourceSize, stats.m_evictedMemory );
+
+   // cleanup
+   mgr.setMemoryBudget( 0 );
+   mgr.reset();
+   res2->removeReference();
+   typesRegistry.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST( ResourcesManager, memoryBudgetRespectsUsersAndDependencies )
+{
+   // setup reflection types
+   ReflectionTypesRegistry& typesRegistry = ReflectionTypesRegistry::getInstance();
+   typesRegistry.addSerializableType< ReflectionObject >( "ReflectionObject", NULL );
+   typesRegistry.addSerializableType< Resource >( "Resource", NULL );
+   typesRegistry.addSerializableType< ResourceWithPointerMock >( "ResourceWithPointerMock", new TSerializableTypeInstantiator< ResourceWithPointerMock >() );
+
+   ResourcesManager& mgr = ResourcesManager::getInstance();
+   mgr.reset();
+   mgr.setFilesystem( new Filesystem( "..\\Data" ) );
+
+   // the first resource references the second one
+   ResourceWithPointerMock* dependentRes = new ResourceWithPointerMock( FilePath( "budgetDependent.rwp" ) );
+   ResourceWithPointerMock* dependencyRes = new ResourceWithPointerMock( FilePath( "budgetDependency.rwp" ) );
+   dependentRes->m_referencedRes = dependencyRes;
+   mgr.addResource( dependentRes );
+   mgr.addResource( dependencyRes );
+   dependencyRes->saveResource();
+   dependentRes->saveResource();
+
+   // the dependency has two users
+   CPPUNIT_ASSERT( mgr.create( FilePath( "budgetDependent.rwp" ) ) == dependentRes );
+   CPPUNIT_ASSERT( mgr.create( FilePath( "budgetDependency.rwp" ) ) == dependencyRes );
+   CPPUNIT_ASSERT( mgr.create( FilePath( "budgetDependency.rwp" ) ) == dependencyRes );
+
+   // a resource is released once all of its users release it
+   mgr.setMemoryBudget( 1 );
+   mgr.release( dependencyRes );
+   mgr.enforceMemoryBudget();
+   CPPUNIT_ASSERT_EQUAL( (uint)2, mgr.getResourcesCount() );
+
+   // and it stays for as long as another resource depends on it
+   mgr.release( dependencyRes );
+   mgr.enforceMemoryBudget();
+   CPPUNIT_ASSERT_EQUAL( (uint)2, mgr.getResourcesCount() );
+
+   // it can go once the resource that depends on it is gone
+   mgr.release( dependentRes );
+   mgr.enforceMemoryBudget();
+   CPPUNIT_ASSERT_EQUAL( (uint)1, mgr.getResourcesCount() );
+   CPPUNIT_ASSERT( mgr.findResource( FilePath( "budgetDependency.rwp" ) ) == dependencyRes );
+
+   mgr.enforceMemoryBudget();
+   CPPUNIT_ASSERT_EQUAL( (uint)0, mgr.getResourcesCount() );
+
+   // cleanup
+   mgr.setMemoryBudget( 0 );
+   mgr.reset();
+   typesRegistry.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST( ResourcesManager, prefetchingDependencies )
+{
+   // setup reflection types
+   ReflectionTypesRegistry& typesRegistry = ReflectionTypesRegistry::getInstance();
+   typesRegistry.addSerializableType< ReflectionObject >( "ReflectionObject", NULL );
+   typesRegistry.addSerializableType< Resource >( "Resource", NULL );
+   typesRegistry.addSerializableType< ResourceWithPointerMock >( "ResourceWithPointerMock", new TSerializableTypeInstantiator< ResourceWithPointerMock >() );
+
+   ResourcesManager& mgr = ResourcesManager::getInstance();
+   mgr.reset();
+   mgr.setFilesystem( new Filesystem( "..\\Data" ) );
+
+   // create a chain of resources: res1 -> res2 -> res3
+   FilePath resource1Name( "prefetchRes1.rwp" );
+   FilePath resource2Name( "prefetchRes2.rwp" );
+   FilePath resource3Name( "prefetchRes3.rwp" );
+   {
+      ResourceWithPointerMock* res1 = new ResourceWithPointerMock( resource1Name );
+      ResourceWithPointerMock* res2 = new ResourceWithPointerMock( resource2Name );
+      ResourceWithPointerMock* res3 = new ResourceWithPointerMock( resource3Name );
+      mgr.addResource( res1 );
+      mgr.addResource( res2 );
+      mgr.addResource( res3 );
+      res1->m_referencedRes = res2;
+      res2->m_referencedRes = res3;
+      res1->saveResource();
+      mgr.reset();
+   }
+
+   // the whole chain is known before any of the resources gets loaded
+   ResourcesPrefetcher prefetcher( mgr.getFilesystem() );
+   prefetcher.prefetch( resource2Name, &mgr );
+   CPPUNIT_ASSERT_EQUAL( (std::size_t)2, prefetcher.getDependencies().size() );
+   CPPUNIT_ASSERT( prefetcher.getDependencies()[0] == resource2Name );
+   CPPUNIT_ASSERT( prefetcher.getDependencies()[1] == resource3Name );
+
+   prefetcher.prefetch( resource1Name, &mgr );
+   CPPUNIT_ASSERT_EQUAL( (std::size_t)3, prefetcher.getDependencies().size() );
+   CPPUNIT_ASSERT_EQUAL( (uint)3, prefetcher.getPrefetchedFilesCount() );
+   CPPUNIT_ASSERT_EQUAL( (uint)0, mgr.getResourcesCount() );
+
+   // the stream reads the prefetched data
+   InStream* stream = prefetcher.open( resource3Name );
+   CPPUNIT_ASSERT( stream != NULL );
+   delete stream;
+   prefetcher.release( resource3Name );
+   CPPUNIT_ASSERT( prefetcher.open( resource3Name ) == NULL );
+   prefetcher.clear();
+
+   // the resources that are already loaded are neither mapped further, nor prefetched
+   ResourceWithPointerMock* restoredRes2 = mgr.create< ResourceWithPointerMock >( resource2Name );
+   CPPUNIT_ASSERT( restoredRes2 != NULL );
+   CPPUNIT_ASSERT( restoredRes2->m_referencedRes == mgr.findResource( resource3Name ) );
+
+   prefetcher.prefetch( resource1Name, &mgr );
+   CPPUNIT_ASSERT_EQUAL( (std::size_t)2, prefetcher.getDependencies().size() );
+   CPPUNIT_ASSERT_EQUAL( (uint)1, prefetcher.getPrefetchedFilesCount() );
+
+   // and loading the resource links the whole chain
+   ResourceWithPointerMock* restoredRes1 = mgr.create< ResourceWithPointerMock >( resource1Name );
+   CPPUNIT_ASSERT( restoredRes1 != NULL );
+   CPPUNIT_ASSERT( restoredRes1->m_referencedRes == restoredRes2 );
+
+   // cleanup
+   prefetcher.clear();
+   mgr.reset();
+   typesRegistry.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST( ResourcesManager, importCache )
+{
+   // setup reflection types
+   ReflectionTypesRegistry& typesRegistry = ReflectionTypesRegistry::getInstance();
+   typesRegistry.addSerializableType< ReflectionObject >( "ReflectionObject", NULL );
+   typesRegistry.addSerializableType< Resource >( "Resource", NULL );
+   typesRegistry.addSerializableType< MergeableResourceMock >( "MergeableResourceMock", new TSerializableTypeInstantiator< MergeableResourceMock >() );
+
+   ResourcesManager& mgr = ResourcesManager::getInstance();
+   mgr.reset();
+   mgr.setFilesystem( new Filesystem( "..\\Data" ) );
+   mgr.resetStatistics();
+   mgr.addImporter< MergeableResourceImporterMock, MergeableResourceMock >( "mrs" );
+   MergeableResourceImporterMock::s_importsCount = 0;
+
+   Filesystem& fs = mgr.getFilesystem();
+   fs.remove( FilePath( IMPORT_CACHE_DIR ) );
+
+   FilePath sourcePath( "importedFile.mrs" );
+   {
+      File* file = fs.open( sourcePath, std::ios_base::out );
+      file->write( ( byte* )"abc", 3 );
+      delete file;
+   }
+
+   // the first import parses the file
+   MergeableResourceMock* resource1 = new MergeableResourceMock( FilePath( "importTarget1.mrm" ) );
+   mgr.addResource( resource1 );
+   CPPUNIT_ASSERT( mgr.import< MergeableResourceMock >( sourcePath, *resource1 ) );
+   CPPUNIT_ASSERT_EQUAL( 1, MergeableResourceImporterMock::s_importsCount );
+   CPPUNIT_ASSERT_EQUAL( (std::size_t)1, resource1->m_values.size() );
+   CPPUNIT_ASSERT_EQUAL( 3, resource1->m_values[0] );
+
+   // the next one reuses its results
+   MergeableResourceMock* resource2 = new MergeableResourceMock( FilePath( "importTarget2.mrm" ) );
+   mgr.addResource( resource2 );
+   CPPUNIT_ASSERT( mgr.import< MergeableResourceMock >( sourcePath, *resource2 ) );
+   CPPUNIT_ASSERT_EQUAL( 1, MergeableResourceImporterMock::s_importsCount );
+   CPPUNIT_ASSERT_EQUAL( (std::size_t)1, resource2->m_values.size() );
+   CPPUNIT_ASSERT_EQUAL( 3, resource2->m_values[0] );
+
+   // until the file changes
+   {
+      File* file = fs.open( sourcePath, std::ios_base::out );
+      file->write( ( byte* )"abcde", 5 );
+      delete file;
+   }
+   CPPUNIT_ASSERT( mgr.import< MergeableResourceMock >( sourcePath, *resource2 ) );
+   CPPUNIT_ASSERT_EQUAL( 2, MergeableResourceImporterMock::s_importsCount );
+   CPPUNIT_ASSERT_EQUAL( (std::size_t)2, resource2->m_values.size() );
+   CPPUNIT_ASSERT_EQUAL( 5, resource2->m_values[1] );
+
+   // files there are no importers for aren't imported
+   CPPUNIT_ASSERT( !mgr.import< MergeableResourceMock >( FilePath( "importedFile.xyz" ), *resource2 ) );
+
+   const ResourcesStatistics& stats = mgr.getStatistics();
+   CPPUNIT_ASSERT_EQUAL( (uint)1, stats.m_importCacheHits );
+   CPPUNIT_ASSERT_EQUAL( (uint)2, stats.m_importCacheMisses );
+
+   // cleanup
+   mgr.reset();
+   fs.remove( sourcePath );
+   fs.remove( FilePath( IMPORT_CACHE_DIR ) );
+   typesRegistry.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST( ResourcesManager, batchImport )
+{
+   // setup reflection types
+   ReflectionTypesRegistry& typesRegistry = ReflectionTypesRegistry::getInstance();
+   typesRegistry.addSerializableType< ReflectionObject >( "ReflectionObject", NULL );
+   typesRegistry.addSerializableType< Resource >( "Resource", NULL );
+   typesRegistry.addSerializableType< MergeableResourceMock >( "MergeableResourceMock", new TSerializableTypeInstantiator< MergeableResourceMock >() );
+
+   ResourcesManager& mgr = ResourcesManager::getInstance();
+   mgr.reset();
+   mgr.setFilesystem( new Filesystem( "..\\Data" ) );
+   mgr.resetStatistics();
+   mgr.setImportThreadsCount( 3 );
+   mgr.addImporter< MergeableResourceImporterMock, MergeableResourceMock >( "mrs" );
+   MergeableResourceImporterMock::s_importsCount = 0;
+
+   Filesystem& fs = mgr.getFilesystem();
+   fs.remove( FilePath( IMPORT_CACHE_DIR ) );
+
+   // files of different sizes, so that we can tell their import results apart
+   std::vector< FilePath > paths;
+   const char* contents = "abcdefgh";
+   for ( int i = 0; i < 6; ++i )
+   {
+      char fileName[32];
+      sprintf_s( fileName, "batchImportedFile%d.mrs", i );
+      paths.push_back( FilePath( fileName ) );
+
+      File* file = fs.open( paths.back(), std::ios_base::out );
+      file->write( ( byte* )contents, ( i * 5 ) % 7 + 1 );
+      delete file;
+   }
+   paths.push_back( FilePath( "batchImportedFile.xyz" ) );
+
+   // import the files one by one
+   mgr.setImportCacheEnabled( false );
+   MergeableResourceMock* serialResource = new MergeableResourceMock( FilePath( "serialImportTarget.mrm" ) );
+   mgr.addResource( serialResource );
+   for ( uint i = 0; i < paths.size(); ++i )
+   {
+      mgr.import< MergeableResourceMock >( paths[i], *serialResource );
+   }
+   CPPUNIT_ASSERT_EQUAL( (std::size_t)6, serialResource->m_values.size() );
+
+   // a batch import gives the same results, in the same order
+   MergeableResourceMock* batchResource = new MergeableResourceMock( FilePath( "batchImportTarget.mrm" ) );
+   mgr.addResource( batchResource );
+   CPPUNIT_ASSERT_EQUAL( (uint)6, mgr.importBatch< MergeableResourceMock >( paths, *batchResource ) );
+   CPPUNIT_ASSERT( serialResource->m_values == batchResource->m_values );
+   CPPUNIT_ASSERT_EQUAL( 12, MergeableResourceImporterMock::s_importsCount );
+
+   // and so does a batch import that goes through the cache - first when the results get cached...
+   mgr.setImportCacheEnabled( true );
+   MergeableResourceMock* cachingResource = new MergeableResourceMock( FilePath( "cachingImportTarget.mrm" ) );
+   mgr.addResource( cachingResource );
+   CPPUNIT_ASSERT_EQUAL( (uint)6, mgr.importBatch< MergeableResourceMock >( paths, *cachingResource ) );
+   CPPUNIT_ASSERT( serialResource->m_values == cachingResource->m_values );
+   CPPUNIT_ASSERT_EQUAL( 18, MergeableResourceImporterMock::s_importsCount );
+
+   // ...and then when they're reused
+   MergeableResourceMock* cachedResource = new MergeableResourceMock( FilePath( "cachedImportTarget.mrm" ) );
+   mgr.addResource( cachedResource );
+   CPPUNIT_ASSERT_EQUAL( (uint)6, mgr.importBatch< MergeableResourceMock >( paths, *cachedResource ) );
+   CPPUNIT_ASSERT( serialResource->m_values == cachedResource->m_values );
+   CPPUNIT_ASSERT_EQUAL( 18, MergeableResourceImporterMock::s_importsCount );
+
+   // cleanup
+   mgr.reset();
+   for ( uint i = 0; i < paths.size(); ++i )
+   {
+      fs.remove( paths[i] );
+   }
+   fs.remove( FilePath( IMPORT_CACHE_DIR ) );
+   typesRegistry.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST( ResourcesManager, hotReload )
+{
+   // setup reflection types
+   ReflectionTypesRegistry& typesRegistry = ReflectionTypesRegistry::getInstance();
+   typesRegistry.addSerializableType< ReflectionObject >( "ReflectionObject", NULL );
+   typesRegistry.addSerializableType< Resource >( "Resource", NULL );
+   typesRegistry.addSerializableType< ResourceWithPointerMock >( "ResourceWithPointerMock", new TSerializableTypeInstantiator< ResourceWithPointerMock >() );
+
+   ResourcesManager& mgr = ResourcesManager::getInstance();
+   mgr.reset();
+   mgr.setFilesystem( new Filesystem( "..\\Data" ) );
+   mgr.resetStatistics();
+   mgr.setHotReloadDelay( 0.5f );
+
+   ResourcesReloadListenerMock listener;
+   mgr.attachReloadListener( listener );
+
+   // create a chain of resources: res1 -> res2 -> res3, and a resource that's not related to it
+   FilePath resource1Name( "hotReloadRes1.rwp" );
+   FilePath resource2Name( "hotReloadRes2.rwp" );
+   FilePath resource3Name( "hotReloadRes3.rwp" );
+   FilePath unrelatedResourceName( "hotReloadUnrelatedRes.rwp" );
+
+   ResourceWithPointerMock* res1 = new ResourceWithPointerMock( resource1Name );
+   ResourceWithPointerMock* res2 = new ResourceWithPointerMock( resource2Name );
+   ResourceWithPointerMock* res3 = new ResourceWithPointerMock( resource3Name );
+   ResourceWithPointerMock* unrelatedRes = new ResourceWithPointerMock( unrelatedResourceName );
+   mgr.addResource( res1 );
+   mgr.addResource( res2 );
+   mgr.addResource( res3 );
+   mgr.addResource( unrelatedRes );
+   res1->m_referencedRes = res2;
+   res2->m_referencedRes = res3;
+   res1->saveResource();
+   unrelatedRes->saveResource();
+
+   // saving the resources doesn't make them reload
+   CPPUNIT_ASSERT_EQUAL( (uint)0, mgr.getEditedFilesCount() );
+
+   // edit two files of the chain
+   Filesystem& fs = mgr.getFilesystem();
+   rewriteFile( fs, resource3Name );
+   rewriteFile( fs, resource2Name );
+   CPPUNIT_ASSERT_EQUAL( (uint)2, mgr.getEditedFilesCount() );
+
+   // nothing happens while the files keep changing
+   mgr.processEditedFiles( 0.3f );
+   rewriteFile( fs, resource3Name );
+   mgr.processEditedFiles( 0.3f );
+   CPPUNIT_ASSERT( mgr.findResource( resource3Name ) == res3 );
+   CPPUNIT_ASSERT_EQUAL( (std::size_t)0, listener.m_reloadedResources.size() );
+
+   // once they stop, the edited files get reloaded at once, and the whole chain gets reported - 
+   // each resource once, dependencies first
+   mgr.processEditedFiles( 0.3f );
+   CPPUNIT_ASSERT_EQUAL( (uint)0, mgr.getEditedFilesCount() );
+   CPPUNIT_ASSERT_EQUAL( (uint)2, mgr.getStatistics().m_reloads );
+   CPPUNIT_ASSERT_EQUAL( (std::size_t)3, listener.m_reloadedResources.size() );
+   CPPUNIT_ASSERT( listener.m_reloadedResources[0] == res3 );
+   CPPUNIT_ASSERT( listener.m_reloadedResources[1] == res2 );
+   CPPUNIT_ASSERT( listener.m_reloadedResources[2] == res1 );
+
+   // the resources are reloaded in place, so the pointers to them remain valid
+   CPPUNIT_ASSERT( mgr.findResource( resource1Name ) == res1 );
+   CPPUNIT_ASSERT( mgr.findResource( resource2Name ) == res2 );
+   CPPUNIT_ASSERT( mgr.findResource( resource3Name ) == res3 );
+   CPPUNIT_ASSERT( res1->m_referencedRes == res2 );
+   CPPUNIT_ASSERT( res2->m_referencedRes == res3 );
+   CPPUNIT_ASSERT_EQUAL( (uint)4, mgr.getResourcesCount() );
+
+   // a resource gets reloaded with what its file contains
+   res2->m_referencedRes = NULL;
+   rewriteFile( fs, resource2Name );
+   mgr.reloadEditedResources();
+   CPPUNIT_ASSERT( res2->m_referencedRes == res3 );
+
+   // and the resources that don't depend on the edited files stay untouched
+   CPPUNIT_ASSERT( mgr.findResource( unrelatedResourceName ) == unrelatedRes );
+
+   // cleanup
+   mgr.detachReloadListener( listener );
+   mgr.reset();
+   typesRegistry.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _TRACK_MEMORY_ALLOCATIONS
+
+TEST( ResourcesManager, deepDependencyChainLoadingPerformance )
+{
+   // setup reflection types
+   ReflectionTypesRegistry& typesRegistry = ReflectionTypesRegistry::getInstance();
+   typesRegistry.addSerializableType< ReflectionObject >( "ReflectionObject", NULL );
+   typesRegistry.addSerializableType< Resource >( "Resource", NULL );
+   typesRegistry.addSerializableType< ResourceWithPointerMock >( "ResourceWithPointerMock", new TSerializableTypeInstantiator< ResourceWithPointerMock >() );
+
+   ResourcesManager& mgr = ResourcesManager::getInstance();
+   mgr.reset();
+   mgr.setFilesystem( new Filesystem( "..\\Data" ) );
+
+   // create a chain of resources, each referencing the next one
+   const uint CHAIN_LENGTH = 256;
+   std::vector< FilePath > paths;
+   {
+      char tmpStr[64];
+      ResourceWithPointerMock* prevRes = NULL;
+      for ( uint i = 0; i < CHAIN_LENGTH; ++i )
+      {
+         sprintf_s( tmpStr, "chainRes%d.rwp", i );
+         paths.push_back( FilePath( tmpStr ) );
+
+         ResourceWithPointerMock* res = new ResourceWithPointerMock( paths.back() );
+         mgr.addResource( res );
+         if ( prevRes )
+         {
+            prevRes->m_referencedRes = res;
+         }
+         prevRes = res;
+      }
+      mgr.findResource( paths[0] )->saveResource();
+      mgr.reset();
+   }
+
+   CTimer timer;
+
+   // prefetching alone
+   ResourcesPrefetcher prefetcher( mgr.getFilesystem() );
+   timer.tick();
+   prefetcher.prefetch( paths[0] );
+   timer.tick();
+   float prefetchDuration = timer.getTimeElapsed();
+
+   CPPUNIT_ASSERT_EQUAL( (std::size_t)CHAIN_LENGTH, prefetcher.getDependencies().size() );
+   CPPUNIT_ASSERT_EQUAL( CHAIN_LENGTH, prefetcher.getPrefetchedFilesCount() );
+   prefetcher.clear();
+
+   // synchronous loading
+   timer.tick();
+   ResourceWithPointerMock* res = mgr.create< ResourceWithPointerMock >( paths[0] );
+   timer.tick();
+   float syncLoadDuration = timer.getTimeElapsed();
+
+   CPPUNIT_ASSERT( res != NULL );
+   CPPUNIT_ASSERT_EQUAL( CHAIN_LENGTH, mgr.getResourcesCount() );
+   mgr.reset();
+
+   // asynchronous loading
+   timer.tick();
+   ResourceLoadingHandle* handle = mgr.loadAsync( paths[0] );
+   mgr.finishLoading();
+   timer.tick();
+   float asyncLoadDuration = timer.getTimeElapsed();
+
+   CPPUNIT_ASSERT_EQUAL( RLS_LOADED, handle->getState() );
+   CPPUNIT_ASSERT_EQUAL( CHAIN_LENGTH, mgr.getResourcesCount() );
+
+   // the whole chain got linked
+   uint linkedCount = 0;
+   for ( Resource* linkedRes = handle->getResource(); linkedRes; linkedRes = static_cast< ResourceWithPointerMock* >( linkedRes )->m_referencedRes )
+   {
+      CPPUNIT_ASSERT( linkedRes->getFilePath() == paths[linkedCount] );
+      ++linkedCount;
+   }
+   CPPUNIT_ASSERT_EQUAL( CHAIN_LENGTH, linkedCount );
+
+   LOG( "Loading a chain of " << CHAIN_LENGTH << " resources: prefetching " << prefetchDuration << "s, synchronous loading " << syncLoadDuration << "s, asynchronous loading " << asyncLoadDuration << "s\n" );
+
+   // cleanup
+   handle->removeReference();
+   mgr.reset();
+   typesRegistry.clear();
+}
+
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
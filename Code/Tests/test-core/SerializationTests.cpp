@@ -10,6 +10,13 @@
 #include "core\Resource.h"
 #include "core\InArrayStream.h"
 #include "core\OutArrayStream.h"
+#include "core\InFileStream.h"
+#include "core\OutFileStream.h"
+#include "core\Filesystem.h"
+#include "core\File.h"
+#include "core\ReflectionArchiveCooker.h"
+#include "core\ReflectionStringTable.h"
+#include "core\IDString.h"
 
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -701,3 +708,502 @@ TEST( Serialization, loadSaveNotifications )
 }
 
 ///////////////////////////////////////////////////////////////////////////////
+
+TEST( Serialization, cookedArchives )
+{
+   // setup reflection types
+   ReflectionTypesRegistry& typesRegistry = ReflectionTypesRegistry::getInstance();
+   typesRegistry.clear();
+   typesRegistry.addSerializableType< Resource >( "Resource", NULL );
+   typesRegistry.addSerializableType< SerializationTestClass >( "SerializationTestClass", new TSerializableTypeInstantiator< SerializationTestClass >() );
+   typesRegistry.addSerializableType< SerializationTestClassWithSharedPointers >( "SerializationTestClassWithSharedPointers", new TSerializableTypeInstantiator< SerializationTestClassWithSharedPointers >() );
+
+   // serialize the original objects
+   Array< byte > archiveBuf;
+   {
+      OutArrayStream outStream( archiveBuf );
+
+      SerializationTestClass* sharedObj = new SerializationTestClass( 1, 2, "sharedObj" );
+      SerializationTestClassWithSharedPointers obj1( "obj1", sharedObj );
+      SerializationTestClassWithSharedPointers obj2( "obj2", sharedObj );
+      ReflectionSaver saver( outStream );
+      saver.save( &obj1 );
+      saver.save( &obj2 );
+      saver.flush();
+
+      delete sharedObj;
+   }
+
+   // cook the archive
+   Array< byte > cookedArchiveBuf;
+   {
+      InArrayStream inStream( archiveBuf );
+      OutArrayStream outStream( cookedArchiveBuf );
+      CPPUNIT_ASSERT( ReflectionArchiveCooker::cook( inStream, outStream ) );
+   }
+
+   // only archives written by the ReflectionSaver can be cooked
+   {
+      Array< byte > outBuf;
+      InArrayStream inStream( cookedArchiveBuf );
+      OutArrayStream outStream( outBuf );
+      CPPUNIT_ASSERT( !ReflectionArchiveCooker::cook( inStream, outStream ) );
+   }
+
+   // restore the objects from the cooked archive
+   InArrayStream inStream( cookedArchiveBuf );
+   ReflectionLoader loader;
+   loader.deserialize( inStream );
+   SerializationTestClassWithSharedPointers* restoredObject1 = loader.getNextObject< SerializationTestClassWithSharedPointers >();
+   SerializationTestClassWithSharedPointers* restoredObject2 = loader.getNextObject< SerializationTestClassWithSharedPointers >();
+   CPPUNIT_ASSERT( restoredObject1 != NULL );
+   CPPUNIT_ASSERT( restoredObject2 != NULL );
+   CPPUNIT_ASSERT_EQUAL( std::string( "obj1" ), restoredObject1->m_uniqueId );
+   CPPUNIT_ASSERT_EQUAL( std::string( "obj2" ), restoredObject2->m_uniqueId );
+
+   // the pointers between the objects should've been fixed up
+   CPPUNIT_ASSERT( restoredObject1->m_ptr != NULL );
+   CPPUNIT_ASSERT( restoredObject1->m_ptr == restoredObject2->m_ptr );
+
+   SerializationTestClass* restoredSharedObj = dynamic_cast< SerializationTestClass* >( restoredObject1->m_ptr );
+   CPPUNIT_ASSERT( restoredSharedObj != NULL );
+   CPPUNIT_ASSERT_EQUAL( 1, restoredSharedObj->m_val1 );
+   CPPUNIT_ASSERT_EQUAL( 2, restoredSharedObj->m_val2 );
+   CPPUNIT_ASSERT_EQUAL( std::string( "sharedObj" ), restoredSharedObj->m_uniqueId );
+
+   // cleanup
+   delete restoredObject1;
+   delete restoredObject2;
+   delete restoredSharedObj;
+
+   // an archive with a table that points outside of it shouldn't be loaded
+   {
+      Array< byte > corruptedArchiveBuf;
+      corruptedArchiveBuf.copyFrom( cookedArchiveBuf );
+
+      // the header follows the magic number and the archive size
+      CookedArchiveHeader* header = (CookedArchiveHeader*)( (byte*)corruptedArchiveBuf + 2 * sizeof( uint ) );
+      header->m_objectsOffset = 0xfffffff0;
+
+      InArrayStream corruptedStream( corruptedArchiveBuf );
+      ReflectionLoader corruptedArchiveLoader;
+      corruptedArchiveLoader.deserialize( corruptedStream );
+      CPPUNIT_ASSERT( corruptedArchiveLoader.getNextObject< SerializationTestClassWithSharedPointers >() == NULL );
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST( Serialization, incrementalSaving )
+{
+   // setup reflection types
+   ReflectionTypesRegistry& typesRegistry = ReflectionTypesRegistry::getInstance();
+   typesRegistry.clear();
+   typesRegistry.addSerializableType< Resource >( "Resource", NULL );
+   typesRegistry.addSerializableType< SerializationTestClass >( "SerializationTestClass", new TSerializableTypeInstantiator< SerializationTestClass >() );
+   typesRegistry.addSerializableType< SerializationTestClassWithSharedPointers >( "SerializationTestClassWithSharedPointers", new TSerializableTypeInstantiator< SerializationTestClassWithSharedPointers >() );
+
+   ReflectionSaveCache cache;
+   SerializationTestClass sharedObj( 1, 2, "sharedObj" );
+   SerializationTestClassWithSharedPointers obj( "obj", &sharedObj );
+
+   // save the objects for the first time - that will fill the cache
+   {
+      Array< byte > memBuf;
+      OutArrayStream outStream( memBuf );
+      ReflectionSaver saver( outStream, &cache );
+      saver.save( &obj );
+      saver.flush();
+   }
+   CPPUNIT_ASSERT_EQUAL( (uint)2, cache.size() );
+
+   // change the value without notifying about it - the saver won't notice the change and will reuse the cached data
+   sharedObj.m_val1 = 5;
+   {
+      Array< byte > memBuf;
+      InArrayStream inStream( memBuf );
+      OutArrayStream outStream( memBuf );
+      ReflectionSaver saver( outStream, &cache );
+      saver.save( &obj );
+      saver.flush();
+
+      ReflectionLoader loader;
+      loader.deserialize( inStream );
+      SerializationTestClassWithSharedPointers* restoredObject = loader.getNextObject< SerializationTestClassWithSharedPointers >();
+      CPPUNIT_ASSERT( restoredObject != NULL );
+      SerializationTestClass* restoredSharedObj = static_cast< SerializationTestClass* >( restoredObject->m_ptr );
+      CPPUNIT_ASSERT( restoredSharedObj != NULL );
+      CPPUNIT_ASSERT_EQUAL( 1, restoredSharedObj->m_val1 );
+
+      delete restoredObject;
+      delete restoredSharedObj;
+   }
+
+   // now notify about the change - the object will be serialized anew
+   sharedObj.notifyPropertyChange( "m_val1" );
+   {
+      Array< byte > memBuf;
+      InArrayStream inStream( memBuf );
+      OutArrayStream outStream( memBuf );
+      ReflectionSaver saver( outStream, &cache );
+      saver.save( &obj );
+      saver.flush();
+
+      ReflectionLoader loader;
+      loader.deserialize( inStream );
+      SerializationTestClassWithSharedPointers* restoredObject = loader.getNextObject< SerializationTestClassWithSharedPointers >();
+      CPPUNIT_ASSERT( restoredObject != NULL );
+      SerializationTestClass* restoredSharedObj = static_cast< SerializationTestClass* >( restoredObject->m_ptr );
+      CPPUNIT_ASSERT( restoredSharedObj != NULL );
+      CPPUNIT_ASSERT_EQUAL( 5, restoredSharedObj->m_val1 );
+
+      delete restoredObject;
+      delete restoredSharedObj;
+   }
+
+   // save an additional object first - the shared object will end up at a different position in the archive,
+   // so the data of the object that references it can't be reused, even though the object itself didn't change
+   SerializationTestClass otherObj( 3, 4, "otherObj" );
+   {
+      Array< byte > memBuf;
+      InArrayStream inStream( memBuf );
+      OutArrayStream outStream( memBuf );
+      ReflectionSaver saver( outStream, &cache );
+      saver.save( &otherObj );
+      saver.save( &obj );
+      saver.flush();
+
+      ReflectionLoader loader;
+      loader.deserialize( inStream );
+      SerializationTestClass* restoredOtherObj = loader.getNextObject< SerializationTestClass >();
+      SerializationTestClassWithSharedPointers* restoredObject = loader.getNextObject< SerializationTestClassWithSharedPointers >();
+      CPPUNIT_ASSERT( restoredOtherObj != NULL );
+      CPPUNIT_ASSERT( restoredObject != NULL );
+      CPPUNIT_ASSERT( restoredObject->m_ptr != restoredOtherObj );
+
+      SerializationTestClass* restoredSharedObj = static_cast< SerializationTestClass* >( restoredObject->m_ptr );
+      CPPUNIT_ASSERT( restoredSharedObj != NULL );
+      CPPUNIT_ASSERT_EQUAL( std::string( "sharedObj" ), restoredSharedObj->m_uniqueId );
+
+      delete restoredOtherObj;
+      delete restoredObject;
+      delete restoredSharedObj;
+   }
+   CPPUNIT_ASSERT_EQUAL( (uint)3, cache.size() );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST( Serialization, incrementalSavingOfResourceReferences )
+{
+   // setup reflection types
+   ReflectionTypesRegistry& typesRegistry = ReflectionTypesRegistry::getInstance();
+   typesRegistry.clear();
+   typesRegistry.addSerializableType< Resource >( "Resource", NULL );
+   typesRegistry.addSerializableType< SerializationTestClassWithSharedPointers >( "SerializationTestClassWithSharedPointers", new TSerializableTypeInstantiator< SerializationTestClassWithSharedPointers >() );
+
+   Resource referencedResource( FilePath( "referencedResource.res" ) );
+   SerializationTestClassWithSharedPointers obj( "obj", &referencedResource );
+
+   // the referenced resource should be stored as an external dependency regardless of whether
+   // we're using a cache or not, so all archives should be identical
+   Array< byte > archives[3];
+   {
+      OutArrayStream outStream( archives[0] );
+      ReflectionSaver saver( outStream );
+      saver.save( &obj );
+      saver.flush();
+   }
+
+   ReflectionSaveCache cache;
+   for ( uint i = 1; i < 3; ++i )
+   {
+      // the first save fills the cache, the second one reuses it
+      OutArrayStream outStream( archives[i] );
+      ReflectionSaver saver( outStream, &cache );
+      saver.save( &obj );
+      saver.flush();
+   }
+   CPPUNIT_ASSERT_EQUAL( (uint)1, cache.size() );
+
+   for ( uint i = 1; i < 3; ++i )
+   {
+      CPPUNIT_ASSERT_EQUAL( archives[0].size(), archives[i].size() );
+      CPPUNIT_ASSERT( memcmp( (byte*)archives[0], (byte*)archives[i], archives[0].size() ) == 0 );
+   }
+
+   // and the restored object should point to it
+   InArrayStream inStream( archives[2] );
+   std::vector< FilePath > dependenciesToLoad;
+   std::vector< FilePath > remappedDependencies;
+   ReflectionLoader loader;
+   loader.deserialize( inStream, &dependenciesToLoad, &remappedDependencies );
+   CPPUNIT_ASSERT_EQUAL( (uint)1, dependenciesToLoad.size() );
+   CPPUNIT_ASSERT( FilePath( "referencedResource.res" ) == dependenciesToLoad[0] );
+
+   SerializationTestClassWithSharedPointers* restoredObject = loader.getNextObject< SerializationTestClassWithSharedPointers >();
+   CPPUNIT_ASSERT( restoredObject != NULL );
+   delete restoredObject;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST( Serialization, compressedArchives )
+{
+   // setup reflection types
+   ReflectionTypesRegistry& typesRegistry = ReflectionTypesRegistry::getInstance();
+   typesRegistry.clear();
+   typesRegistry.addSerializableType< Resource >( "Resource", NULL );
+   typesRegistry.addSerializableType< SerializationTestClass >( "SerializationTestClass", new TSerializableTypeInstantiator< SerializationTestClass >() );
+
+   const uint objectsCount = 100;
+   std::vector< SerializationTestClass* > objects;
+   for ( uint i = 0; i < objectsCount; ++i )
+   {
+      objects.push_back( new SerializationTestClass( i, 10 ) );
+   }
+
+   // serialize the objects with and without compression
+   Array< byte > uncompressedBuf;
+   Array< byte > compressedBuf;
+   {
+      OutArrayStream outStream( uncompressedBuf );
+      ReflectionSaver saver( outStream );
+      for ( uint i = 0; i < objectsCount; ++i )
+      {
+         saver.save( objects[i] );
+      }
+      saver.flush();
+   }
+   {
+      OutArrayStream outStream( compressedBuf );
+      ReflectionSaver saver( outStream );
+      saver.setCompressed( true );
+
+      // save two separate archives to the same stream
+      for ( uint i = 0; i < objectsCount; ++i )
+      {
+         saver.save( objects[i] );
+      }
+      saver.flush();
+      saver.save( objects[0] );
+      saver.flush();
+   }
+   CPPUNIT_ASSERT( compressedBuf.size() < uncompressedBuf.size() / 2 );
+
+   // restore the objects
+   InArrayStream inStream( compressedBuf );
+   ReflectionLoader loader;
+   loader.deserialize( inStream );
+   CPPUNIT_ASSERT( loader.wasCompressed() );
+   for ( uint i = 0; i < objectsCount; ++i )
+   {
+      SerializationTestClass* restoredObject = loader.getNextObject< SerializationTestClass >();
+      CPPUNIT_ASSERT( restoredObject != NULL );
+      CPPUNIT_ASSERT_EQUAL( (int)i, restoredObject->m_val1 );
+      CPPUNIT_ASSERT_EQUAL( 10, restoredObject->m_val2 );
+      delete restoredObject;
+   }
+   CPPUNIT_ASSERT( loader.getNextObject< SerializationTestClass >() == NULL );
+
+   // the second archive should be readable as well
+   loader.deserialize( inStream );
+   SerializationTestClass* restoredObject = loader.getNextObject< SerializationTestClass >();
+   CPPUNIT_ASSERT( restoredObject != NULL );
+   CPPUNIT_ASSERT_EQUAL( 0, restoredObject->m_val1 );
+   delete restoredObject;
+
+   // cleanup
+   for ( uint i = 0; i < objectsCount; ++i )
+   {
+      delete objects[i];
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST( Serialization, stringTables )
+{
+   // strings written to a stream with a string table attached are stored in the table only once
+   ReflectionStringTable stringTable;
+   Array< byte > memBuf;
+   {
+      OutArrayStream outStream( memBuf );
+      outStream.setStringTable( &stringTable );
+      outStream << std::string( "ala" ) << std::string( "ma" ) << std::string( "ala" );
+      outStream << IDString( "kota" ) << IDString( "ala" );
+   }
+   CPPUNIT_ASSERT_EQUAL( (uint)3, stringTable.size() );
+   CPPUNIT_ASSERT_EQUAL( (uint)( 5 * sizeof( uint ) ), memBuf.size() );
+
+   // the table can be saved and loaded along with the data that refers to it
+   Array< byte > tableBuf;
+   {
+      OutArrayStream outStream( tableBuf );
+      stringTable.save( outStream );
+   }
+
+   ReflectionStringTable loadedStringTable;
+   {
+      InArrayStream inStream( tableBuf );
+      loadedStringTable.load( inStream );
+   }
+   CPPUNIT_ASSERT_EQUAL( (uint)3, loadedStringTable.size() );
+
+   InArrayStream inStream( memBuf );
+   inStream.setStringTable( &loadedStringTable );
+   std::string str1, str2, str3;
+   IDString id1( "" ), id2( "" );
+   inStream >> str1 >> str2 >> str3 >> id1 >> id2;
+   CPPUNIT_ASSERT_EQUAL( std::string( "ala" ), str1 );
+   CPPUNIT_ASSERT_EQUAL( std::string( "ma" ), str2 );
+   CPPUNIT_ASSERT_EQUAL( std::string( "ala" ), str3 );
+   CPPUNIT_ASSERT( IDString( "kota" ) == id1 );
+   CPPUNIT_ASSERT( IDString( "ala" ) == id2 );
+   CPPUNIT_ASSERT( !loadedStringTable.hasInvalidReferences() );
+
+   // indices from outside of the table ( a corrupted archive ) resolve to empty strings
+   Array< byte > corruptedBuf;
+   {
+      uint invalidIdx = 1000;
+      OutArrayStream outStream( corruptedBuf );
+      outStream << invalidIdx << invalidIdx;
+   }
+   InArrayStream corruptedStream( corruptedBuf );
+   corruptedStream.setStringTable( &loadedStringTable );
+   std::string invalidStr( "invalid" );
+   IDString invalidId( "invalid" );
+   corruptedStream >> invalidStr >> invalidId;
+   CPPUNIT_ASSERT_EQUAL( std::string( "" ), invalidStr );
+   CPPUNIT_ASSERT( IDString( "" ) == invalidId );
+   CPPUNIT_ASSERT( loadedStringTable.hasInvalidReferences() );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+TEST( Serialization, stringTablesInArchives )
+{
+   // setup reflection types
+   ReflectionTypesRegistry& typesRegistry = ReflectionTypesRegistry::getInstance();
+   typesRegistry.clear();
+   typesRegistry.addSerializableType< Resource >( "Resource", NULL );
+   typesRegistry.addSerializableType< SerializationTestClassWithSharedPointers >( "SerializationTestClassWithSharedPointers", new TSerializableTypeInstantiator< SerializationTestClassWithSharedPointers >() );
+
+   // the unique id of each object is stored twice in the archive - the string table should store it only once
+   SerializationTestClassWithSharedPointers obj( "someRatherLongObjectUniqueId" );
+   Array< byte > archiveBuf;
+   {
+      OutArrayStream outStream( archiveBuf );
+      ReflectionSaver saver( outStream );
+      saver.save( &obj );
+      saver.flush();
+   }
+
+   uint idLength = strlen( "someRatherLongObjectUniqueId" );
+   uint occurrencesCount = 0;
+   for ( uint i = 0; i + idLength <= archiveBuf.size(); ++i )
+   {
+      if ( memcmp( (byte*)archiveBuf + i, "someRatherLongObjectUniqueId", idLength ) == 0 )
+      {
+         ++occurrencesCount;
+      }
+   }
+   CPPUNIT_ASSERT_EQUAL( (uint)1, occurrencesCount );
+
+   // both the archive and its cooked version should be loadable
+   Array< byte > cookedArchiveBuf;
+   {
+      InArrayStream inStream( archiveBuf );
+      OutArrayStream outStream( cookedArchiveBuf );
+      CPPUNIT_ASSERT( ReflectionArchiveCooker::cook( inStream, outStream ) );
+   }
+
+   Array< byte >* buffers[] = { &archiveBuf, &cookedArchiveBuf };
+   for ( uint i = 0; i < 2; ++i )
+   {
+      InArrayStream inStream( *buffers[i] );
+      ReflectionLoader loader;
+      loader.deserialize( inStream );
+      SerializationTestClassWithSharedPointers* restoredObject = loader.getNextObject< SerializationTestClassWithSharedPointers >();
+      CPPUNIT_ASSERT( restoredObject != NULL );
+      CPPUNIT_ASSERT_EQUAL( std::string( "someRatherLongObjectUniqueId" ), restoredObject->m_uniqueId );
+      delete restoredObject;
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _TRACK_MEMORY_ALLOCATIONS
+
+TEST( Serialization, bufferedFileStreamsPerformance )
+{
+   // setup reflection types
+   ReflectionTypesRegistry& typesRegistry = ReflectionTypesRegistry::getInstance();
+   typesRegistry.clear();
+   typesRegistry.addSerializableType< SerializationTestClass >( "SerializationTestClass", new TSerializableTypeInstantiator< SerializationTestClass >() ); 
+
+   Filesystem filesystem( "../Data/" );
+   FilePath archivePath( "serializationBenchmark.tsc" );
+
+   // serialize a large number of objects
+   const uint OBJECTS_COUNT = 5000;
+   {
+      std::vector< SerializationTestClass* > objects;
+      for ( uint i = 0; i < OBJECTS_COUNT; ++i )
+      {
+         objects.push_back( new SerializationTestClass( i, OBJECTS_COUNT - i ) );
+      }
+
+      OutFileStream outStream( filesystem.open( archivePath, std::ios_base::out | std::ios_base::binary ) );
+      ReflectionSaver saver( outStream );
+      for ( uint i = 0; i < OBJECTS_COUNT; ++i )
+      {
+         saver.save( objects[i] );
+      }
+      saver.flush();
+
+      for ( uint i = 0; i < OBJECTS_COUNT; ++i )
+      {
+         delete objects[i];
+      }
+   }
+
+   // deserialize them using an unbuffered and a buffered stream, and compare how many times
+   // each of them had to reach for the file
+   uint fileReadsCount[2];
+   uint bufferSizes[2] = { 0, InFileStream::DEFAULT_BUFFER_SIZE };
+   for ( uint testIdx = 0; testIdx < 2; ++testIdx )
+   {
+      InFileStream inStream( filesystem.open( archivePath, std::ios_base::in | std::ios_base::binary ), bufferSizes[testIdx] );
+      ReflectionLoader loader;
+      loader.deserialize( inStream );
+      fileReadsCount[testIdx] = inStream.getFileReadsCount();
+
+      CPPUNIT_ASSERT_EQUAL( (unsigned int)OBJECTS_COUNT, loader.m_loadedObjects.size() );
+      for ( uint i = 0; i < OBJECTS_COUNT; ++i )
+      {
+         SerializationTestClass* restoredObject = loader.getNextObject< SerializationTestClass >();
+         CPPUNIT_ASSERT_EQUAL( (int)i, restoredObject->m_val1 );
+         CPPUNIT_ASSERT_EQUAL( (int)( OBJECTS_COUNT - i ), restoredObject->m_val2 );
+         delete restoredObject;
+      }
+   }
+
+   // an unbuffered stream reads every field straight from the file, while the buffered one
+   // only reaches for the file when its buffer runs dry
+   uint archiveSize = 0;
+   {
+      File* archive = filesystem.open( archivePath, std::ios_base::in | std::ios_base::binary );
+      archiveSize = archive->size();
+      delete archive;
+   }
+   CPPUNIT_ASSERT( fileReadsCount[0] > OBJECTS_COUNT );
+   CPPUNIT_ASSERT( fileReadsCount[1] <= archiveSize / InFileStream::DEFAULT_BUFFER_SIZE + 2 );
+
+   // cleanup
+   filesystem.remove( archivePath );
+}
+
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
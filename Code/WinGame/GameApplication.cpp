@@ -53,6 +53,9 @@ void GameApplication::initialize()
    ResourcesManager& resMgr = ResourcesManager::getInstance();
    resMgr.getFilesystem().changeRootDir( "./Data/" );
 
+   // if the resources were packed into an archive, read them from it
+   resMgr.getFilesystem().mount( FilePath( GAME_RESOURCES_ARCHIVE ) );
+
    // load the config resource
    GameConfig* gameConfig = resMgr.create< GameConfig >( FilePath( "game.gcf" ), true );
    if ( !gameConfig )